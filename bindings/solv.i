@@ -1947,6 +1947,19 @@ returnself(matchsolvable)
   static const int POOL_FLAG_ADDFILEPROVIDESFILTERED = POOL_FLAG_ADDFILEPROVIDESFILTERED;
   static const int POOL_FLAG_NOWHATPROVIDESAUX = POOL_FLAG_NOWHATPROVIDESAUX;
   static const int POOL_FLAG_WHATPROVIDESWITHDISABLED = POOL_FLAG_WHATPROVIDESWITHDISABLED;
+  static const int POOL_FLAG_INCREMENTALWHATPROVIDES = POOL_FLAG_INCREMENTALWHATPROVIDES;
+  static const int POOL_STAT_WHATPROVIDES_TIME = POOL_STAT_WHATPROVIDES_TIME;
+  static const int POOL_STAT_ADDFILEPROVIDES_TIME = POOL_STAT_ADDFILEPROVIDES_TIME;
+  static const int POOL_STAT_ADD_SOLV_TIME = POOL_STAT_ADD_SOLV_TIME;
+  static const int POOL_STAT_SOLVABLES = POOL_STAT_SOLVABLES;
+  static const int POOL_STAT_STRINGS = POOL_STAT_STRINGS;
+  static const int POOL_STAT_RELS = POOL_STAT_RELS;
+  static const int POOL_STAT_WHATPROVIDES_MEMORY = POOL_STAT_WHATPROVIDES_MEMORY;
+  static const int POOL_STAT_MAXRSS = POOL_STAT_MAXRSS;
+  static const int POOL_STAT_PAGECACHE_HITS = POOL_STAT_PAGECACHE_HITS;
+  static const int POOL_STAT_PAGECACHE_MISSES = POOL_STAT_PAGECACHE_MISSES;
+  static const int POOL_STAT_PAGECACHE_EVICTIONS = POOL_STAT_PAGECACHE_EVICTIONS;
+  static const int POOL_STAT_PAGECACHE_MEMORY = POOL_STAT_PAGECACHE_MEMORY;
   static const int DISTTYPE_RPM = DISTTYPE_RPM;
   static const int DISTTYPE_DEB = DISTTYPE_DEB;
   static const int DISTTYPE_ARCH = DISTTYPE_ARCH;
@@ -1970,12 +1983,18 @@ returnself(matchsolvable)
   int get_flag(int flag) {
     return pool_get_flag($self, flag);
   }
+  int get_stat(int stat) {
+    return pool_get_stat($self, stat);
+  }
   void set_rootdir(const char *rootdir) {
     pool_set_rootdir($self, rootdir);
   }
   const char *get_rootdir(int flag) {
     return pool_get_rootdir($self);
   }
+  void set_pagecache_size(unsigned int size) {
+    pool_set_pagecache_size($self, size);
+  }
 #if defined(SWIGPYTHON)
   %{
   SWIGINTERN int loadcallback(Pool *pool, Repodata *data, void *d) {
@@ -2269,6 +2288,21 @@ returnself(matchsolvable)
   void createwhatprovides() {
     pool_createwhatprovides($self);
   }
+  bool write_whatprovides(FILE *fp) {
+    return pool_write_whatprovides($self, fp) == 0;
+  }
+  bool read_whatprovides(FILE *fp) {
+    return pool_read_whatprovides($self, fp) == 0;
+  }
+  void addallproviders() {
+    pool_addallproviders($self);
+  }
+  void freeze() {
+    pool_freeze($self);
+  }
+  void unfreeze() {
+    pool_unfreeze($self);
+  }
 
   %newobject id2solvable;
   XSolvable *id2solvable(Id id) {
@@ -2544,6 +2578,8 @@ returnself(matchsolvable)
   static const int REPO_USE_ROOTDIR = REPO_USE_ROOTDIR;
   static const int REPO_NO_LOCATION = REPO_NO_LOCATION;
   static const int SOLV_ADD_NO_STUBS = SOLV_ADD_NO_STUBS;       /* repo_solv */
+  static const int SOLV_ADD_MMAP = SOLV_ADD_MMAP;               /* repo_solv */
+  static const int REPOWRITER_ZSTD_PAGES = REPOWRITER_ZSTD_PAGES;       /* repo_write */
 #ifdef ENABLE_SUSEREPO
   static const int SUSETAGS_RECORD_SHARES = SUSETAGS_RECORD_SHARES;     /* repo_susetags */
 #endif
@@ -2687,8 +2723,13 @@ returnself(matchsolvable)
   void internalize() {
     repo_internalize($self);
   }
-  bool write(FILE *fp) {
-    return repo_write($self, fp) == 0;
+  bool write(FILE *fp, int flags = 0) {
+    Repowriter *writer = repowriter_create($self);
+    int res;
+    repowriter_set_flags(writer, flags);
+    res = repowriter_write(writer, fp);
+    repowriter_free(writer);
+    return res == 0;
   }
   /* HACK, remove if no longer needed! */
   bool write_first_repodata(FILE *fp) {
@@ -2929,91 +2970,100 @@ returnself(matchsolvable)
 %extend Datapos {
   Id lookup_id(Id keyname) {
     Pool *pool = $self->repo->pool;
-    Datapos oldpos = pool->pos;
+    Datapos *pos = pool_get_pos(pool);
+    Datapos oldpos = *pos;
     Id r;
-    pool->pos = *$self;
+    *pos = *$self;
     r = pool_lookup_id(pool, SOLVID_POS, keyname);
-    pool->pos = oldpos;
+    *pos = oldpos;
     return r;
   }
   const char *lookup_str(Id keyname) {
     Pool *pool = $self->repo->pool;
-    Datapos oldpos = pool->pos;
+    Datapos *pos = pool_get_pos(pool);
+    Datapos oldpos = *pos;
     const char *r;
-    pool->pos = *$self;
+    *pos = *$self;
     r = pool_lookup_str(pool, SOLVID_POS, keyname);
-    pool->pos = oldpos;
+    *pos = oldpos;
     return r;
   }
   unsigned long long lookup_num(Id keyname, unsigned long long notfound = 0) {
     Pool *pool = $self->repo->pool;
-    Datapos oldpos = pool->pos;
+    Datapos *pos = pool_get_pos(pool);
+    Datapos oldpos = *pos;
     unsigned long long r;
-    pool->pos = *$self;
+    *pos = *$self;
     r = pool_lookup_num(pool, SOLVID_POS, keyname, notfound);
-    pool->pos = oldpos;
+    *pos = oldpos;
     return r;
   }
   bool lookup_void(Id keyname) {
     Pool *pool = $self->repo->pool;
-    Datapos oldpos = pool->pos;
+    Datapos *pos = pool_get_pos(pool);
+    Datapos oldpos = *pos;
     int r;
-    pool->pos = *$self;
+    *pos = *$self;
     r = pool_lookup_void(pool, SOLVID_POS, keyname);
-    pool->pos = oldpos;
+    *pos = oldpos;
     return r;
   }
   %newobject lookup_checksum;
   Chksum *lookup_checksum(Id keyname) {
     Pool *pool = $self->repo->pool;
-    Datapos oldpos = pool->pos;
+    Datapos *pos = pool_get_pos(pool);
+    Datapos oldpos = *pos;
     Id type = 0;
     const unsigned char *b;
-    pool->pos = *$self;
+    *pos = *$self;
     b = pool_lookup_bin_checksum(pool, SOLVID_POS, keyname, &type);
-    pool->pos = oldpos;
+    *pos = oldpos;
     return solv_chksum_create_from_bin(type, b);
   }
   const char *lookup_deltaseq() {
     Pool *pool = $self->repo->pool;
-    Datapos oldpos = pool->pos;
+    Datapos *pos = pool_get_pos(pool);
+    Datapos oldpos = *pos;
     const char *seq;
-    pool->pos = *$self;
+    *pos = *$self;
     seq = pool_lookup_str(pool, SOLVID_POS, DELTA_SEQ_NAME);
     if (seq) {
       seq = pool_tmpjoin(pool, seq, "-", pool_lookup_str(pool, SOLVID_POS, DELTA_SEQ_EVR));
       seq = pool_tmpappend(pool, seq, "-", pool_lookup_str(pool, SOLVID_POS, DELTA_SEQ_NUM));
     }
-    pool->pos = oldpos;
+    *pos = oldpos;
     return seq;
   }
   const char *lookup_deltalocation(unsigned int *OUTPUT) {
     Pool *pool = $self->repo->pool;
-    Datapos oldpos = pool->pos;
+    Datapos *pos = pool_get_pos(pool);
+    Datapos oldpos = *pos;
     const char *loc;
-    pool->pos = *$self;
+    *pos = *$self;
     loc = pool_lookup_deltalocation(pool, SOLVID_POS, OUTPUT);
-    pool->pos = oldpos;
+    *pos = oldpos;
     return loc;
   }
   Queue lookup_idarray(Id keyname) {
     Pool *pool = $self->repo->pool;
-    Datapos oldpos = pool->pos;
+    Datapos *pos = pool_get_pos(pool);
+    Datapos oldpos = *pos;
     Queue r;
     queue_init(&r);
-    pool->pos = *$self;
+    *pos = *$self;
     pool_lookup_idarray(pool, SOLVID_POS, keyname, &r);
-    pool->pos = oldpos;
+    *pos = oldpos;
     return r;
   }
   %newobject Dataiterator;
   Dataiterator *Dataiterator(Id key, const char *match = 0, int flags = 0) {
     Pool *pool = $self->repo->pool;
-    Datapos oldpos = pool->pos;
+    Datapos *pos = pool_get_pos(pool);
+    Datapos oldpos = *pos;
     Dataiterator *di;
-    pool->pos = *$self;
+    *pos = *$self;
     di = new_Dataiterator(pool, 0, SOLVID_POS, key, match, flags);
-    pool->pos = oldpos;
+    *pos = oldpos;
     return di;
   }
 }
@@ -3098,21 +3148,21 @@ returnself(matchsolvable)
   %newobject pos;
   Datapos *pos() {
     Pool *pool = $self->pool;
-    Datapos *pos, oldpos = pool->pos;
+    Datapos *pos, *ppos = pool_get_pos(pool), oldpos = *ppos;
     dataiterator_setpos($self);
     pos = solv_calloc(1, sizeof(*pos));
-    *pos = pool->pos;
-    pool->pos = oldpos;
+    *pos = *ppos;
+    *ppos = oldpos;
     return pos;
   }
   %newobject parentpos;
   Datapos *parentpos() {
     Pool *pool = $self->pool;
-    Datapos *pos, oldpos = pool->pos;
+    Datapos *pos, *ppos = pool_get_pos(pool), oldpos = *ppos;
     dataiterator_setpos_parent($self);
     pos = solv_calloc(1, sizeof(*pos));
-    *pos = pool->pos;
-    pool->pos = oldpos;
+    *pos = *ppos;
+    *ppos = oldpos;
     return pos;
   }
 #if defined(SWIGPERL)
@@ -3891,6 +3941,47 @@ returnself(matchsolvable)
   static const int SOLVER_FLAG_ONLY_NAMESPACE_RECOMMENDED = SOLVER_FLAG_ONLY_NAMESPACE_RECOMMENDED;
   static const int SOLVER_FLAG_STRICT_REPO_PRIORITY = SOLVER_FLAG_STRICT_REPO_PRIORITY;
   static const int SOLVER_FLAG_FOCUS_NEW = SOLVER_FLAG_FOCUS_NEW;
+  static const int SOLVER_FLAG_RESTART_POLICY = SOLVER_FLAG_RESTART_POLICY;
+  static const int SOLVER_FLAG_RESTART_INTERVAL = SOLVER_FLAG_RESTART_INTERVAL;
+  static const int SOLVER_FLAG_LEARNTRULE_LIMIT = SOLVER_FLAG_LEARNTRULE_LIMIT;
+  static const int SOLVER_FLAG_TIMEOUT = SOLVER_FLAG_TIMEOUT;
+  static const int SOLVER_FLAG_KEEP_LEARNT_RULES = SOLVER_FLAG_KEEP_LEARNT_RULES;
+  static const int SOLVER_FLAG_LAZY_PKGRULES = SOLVER_FLAG_LAZY_PKGRULES;
+
+  static const int SOLVER_RESTART_NONE = SOLVER_RESTART_NONE;
+  static const int SOLVER_RESTART_LUBY = SOLVER_RESTART_LUBY;
+  static const int SOLVER_RESTART_GLUCOSE = SOLVER_RESTART_GLUCOSE;
+
+  static const int SOLVER_STAT_SOLVE_TIME = SOLVER_STAT_SOLVE_TIME;
+  static const int SOLVER_STAT_PKGRULES_TIME = SOLVER_STAT_PKGRULES_TIME;
+  static const int SOLVER_STAT_CHOICERULES_TIME = SOLVER_STAT_CHOICERULES_TIME;
+  static const int SOLVER_STAT_SAT_TIME = SOLVER_STAT_SAT_TIME;
+  static const int SOLVER_STAT_SOLUTIONS_TIME = SOLVER_STAT_SOLUTIONS_TIME;
+  static const int SOLVER_STAT_RULES = SOLVER_STAT_RULES;
+  static const int SOLVER_STAT_PKG_RULES = SOLVER_STAT_PKG_RULES;
+  static const int SOLVER_STAT_FEATURE_RULES = SOLVER_STAT_FEATURE_RULES;
+  static const int SOLVER_STAT_UPDATE_RULES = SOLVER_STAT_UPDATE_RULES;
+  static const int SOLVER_STAT_JOB_RULES = SOLVER_STAT_JOB_RULES;
+  static const int SOLVER_STAT_INFARCH_RULES = SOLVER_STAT_INFARCH_RULES;
+  static const int SOLVER_STAT_DUP_RULES = SOLVER_STAT_DUP_RULES;
+  static const int SOLVER_STAT_BEST_RULES = SOLVER_STAT_BEST_RULES;
+  static const int SOLVER_STAT_YUMOBS_RULES = SOLVER_STAT_YUMOBS_RULES;
+  static const int SOLVER_STAT_BLACK_RULES = SOLVER_STAT_BLACK_RULES;
+  static const int SOLVER_STAT_STRICT_REPO_PRIORITY_RULES = SOLVER_STAT_STRICT_REPO_PRIORITY_RULES;
+  static const int SOLVER_STAT_CHOICE_RULES = SOLVER_STAT_CHOICE_RULES;
+  static const int SOLVER_STAT_RECOMMENDS_RULES = SOLVER_STAT_RECOMMENDS_RULES;
+  static const int SOLVER_STAT_LEARNT_RULES = SOLVER_STAT_LEARNT_RULES;
+  static const int SOLVER_STAT_DECISIONS = SOLVER_STAT_DECISIONS;
+  static const int SOLVER_STAT_PROPAGATIONS = SOLVER_STAT_PROPAGATIONS;
+  static const int SOLVER_STAT_CONFLICTS = SOLVER_STAT_CONFLICTS;
+  static const int SOLVER_STAT_UNSOLVABLE = SOLVER_STAT_UNSOLVABLE;
+  static const int SOLVER_STAT_RESTARTS = SOLVER_STAT_RESTARTS;
+  static const int SOLVER_STAT_RETIRED_RULES = SOLVER_STAT_RETIRED_RULES;
+  static const int SOLVER_STAT_PROBLEMS = SOLVER_STAT_PROBLEMS;
+  static const int SOLVER_STAT_MAXRSS = SOLVER_STAT_MAXRSS;
+  static const int SOLVER_STAT_KEPT_LEARNT_RULES = SOLVER_STAT_KEPT_LEARNT_RULES;
+  static const int SOLVER_STAT_LAZY_ROUNDS = SOLVER_STAT_LAZY_ROUNDS;
+  static const int SOLVER_STAT_REUSED_PKG_RULES = SOLVER_STAT_REUSED_PKG_RULES;
 
   static const int SOLVER_REASON_UNRELATED = SOLVER_REASON_UNRELATED;
   static const int SOLVER_REASON_UNIT_RULE = SOLVER_REASON_UNIT_RULE;
@@ -3919,6 +4010,15 @@ returnself(matchsolvable)
   int get_flag(int flag) {
     return solver_get_flag($self, flag);
   }
+  int get_stat(int stat) {
+    return solver_get_stat($self, stat);
+  }
+#ifdef SWIGRUBY
+  %rename("aborted?") aborted;
+#endif
+  bool aborted() {
+    return solver_aborted($self);
+  }
 
   %typemap(out) Queue solve Queue2Array(Problem *, 1, new_Problem(arg1, id));
   %newobject solve;
@@ -3938,6 +4038,13 @@ returnself(matchsolvable)
     return solver_create_transaction($self);
   }
 
+  bool write_pkgrules(FILE *fp) {
+    return solver_write_pkgrules($self, fp) == 0;
+  }
+  bool read_pkgrules(FILE *fp) {
+    return solver_read_pkgrules($self, fp) == 0;
+  }
+
   /* legacy, use get_decision */
   int describe_decision(XSolvable *s, XRule **OUTPUT) {
     Id ruleid;
@@ -4138,6 +4245,13 @@ rb_eval_string(
   static const int SOLVER_TRANSACTION_ARCHCHANGE = SOLVER_TRANSACTION_ARCHCHANGE;
   static const int SOLVER_TRANSACTION_VENDORCHANGE = SOLVER_TRANSACTION_VENDORCHANGE;
   static const int SOLVER_TRANSACTION_KEEP_ORDERDATA = SOLVER_TRANSACTION_KEEP_ORDERDATA;
+  static const int SOLVER_TRANSACTION_ORDER_SCC = SOLVER_TRANSACTION_ORDER_SCC;
+  static const int TRANSACTION_STAT_ORDER_TIME = TRANSACTION_STAT_ORDER_TIME;
+  static const int TRANSACTION_STAT_EDGE_TIME = TRANSACTION_STAT_EDGE_TIME;
+  static const int TRANSACTION_STAT_CYCLE_TIME = TRANSACTION_STAT_CYCLE_TIME;
+  static const int TRANSACTION_STAT_ELEMENTS = TRANSACTION_STAT_ELEMENTS;
+  static const int TRANSACTION_STAT_EDGES = TRANSACTION_STAT_EDGES;
+  static const int TRANSACTION_STAT_CYCLES = TRANSACTION_STAT_CYCLES;
   ~Transaction() {
     transaction_free($self);
   }
@@ -4237,6 +4351,9 @@ rb_eval_string(
   void order(int flags=0) {
     transaction_order($self, flags);
   }
+  int get_stat(int stat) {
+    return transaction_get_stat($self, stat);
+  }
 }
 
 %extend TransactionClass {
@@ -3,6 +3,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
+#ifdef ENABLE_PARALLEL_FILECONFLICTS
+#include <pthread.h>
+#endif
 
 #include "pool.h"
 #include "repo.h"
@@ -16,8 +19,35 @@ struct fcstate {
   Queue *checkq;
   int newpkgscnt;
   void *rpmstate;
+#ifdef ENABLE_PARALLEL_FILECONFLICTS
+  /* the callback is called from multiple threads, each thread
+   * needs its own rpm state */
+  pthread_mutex_t lock;
+  pthread_key_t key;
+  void **rpmstates;
+  int nrpmstates;
+#endif
 };
 
+static void *
+fileconflict_rpmstate(Pool *pool, struct fcstate *fcstate)
+{
+#ifdef ENABLE_PARALLEL_FILECONFLICTS
+  void *rpmstate = pthread_getspecific(fcstate->key);
+  if (rpmstate)
+    return rpmstate;
+  pthread_mutex_lock(&fcstate->lock);
+  rpmstate = rpm_state_create(pool, pool_get_rootdir(pool));
+  fcstate->rpmstates = solv_extend(fcstate->rpmstates, fcstate->nrpmstates, 1, sizeof(void *), 15);
+  fcstate->rpmstates[fcstate->nrpmstates++] = rpmstate;
+  pthread_mutex_unlock(&fcstate->lock);
+  pthread_setspecific(fcstate->key, rpmstate);
+  return rpmstate;
+#else
+  return fcstate->rpmstate;
+#endif
+}
+
 static void *
 fileconflict_cb(Pool *pool, Id p, void *cbdata)
 {
@@ -35,7 +65,7 @@ fileconflict_cb(Pool *pool, Id p, void *cbdata)
       rpmdbid = s->repo->rpmdbid[p - s->repo->start];
       if (!rpmdbid)
         return 0;
-      return rpm_byrpmdbid(fcstate->rpmstate, rpmdbid);
+      return rpm_byrpmdbid(fileconflict_rpmstate(pool, fcstate), rpmdbid);
     }    
   for (i = 0; i < fcstate->newpkgscnt; i++) 
     if (fcstate->checkq->elements[i] == p)
@@ -46,23 +76,42 @@ fileconflict_cb(Pool *pool, Id p, void *cbdata)
   if (!fp)
     return 0;
   rewind(fp);
-  return rpm_byfp(fcstate->rpmstate, fp, pool_solvable2str(pool, s)); 
+  /* do not use pool_solvable2str here, the tmpspace is not thread safe */
+  return rpm_byfp(fileconflict_rpmstate(pool, fcstate), fp, pool_id2str(pool, s->name));
 }
 
 int
 checkfileconflicts(Pool *pool, Queue *checkq, int newpkgs, FILE **newpkgsfps, Queue *conflicts)
 {
   struct fcstate fcstate;
-  int i;
+  int i, flags;
 
   printf("Searching for file conflicts\n");
   queue_init(conflicts);
-  fcstate.rpmstate = rpm_state_create(pool, pool_get_rootdir(pool));
   fcstate.newpkgscnt = newpkgs;
   fcstate.checkq = checkq;
   fcstate.newpkgsfps = newpkgsfps;
-  pool_findfileconflicts(pool, checkq, newpkgs, conflicts, FINDFILECONFLICTS_USE_SOLVABLEFILELIST | FINDFILECONFLICTS_CHECK_DIRALIASING | FINDFILECONFLICTS_USE_ROOTDIR, &fileconflict_cb, &fcstate);
+  flags = FINDFILECONFLICTS_USE_SOLVABLEFILELIST | FINDFILECONFLICTS_USE_FILECONFLICTINFO | FINDFILECONFLICTS_CHECK_DIRALIASING | FINDFILECONFLICTS_USE_ROOTDIR;
+#ifdef ENABLE_PARALLEL_FILECONFLICTS
+  fcstate.rpmstate = 0;
+  fcstate.rpmstates = 0;
+  fcstate.nrpmstates = 0;
+  pthread_mutex_init(&fcstate.lock, 0);
+  pthread_key_create(&fcstate.key, 0);
+  flags |= FINDFILECONFLICTS_THREADED;
+#else
+  fcstate.rpmstate = rpm_state_create(pool, pool_get_rootdir(pool));
+#endif
+  pool_findfileconflicts(pool, checkq, newpkgs, conflicts, flags, &fileconflict_cb, &fcstate);
+#ifdef ENABLE_PARALLEL_FILECONFLICTS
+  for (i = 0; i < fcstate.nrpmstates; i++)
+    rpm_state_free(fcstate.rpmstates[i]);
+  solv_free(fcstate.rpmstates);
+  pthread_key_delete(fcstate.key);
+  pthread_mutex_destroy(&fcstate.lock);
+#else
   fcstate.rpmstate = rpm_state_free(fcstate.rpmstate);
+#endif
   if (conflicts->count)
     {
       printf("\n");
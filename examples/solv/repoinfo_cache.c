@@ -17,6 +17,8 @@
 
 #define SOLVCACHE_PATH "/var/cache/solv"
 
+#define WHATPROVIDESCACHE_NAME "@whatprovides.cache"
+
 static char *userhome;
 
 void
@@ -288,3 +290,66 @@ writecachedrepo(struct repoinfo *cinfo, const char *repoext, Repodata *repodata)
   free(tmpl);
 }
 
+static char *
+calc_whatprovidescachepath(Pool *pool)
+{
+  if (userhome && getuid())
+    return pool_tmpjoin(pool, userhome, "/.solvcache/", WHATPROVIDESCACHE_NAME);
+  return pool_tmpjoin(pool, SOLVCACHE_PATH, "/", WHATPROVIDESCACHE_NAME);
+}
+
+int
+usecachedwhatprovides(Pool *pool)
+{
+  FILE *fp;
+  int r;
+
+  if (!(fp = fopen(calc_whatprovidescachepath(pool), "r")))
+    return 0;
+  r = pool_read_whatprovides(pool, fp) == 0;
+  fclose(fp);
+  return r;
+}
+
+void
+writecachedwhatprovides(Pool *pool)
+{
+  FILE *fp;
+  int fd;
+  char *tmpl, *cachedir;
+
+  cachedir = userhome && getuid() ? pool_tmpjoin(pool, userhome, "/.solvcache", 0) : SOLVCACHE_PATH;
+  if (access(cachedir, W_OK | X_OK) != 0 && mkdir(cachedir, 0755) == 0)
+    printf("[created %s]\n", cachedir);
+  tmpl = solv_dupjoin(cachedir, "/", ".newwhatprovides-XXXXXX");
+  fd = mkstemp(tmpl);
+  if (fd < 0)
+    {
+      free(tmpl);
+      return;
+    }
+  fchmod(fd, 0444);
+  if (!(fp = fdopen(fd, "w")))
+    {
+      close(fd);
+      unlink(tmpl);
+      free(tmpl);
+      return;
+    }
+  if (pool_write_whatprovides(pool, fp))
+    {
+      fclose(fp);
+      unlink(tmpl);
+      free(tmpl);
+      return;
+    }
+  if (fclose(fp))
+    {
+      unlink(tmpl);
+      free(tmpl);
+      return;
+    }
+  if (rename(tmpl, calc_whatprovidescachepath(pool)))
+    unlink(tmpl);
+  free(tmpl);
+}
@@ -10,3 +10,5 @@ extern void calc_cookie_stat(struct stat *stb, Id chktype, unsigned char *cookie
 extern int usecachedrepo(struct repoinfo *cinfo, const char *repoext, int mark);
 extern void  writecachedrepo(struct repoinfo *cinfo, const char *repoext, Repodata *repodata);
 
+extern int usecachedwhatprovides(Pool *pool);
+extern void writecachedwhatprovides(Pool *pool);
@@ -113,7 +113,7 @@ read_installed_rpm(struct repoinfo *cinfo)
     }
 #endif
   ofp = fopen(calc_cachepath(repo, 0, 0), "r");
-  if (repo_add_rpmdb_reffp(repo, ofp, REPO_REUSE_REPODATA | REPO_NO_INTERNALIZE | REPO_USE_ROOTDIR))
+  if (repo_add_rpmdb_reffp(repo, ofp, REPO_REUSE_REPODATA | REPO_NO_INTERNALIZE | REPO_USE_ROOTDIR | RPM_ADD_WITH_FILECONFLICTINFO))
     {
       fprintf(stderr, "installed db: %s\n", pool_errstr(pool));
       return 0;
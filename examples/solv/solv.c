@@ -580,11 +580,17 @@ main(int argc, char **argv)
 	}
     }
 
+  /* the command line packages change the pool, do not use the cache */
+  if (commandlinerepo || !usecachedwhatprovides(pool))
+    {
 #if defined(ENABLE_RPMDB)
-  if (pool->disttype == DISTTYPE_RPM)
-    addfileprovides(pool);
+      if (pool->disttype == DISTTYPE_RPM)
+	addfileprovides(pool);
 #endif
-  pool_createwhatprovides(pool);
+      pool_createwhatprovides(pool);
+      if (!commandlinerepo)
+	writecachedwhatprovides(pool);
+    }
 
   if (keyname)
     keyname = solv_dupjoin("solvable:", keyname, 0);
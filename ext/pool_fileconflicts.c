@@ -67,6 +67,11 @@ struct cbdata {
   Map fetchdirmap;
   int fetchdirmapn;
   Queue newlookat;
+
+  /* parallel mode */
+  Queue *recs;			/* record buckets of the current package chunk */
+  struct cbdata *shards;	/* hash map shards */
+  int nshards;
 };
 
 #define FILESSPACE_BLOCK 255
@@ -103,21 +108,30 @@ growhash(Hashtable map, Hashval *mapnp)
   return m;
 }
 
+/* the shard responsible for a hash value, uses the top bits */
+static inline int
+shardof(Id hx, int nshards)
+{
+  return (int)(((unsigned long long)(Hashval)hx * nshards) >> 32);
+}
+
+/* parallel mode: put a (hx, idx) record into the bucket of its shard */
+static inline void
+pushrec(struct cbdata *cbdata, Id hx, int isdir)
+{
+  queue_push2(cbdata->recs + shardof(hx, cbdata->nshards), hx, isdir ? ~cbdata->idx : cbdata->idx);
+}
+
 /* first pass for non-alias mode:
  * create hash (dhx, idx) of directories that may have conflicts.
  * also create map "ixdmap" of packages involved
  */
 static void
-finddirs_cb(void *cbdatav, const char *fn, struct filelistinfo *info)
+finddirs_add(struct cbdata *cbdata, Id dhx, Id idx, int isdir)
 {
-  struct cbdata *cbdata = cbdatav;
   Hashval h, hh;
-  Id dhx, qx;
-  Id oidx, idx = cbdata->idx;
+  Id qx, oidx;
 
-  dhx = strhash(fn);
-  if (!dhx)
-    dhx = strlen(fn) + 1;	/* make sure dhx is not zero */
   h = dhx & cbdata->dirmapn;
   hh = HASHCHAIN_START;
   for (;;)
@@ -154,6 +168,21 @@ finddirs_cb(void *cbdatav, const char *fn, struct filelistinfo *info)
   MAPSET(&cbdata->idxmap, idx);
 }
 
+static void
+finddirs_cb(void *cbdatav, const char *fn, struct filelistinfo *info)
+{
+  struct cbdata *cbdata = cbdatav;
+  Id dhx;
+
+  dhx = strhash(fn);
+  if (!dhx)
+    dhx = strlen(fn) + 1;	/* make sure dhx is not zero */
+  if (cbdata->recs)
+    pushrec(cbdata, dhx, 0);
+  else
+    finddirs_add(cbdata, dhx, cbdata->idx, 0);
+}
+
 /* check if a dhx value is marked as "multiple" in the dirmap created by finddirs_cb */
 static inline int
 isindirmap(struct cbdata *cbdata, Id dhx)
@@ -179,35 +208,10 @@ isindirmap(struct cbdata *cbdata, Id dhx)
  * this value before. If yes, we have a file conflict candidate. */
 /* we also do extra work to ignore all-directory conflicts */
 static void
-findfileconflicts_cb(void *cbdatav, const char *fn, struct filelistinfo *info)
+findfileconflicts_add(struct cbdata *cbdata, Id hx, Id idx, int isdir)
 {
-  struct cbdata *cbdata = cbdatav;
-  int isdir = S_ISDIR(info->mode);
-  const char *dp;
-  Id idx, oidx;
-  Id hx, qx;
-  Hashval h, hh, dhx;
-
-  idx = cbdata->idx;
-
-  if (!info->dirlen)
-    return;
-  dp = fn + info->dirlen;
-  if (info->diridx != cbdata->lastdiridx)
-    {
-      cbdata->lastdiridx = info->diridx;
-      cbdata->lastdirhash = strnhash(fn, dp - fn);
-    }
-  dhx = cbdata->lastdirhash;
-
-  /* check if the directory is marked as "multiple" in the dirmap */
-  /* this mirrors the "if (!dhx) dhx = strlen(fn) + 1" used in  finddirs_cb */
-  if (!isindirmap(cbdata, dhx ? dhx : dp - fn + 1))
-    return;
-
-  hx = strhash_cont(dp, dhx);	/* extend hash to complete file name */
-  if (!hx)
-    hx = strlen(fn) + 1;	/* make sure hx is not zero */
+  Id oidx, qx;
+  Hashval h, hh;
 
   h = hx & cbdata->cflmapn;
   hh = HASHCHAIN_START;
@@ -261,6 +265,39 @@ findfileconflicts_cb(void *cbdatav, const char *fn, struct filelistinfo *info)
   queue_push2(&cbdata->lookat, 0, 0);
 }
 
+static void
+findfileconflicts_cb(void *cbdatav, const char *fn, struct filelistinfo *info)
+{
+  struct cbdata *cbdata = cbdatav;
+  int isdir = S_ISDIR(info->mode);
+  const char *dp;
+  Id hx;
+  Hashval dhx;
+
+  if (!info->dirlen)
+    return;
+  dp = fn + info->dirlen;
+  if (info->diridx != cbdata->lastdiridx)
+    {
+      cbdata->lastdiridx = info->diridx;
+      cbdata->lastdirhash = strnhash(fn, dp - fn);
+    }
+  dhx = cbdata->lastdirhash;
+
+  /* check if the directory is marked as "multiple" in the dirmap */
+  /* this mirrors the "if (!dhx) dhx = strlen(fn) + 1" used in  finddirs_cb */
+  if (!isindirmap(cbdata, dhx ? dhx : dp - fn + 1))
+    return;
+
+  hx = strhash_cont(dp, dhx);	/* extend hash to complete file name */
+  if (!hx)
+    hx = strlen(fn) + 1;	/* make sure hx is not zero */
+  if (cbdata->recs)
+    pushrec(cbdata, hx, isdir);
+  else
+    findfileconflicts_add(cbdata, hx, cbdata->idx, isdir);
+}
+
 /* same as findfileconflicts_cb, but
  * - hashes with just the basename
  * - sets idx in a map instead of pushing to lookat
@@ -270,24 +307,11 @@ findfileconflicts_cb(void *cbdatav, const char *fn, struct filelistinfo *info)
  * only want to do it for entries marked as "multiple"
  */
 static void
-findfileconflicts_basename_cb(void *cbdatav, const char *fn, struct filelistinfo *info)
+findfileconflicts_basename_add(struct cbdata *cbdata, Id hx, Id idx, int isdir)
 {
-  struct cbdata *cbdata = cbdatav;
-  int isdir = S_ISDIR(info->mode);
-  const char *dp;
-  Id idx, oidx;
-  Id hx, qx;
+  Id oidx, qx;
   Hashval h, hh;
 
-  idx = cbdata->idx;
-
-  if (!info->dirlen)
-    return;
-  dp = fn + info->dirlen;
-  hx = strhash(dp);
-  if (!hx)
-    hx = strlen(fn) + 1;
-
   h = hx & cbdata->cflmapn;
   hh = HASHCHAIN_START;
   for (;;)
@@ -337,6 +361,26 @@ findfileconflicts_basename_cb(void *cbdatav, const char *fn, struct filelistinfo
     cbdata->cflmap[2 * (size_t)h + 1] = -1;
 }
 
+static void
+findfileconflicts_basename_cb(void *cbdatav, const char *fn, struct filelistinfo *info)
+{
+  struct cbdata *cbdata = cbdatav;
+  int isdir = S_ISDIR(info->mode);
+  const char *dp;
+  Id hx;
+
+  if (!info->dirlen)
+    return;
+  dp = fn + info->dirlen;
+  hx = strhash(dp);
+  if (!hx)
+    hx = strlen(fn) + 1;
+  if (cbdata->recs)
+    pushrec(cbdata, hx, isdir);
+  else
+    findfileconflicts_basename_add(cbdata, hx, cbdata->idx, isdir);
+}
+
 static inline Id
 addfilesspace(struct cbdata *cbdata, int len)
 {
@@ -766,6 +810,28 @@ iterate_solvable_dirs(Pool *pool, Id p, void (*cb)(void *, const char *, struct
   dataiterator_free(&di);
 }
 
+/* check if a hx value is in the cflmap */
+static inline int
+isincflmap(struct cbdata *cbdata, Id hx)
+{
+  Hashval h, hh;
+  Id qx;
+
+  if (cbdata->shards)
+    cbdata = cbdata->shards + shardof(hx, cbdata->nshards);
+  h = hx & cbdata->cflmapn;
+  hh = HASHCHAIN_START;
+  for (;;)
+    {
+      qx = cbdata->cflmap[2 * (size_t)h];
+      if (!qx)
+	return 0;
+      if (qx == hx)
+	return 1;
+      h = HASHCHAIN_NEXT(h, hh, cbdata->cflmapn);
+    }
+}
+
 /* before calling the expensive findfileconflicts_cb we check if any of
  * the files match. This only makes sense when cbdata->create is off.
  */
@@ -773,8 +839,7 @@ static int
 precheck_solvable_files(struct cbdata *cbdata, Pool *pool, Id p)
 {
   Dataiterator di;
-  Id hx, qx;
-  Hashval h, hh;
+  Id hx;
   int found = 0;
   int aliases = cbdata->aliases;
   unsigned int lastdirid = -1;
@@ -812,27 +877,456 @@ precheck_solvable_files(struct cbdata *cbdata, Pool *pool, Id p)
 	  if (!hx)
 	    hx = lastdirlen + strlen(di.kv.str) + 1;
 	}
-      h = hx & cbdata->cflmapn;
-      hh = HASHCHAIN_START;
-      for (;;)
+      if (isincflmap(cbdata, hx))
 	{
-	  qx = cbdata->cflmap[2 * (size_t)h];
-	  if (!qx)
-	    break;
-	  if (qx == hx)
-	    {
-	      found = 1;
-	      break;
-	    }
-	  h = HASHCHAIN_NEXT(h, hh, cbdata->cflmapn);
+	  found = 1;
+	  break;
 	}
-      if (found)
-	break;
     }
   dataiterator_free(&di);
   return found;
 }
 
+/* iterate over the file list stored with RPM_ADD_WITH_FILECONFLICTINFO.
+ * returns 0 if the package has no such info, the header needs to be
+ * fetched in that case */
+static int
+iterate_fileconflictinfo(Pool *pool, Id p, int iterflags, void (*cb)(void *, const char *, struct filelistinfo *), void *cbdata)
+{
+  Solvable *s = pool->solvables + p;
+  const void *info;
+  int infol;
+
+  if (!s->repo)
+    return 0;
+  info = repo_lookup_binary(s->repo, p, SOLVABLE_FILECONFLICTINFO, &infol);
+  if (!info)
+    return 0;
+  return rpm_iterate_fileconflictinfo(info, infol, iterflags, cb, cbdata);
+}
+
+
+#ifdef ENABLE_PARALLEL_FILECONFLICTS
+
+/* parallel mode:
+ * the header fetching and hashing of the first two passes is done by
+ * multiple threads, each working on a chunk of packages. The hashes are
+ * put into buckets by their top bits, so that every shard of the hash maps
+ * can then be filled by a thread of its own. As the buckets are processed
+ * in package order, the result is the same as in the serial code.
+ */
+
+#include <pthread.h>
+
+#define PARALLEL_MAXTHREADS	16
+#define PARALLEL_CHUNK		16	/* packages per work unit */
+
+struct parallel {
+  Pool *pool;
+  Queue *pkgs;
+  int cutoff;
+  void *(*handle_cb)(Pool *, Id, void *);
+  void *handle_cbdata;
+  struct cbdata *cbdata;
+
+  int nthreads;		/* also the number of shards */
+  int usefileinfo;
+  int start, end;	/* package range of the current round */
+  Map fetch;		/* packages that need a header fetch */
+  int iterflags;
+  void (*cb)(void *, const char *, struct filelistinfo *);
+  void (*add)(struct cbdata *, Id, Id, int);
+  int nchunks;
+  Queue *recs;		/* nchunks * nthreads record buckets */
+  Queue *prerecs;	/* buckets filled by the main thread */
+
+  pthread_mutex_t lock;
+  int next;		/* next chunk/shard to work on */
+  int hdrfetches;
+};
+
+static int
+parallel_nthreads(void)
+{
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  if (n < 2)
+    return 0;
+  return n > PARALLEL_MAXTHREADS ? PARALLEL_MAXTHREADS : (int)n;
+}
+
+static inline int
+parallel_getwork(struct parallel *par)
+{
+  int n;
+  pthread_mutex_lock(&par->lock);
+  n = par->next++;
+  pthread_mutex_unlock(&par->lock);
+  return n;
+}
+
+/* fetch the headers of a chunk and put the hashes into the buckets */
+static void *
+parallel_fetch_thread(void *arg)
+{
+  struct parallel *par = arg;
+  struct cbdata cbdata = *par->cbdata;	/* private hashing state */
+  int c, i, iend, hdrfetches = 0;
+  void *handle;
+
+  while ((c = parallel_getwork(par)) < par->nchunks)
+    {
+      cbdata.recs = par->recs + (size_t)c * par->nthreads;
+      i = par->start + c * PARALLEL_CHUNK;
+      iend = i + PARALLEL_CHUNK < par->end ? i + PARALLEL_CHUNK : par->end;
+      for (; i < iend; i++)
+	{
+	  if (!MAPTST(&par->fetch, i))
+	    continue;
+	  handle = (*par->handle_cb)(par->pool, par->pkgs->elements[i], par->handle_cbdata);
+	  if (!handle)
+	    continue;
+	  hdrfetches++;
+	  cbdata.idx = i;
+	  cbdata.lastdiridx = -1;
+	  rpm_iterate_filelist(handle, par->iterflags, par->cb, &cbdata);
+	}
+    }
+  pthread_mutex_lock(&par->lock);
+  par->hdrfetches += hdrfetches;
+  pthread_mutex_unlock(&par->lock);
+  return 0;
+}
+
+/* the package index of a record, directories are stored as ~idx */
+static inline Id
+recidx(Id *rec)
+{
+  return rec[1] < 0 ? ~rec[1] : rec[1];
+}
+
+/* feed the records of two buckets into a shard, in package order */
+static void
+parallel_addrecs(struct parallel *par, struct cbdata *shard, Queue *q1, Queue *q2)
+{
+  int i1 = 0, i2 = 0;
+  Id *rec, idx;
+
+  for (;;)
+    {
+      if (i1 < q1->count && (i2 >= q2->count || recidx(q1->elements + i1) < recidx(q2->elements + i2)))
+	{
+	  rec = q1->elements + i1;
+	  i1 += 2;
+	}
+      else if (i2 < q2->count)
+	{
+	  rec = q2->elements + i2;
+	  i2 += 2;
+	}
+      else
+	break;
+      idx = recidx(rec);
+      shard->create = idx < par->cutoff;
+      (*par->add)(shard, rec[0], idx, rec[1] < 0);
+    }
+}
+
+/* fill the hash map shards from the buckets */
+static void *
+parallel_add_thread(void *arg)
+{
+  struct parallel *par = arg;
+  Queue empty, *q, *preq;
+  size_t off;
+  int c, s;
+
+  queue_init(&empty);
+  while ((s = parallel_getwork(par)) < par->nthreads)
+    {
+      for (c = 0; c < par->nchunks; c++)
+	{
+	  off = (size_t)c * par->nthreads + s;
+	  q = par->recs + off;
+	  preq = par->prerecs ? par->prerecs + off : &empty;
+	  parallel_addrecs(par, par->cbdata->shards + s, preq, q);
+	  queue_free(q);
+	  queue_free(preq);
+	}
+    }
+  return 0;
+}
+
+static void
+parallel_run(struct parallel *par, void *(*thread)(void *))
+{
+  pthread_t threads[PARALLEL_MAXTHREADS];
+  int i, n;
+
+  par->next = 0;
+  for (n = 0; n < par->nthreads - 1; n++)
+    if (pthread_create(threads + n, 0, thread, par) != 0)
+      break;
+  (*thread)(par);	/* the main thread also works */
+  for (i = 0; i < n; i++)
+    pthread_join(threads[i], 0);
+}
+
+/* set up the buckets for the packages start..end */
+static void
+parallel_setup(struct parallel *par, int start, int end)
+{
+  par->start = start;
+  par->end = end;
+  par->nchunks = (end - start + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK;
+  par->recs = solv_calloc((size_t)par->nchunks * par->nthreads, sizeof(Queue));
+  par->prerecs = solv_calloc((size_t)par->nchunks * par->nthreads, sizeof(Queue));
+  MAPZERO(&par->fetch);
+}
+
+/* the main thread puts the hashes of package i into the prerecs buckets */
+static inline void
+parallel_prepare(struct parallel *par, struct cbdata *cbdata2, int i)
+{
+  cbdata2->recs = par->prerecs + (size_t)((i - par->start) / PARALLEL_CHUNK) * par->nthreads;
+  cbdata2->idx = i;
+  cbdata2->lastdiridx = -1;
+}
+
+/* stored file conflict infos are also read by the main thread, as
+ * pool lookups are not thread safe */
+static int
+parallel_fileconflictinfo(struct parallel *par, struct cbdata *cbdata2, int i)
+{
+  if (!par->usefileinfo)
+    return 0;
+  parallel_prepare(par, cbdata2, i);
+  return iterate_fileconflictinfo(par->pool, par->pkgs->elements[i], par->iterflags, par->cb, cbdata2);
+}
+
+/* do the header fetching and hashing of the packages in the fetch map */
+static void
+parallel_round(struct parallel *par)
+{
+  parallel_run(par, parallel_fetch_thread);
+  parallel_run(par, parallel_add_thread);
+  par->recs = solv_free(par->recs);
+  par->prerecs = solv_free(par->prerecs);
+}
+
+static void
+parallel_init(struct parallel *par, struct cbdata *cbdata, Queue *pkgs, int cutoff, int flags, void *(*handle_cb)(Pool *, Id, void *), void *handle_cbdata)
+{
+  memset(par, 0, sizeof(*par));
+  par->nthreads = parallel_nthreads();
+  if (!par->nthreads)
+    return;
+  par->usefileinfo = flags & FINDFILECONFLICTS_USE_FILECONFLICTINFO;
+  par->pool = cbdata->pool;
+  par->pkgs = pkgs;
+  par->cutoff = cutoff;
+  par->handle_cb = handle_cb;
+  par->handle_cbdata = handle_cbdata;
+  par->cbdata = cbdata;
+  pthread_mutex_init(&par->lock, 0);
+  map_init(&par->fetch, pkgs->count);
+}
+
+static void
+parallel_free(struct parallel *par)
+{
+  if (!par->nthreads)
+    return;
+  map_free(&par->fetch);
+  pthread_mutex_destroy(&par->lock);
+}
+
+static void
+parallel_createshards(struct parallel *par, int dirs, Hashval mapn)
+{
+  struct cbdata *cbdata = par->cbdata;
+  int s;
+
+  cbdata->nshards = par->nthreads;
+  cbdata->shards = solv_calloc(cbdata->nshards, sizeof(struct cbdata));
+  for (s = 0; s < cbdata->nshards; s++)
+    {
+      struct cbdata *shard = cbdata->shards + s;
+      shard->pool = cbdata->pool;
+      shard->aliases = cbdata->aliases;
+      map_init(&shard->idxmap, par->pkgs->count);
+      queue_init(&shard->lookat);
+      queue_init(&shard->lookat_dir);
+      if (dirs)
+	{
+	  shard->dirmapn = mapn;
+	  shard->dirmap = allochashtable(shard->dirmapn, 2);
+	}
+      else
+	{
+	  shard->cflmapn = mapn;
+	  shard->cflmap = allochashtable(shard->cflmapn, 2);
+	}
+    }
+}
+
+/* merge the shards back, only the "multiple" (-1) entries are kept
+ * in the hash map as they are the only ones that get looked at later */
+static void
+parallel_mergeshards(struct parallel *par, int dirs)
+{
+  struct cbdata *cbdata = par->cbdata;
+  Hashtable m, map;
+  Hashval i, h, hh, mapn, newn;
+  unsigned int cnt = 0;
+  int s;
+
+  for (s = 0; s < cbdata->nshards; s++)
+    {
+      struct cbdata *shard = cbdata->shards + s;
+      m = dirs ? shard->dirmap : shard->cflmap;
+      mapn = dirs ? shard->dirmapn : shard->cflmapn;
+      for (i = 0; i <= mapn; i++)
+	if (m[2 * (size_t)i] && m[2 * (size_t)i + 1] == -1)
+	  cnt++;
+    }
+  newn = mkmask(cnt + 1);
+  map = allochashtable(newn, 2);
+  for (s = 0; s < cbdata->nshards; s++)
+    {
+      struct cbdata *shard = cbdata->shards + s;
+      m = dirs ? shard->dirmap : shard->cflmap;
+      mapn = dirs ? shard->dirmapn : shard->cflmapn;
+      for (i = 0; i <= mapn; i++)
+	{
+	  if (!m[2 * (size_t)i] || m[2 * (size_t)i + 1] != -1)
+	    continue;
+	  h = m[2 * (size_t)i] & newn;
+	  hh = HASHCHAIN_START;
+	  while (map[2 * (size_t)h])
+	    h = HASHCHAIN_NEXT(h, hh, newn);
+	  map[2 * (size_t)h] = m[2 * (size_t)i];
+	  map[2 * (size_t)h + 1] = -1;
+	}
+      solv_free(m);
+      map_or(&cbdata->idxmap, &shard->idxmap);
+      map_free(&shard->idxmap);
+      cbdata->dirconflicts += shard->dirconflicts;
+      queue_insertn(&cbdata->lookat, cbdata->lookat.count, shard->lookat.count, shard->lookat.elements);
+      queue_free(&shard->lookat);
+      queue_insertn(&cbdata->lookat_dir, cbdata->lookat_dir.count, shard->lookat_dir.count, shard->lookat_dir.elements);
+      queue_free(&shard->lookat_dir);
+    }
+  cbdata->shards = solv_free(cbdata->shards);
+  cbdata->nshards = 0;
+  if (dirs)
+    {
+      solv_free(cbdata->dirmap);
+      cbdata->dirmap = map;
+      cbdata->dirmapn = newn;
+      cbdata->dirmapused = cnt;
+    }
+  else
+    {
+      solv_free(cbdata->cflmap);
+      cbdata->cflmap = map;
+      cbdata->cflmapn = newn;
+      cbdata->cflmapused = cnt;
+    }
+}
+
+/* parallel version of the first pass */
+static int
+parallel_finddirs(struct parallel *par, int flags, int *idxmapsetp)
+{
+  struct cbdata *cbdata = par->cbdata;
+  Pool *pool = par->pool;
+  Repo *installed = pool->installed;
+  struct cbdata cbdata2;
+  int i;
+  Id p;
+
+  parallel_createshards(par, 1, mkmask((par->cutoff + 3) * 16 / par->nthreads));
+  parallel_setup(par, 0, par->pkgs->count);
+  par->iterflags = RPM_ITERATE_FILELIST_ONLYDIRS;
+  par->cb = finddirs_cb;
+  par->add = finddirs_add;
+  par->hdrfetches = 0;
+  /* the solvable file lists must be read by the main thread */
+  cbdata2 = *cbdata;
+  for (i = 0; i < par->pkgs->count; i++)
+    {
+      p = par->pkgs->elements[i];
+      if (parallel_fileconflictinfo(par, &cbdata2, i))
+	continue;
+      if ((flags & FINDFILECONFLICTS_USE_SOLVABLEFILELIST) != 0 && installed)
+	{
+	  if (p >= installed->start && p < installed->end && pool->solvables[p].repo == installed)
+	    {
+	      parallel_prepare(par, &cbdata2, i);
+	      iterate_solvable_dirs(pool, p, finddirs_cb, &cbdata2);
+	      continue;
+	    }
+	}
+      MAPSET(&par->fetch, i);
+    }
+  parallel_round(par);
+  parallel_mergeshards(par, 1);
+  for (i = 0; i < par->pkgs->count; i++)
+    if (MAPTST(&cbdata->idxmap, i))
+      (*idxmapsetp)++;
+  return par->hdrfetches;
+}
+
+/* parallel version of the second pass */
+static int
+parallel_findfiles(struct parallel *par, int flags)
+{
+  struct cbdata *cbdata = par->cbdata;
+  Pool *pool = par->pool;
+  Repo *installed = pool->installed;
+  struct cbdata cbdata2;
+  int i, cutoff = par->cutoff;
+  Id p;
+
+  parallel_createshards(par, 0, mkmask((cutoff + 3) * 32 / par->nthreads));
+  par->iterflags = RPM_ITERATE_FILELIST_NOGHOSTS;
+  par->cb = cbdata->aliases ? findfileconflicts_basename_cb : findfileconflicts_cb;
+  par->add = cbdata->aliases ? findfileconflicts_basename_add : findfileconflicts_add;
+  par->hdrfetches = 0;
+  cbdata2 = *cbdata;
+  /* first the packages that create hash entries */
+  parallel_setup(par, 0, cutoff);
+  for (i = 0; i < cutoff; i++)
+    if (cbdata->aliases || MAPTST(&cbdata->idxmap, i))
+      if (!parallel_fileconflictinfo(par, &cbdata2, i))
+	MAPSET(&par->fetch, i);
+  parallel_round(par);
+  /* then the rest, the precheck needs the complete hash maps */
+  if (cutoff < par->pkgs->count)
+    {
+      parallel_setup(par, cutoff, par->pkgs->count);
+      for (i = cutoff; i < par->pkgs->count; i++)
+	{
+	  if (!cbdata->aliases && !MAPTST(&cbdata->idxmap, i))
+	    continue;
+	  if (parallel_fileconflictinfo(par, &cbdata2, i))
+	    continue;
+	  p = par->pkgs->elements[i];
+	  if ((flags & FINDFILECONFLICTS_USE_SOLVABLEFILELIST) != 0 && installed)
+	    {
+	      if (p >= installed->start && p < installed->end && pool->solvables[p].repo == installed)
+		if (!precheck_solvable_files(cbdata, pool, p))
+		  continue;
+	    }
+	  MAPSET(&par->fetch, i);
+	}
+      parallel_round(par);
+    }
+  parallel_mergeshards(par, 0);
+  return par->hdrfetches;
+}
+
+#endif
 
 /* pool_findfileconflicts: find file conflicts in a set of packages
  * input:
@@ -840,7 +1334,9 @@ precheck_solvable_files(struct cbdata *cbdata, Pool *pool, Id p)
  *   - cutoff: packages after this are not checked against each other
  *             this is useful to ignore file conflicts in already installed packages
  *   - flags: see pool_fileconflicts.h
- *   - handle_cb, handle_cbdata: callback for rpm header fetches
+ *   - handle_cb, handle_cbdata: callback for rpm header fetches. With
+ *     FINDFILECONFLICTS_THREADED it is called from multiple threads, see
+ *     pool_fileconflicts.h for what the callback must guarantee
  * output:
  *   - conflicts: list of conflicts
  *
@@ -860,8 +1356,12 @@ pool_findfileconflicts(Pool *pool, Queue *pkgs, int cutoff, Queue *conflicts, in
   Repo *installed = pool->installed;
   Id p;
   int usefilecolors;
+  int usefileinfo;
   int hdrfetches;
   int lookat_cnt;
+#ifdef ENABLE_PARALLEL_FILECONFLICTS
+  struct parallel par;
+#endif
 
   queue_empty(conflicts);
   if (!pkgs->count)
@@ -870,6 +1370,7 @@ pool_findfileconflicts(Pool *pool, Queue *pkgs, int cutoff, Queue *conflicts, in
   now = start = solv_timems(0);
   /* Hmm, should we have a different flag for this? */
   usefilecolors = pool_get_flag(pool, POOL_FLAG_IMPLICITOBSOLETEUSESCOLORS);
+  usefileinfo = flags & FINDFILECONFLICTS_USE_FILECONFLICTINFO;
   POOL_DEBUG(SOLV_DEBUG_STATS, "searching for file conflicts\n");
   POOL_DEBUG(SOLV_DEBUG_STATS, "packages: %d, cutoff %d, usefilecolors %d\n", pkgs->count, cutoff, usefilecolors);
 
@@ -894,6 +1395,14 @@ pool_findfileconflicts(Pool *pool, Queue *pkgs, int cutoff, Queue *conflicts, in
     cutoff = pkgs->count;
   if (cutoff >= 0x4000000)
     abort();	/* sorry, this overflows our hashes */
+#ifdef ENABLE_PARALLEL_FILECONFLICTS
+  if ((flags & FINDFILECONFLICTS_THREADED) != 0)
+    parallel_init(&par, &cbdata, pkgs, cutoff, flags, handle_cb, handle_cbdata);
+  else
+    par.nthreads = 0;
+  if (par.nthreads)
+    POOL_DEBUG(SOLV_DEBUG_STATS, "using %d threads\n", par.nthreads);
+#endif
 
   /* avarage file list size: 200 files per package */
   /* avarage dir count: 20 dirs per package */
@@ -906,12 +1415,23 @@ pool_findfileconflicts(Pool *pool, Queue *pkgs, int cutoff, Queue *conflicts, in
       cbdata.dirmap = allochashtable(cbdata.dirmapn, 2);
       cbdata.create = 1;
       idxmapset = 0;
+#ifdef ENABLE_PARALLEL_FILECONFLICTS
+      if (par.nthreads)
+	hdrfetches = parallel_finddirs(&par, flags, &idxmapset);
+      else
+#endif
       for (i = 0; i < pkgs->count; i++)
 	{
 	  if (i == cutoff)
 	    cbdata.create = 0;
 	  cbdata.idx = i;
 	  p = pkgs->elements[i];
+	  if (usefileinfo && iterate_fileconflictinfo(pool, p, RPM_ITERATE_FILELIST_ONLYDIRS, finddirs_cb, &cbdata))
+	    {
+	      if (MAPTST(&cbdata.idxmap, i))
+		idxmapset++;
+	      continue;
+	    }
 	  if ((flags & FINDFILECONFLICTS_USE_SOLVABLEFILELIST) != 0 && installed)
 	    {
 	      if (p >= installed->start && p < installed->end && pool->solvables[p].repo == installed)
@@ -943,6 +1463,11 @@ pool_findfileconflicts(Pool *pool, Queue *pkgs, int cutoff, Queue *conflicts, in
   cbdata.cflmap = allochashtable(cbdata.cflmapn, 2);
   cbdata.create = 1;
   hdrfetches = 0;
+#ifdef ENABLE_PARALLEL_FILECONFLICTS
+  if (par.nthreads)
+    hdrfetches = parallel_findfiles(&par, flags);
+  else
+#endif
   for (i = 0; i < pkgs->count; i++)
     {
       if (i == cutoff)
@@ -950,7 +1475,10 @@ pool_findfileconflicts(Pool *pool, Queue *pkgs, int cutoff, Queue *conflicts, in
       if (!cbdata.aliases && !MAPTST(&cbdata.idxmap, i))
 	continue;
       cbdata.idx = i;
+      cbdata.lastdiridx = -1;
       p = pkgs->elements[i];
+      if (usefileinfo && iterate_fileconflictinfo(pool, p, RPM_ITERATE_FILELIST_NOGHOSTS, cbdata.aliases ? findfileconflicts_basename_cb : findfileconflicts_cb, &cbdata))
+	continue;
       if (!cbdata.create && (flags & FINDFILECONFLICTS_USE_SOLVABLEFILELIST) != 0 && installed)
 	{
 	  if (p >= installed->start && p < installed->end && pool->solvables[p].repo == installed)
@@ -963,7 +1491,6 @@ pool_findfileconflicts(Pool *pool, Queue *pkgs, int cutoff, Queue *conflicts, in
       if (!handle)
 	continue;
       hdrfetches++;
-      cbdata.lastdiridx = -1;
       rpm_iterate_filelist(handle, RPM_ITERATE_FILELIST_NOGHOSTS, cbdata.aliases ? findfileconflicts_basename_cb : findfileconflicts_cb, &cbdata);
     }
 
@@ -973,6 +1500,9 @@ pool_findfileconflicts(Pool *pool, Queue *pkgs, int cutoff, Queue *conflicts, in
   POOL_DEBUG(SOLV_DEBUG_STATS, "filemap creation took %d ms\n", solv_timems(now));
   POOL_DEBUG(SOLV_DEBUG_STATS, "lookat_dir size: %d\n", cbdata.lookat_dir.count);
   queue_free(&cbdata.lookat_dir);
+#ifdef ENABLE_PARALLEL_FILECONFLICTS
+  parallel_free(&par);
+#endif
 
   /* we need another pass for aliases to generate the normalized directory ids */
   queue_init(&cbdata.norq);
@@ -995,13 +1525,15 @@ pool_findfileconflicts(Pool *pool, Queue *pkgs, int cutoff, Queue *conflicts, in
 	    continue;
 	  p = pkgs->elements[i];
 	  cbdata.idx = i;
+	  cbdata.lastdiridx = -1;
+	  if (usefileinfo && iterate_fileconflictinfo(pool, p, RPM_ITERATE_FILELIST_NOGHOSTS, findfileconflicts_alias_cb, &cbdata))
+	    continue;
 	  /* can't use FINDFILECONFLICTS_USE_SOLVABLEFILELIST because we have to know if
 	   * the file is a directory or not */
 	  handle = (*handle_cb)(pool, p, handle_cbdata);
 	  if (!handle)
 	    continue;
 	  hdrfetches++;
-	  cbdata.lastdiridx = -1;
 	  rpm_iterate_filelist(handle, RPM_ITERATE_FILELIST_NOGHOSTS, findfileconflicts_alias_cb, &cbdata);
 	}
       POOL_DEBUG(SOLV_DEBUG_STATS, "normap size: %d, used %d\n", cbdata.normapn + 1, cbdata.normapused);
@@ -1110,14 +1642,6 @@ pool_findfileconflicts(Pool *pool, Queue *pkgs, int cutoff, Queue *conflicts, in
 	if (cbdata.lookat.elements[j + 1] != idx)
 	  break;
       p = pkgs->elements[idx];
-      handle = (*handle_cb)(pool, p, handle_cbdata);
-      if (!handle)
-	{
-	  queue_deleten(&cbdata.lookat, 0, j);
-	  lookat_cnt -= j;
-	  continue;
-	}
-      hdrfetches++;
       /* create hash which maps (hx, dirid) to lookat elements */
       /* also create map from dhx values for fast reject */
       for (i = 0; i < j; i += 4)
@@ -1136,7 +1660,16 @@ pool_findfileconflicts(Pool *pool, Queue *pkgs, int cutoff, Queue *conflicts, in
       cbdata.lastdiridx = -1;
       cbdata.lastdiridxbad = 0;
       queue_prealloc(&cbdata.newlookat, j + 256);
-      rpm_iterate_filelist(handle, iterflags, findfileconflicts_expand_cb, &cbdata);
+      if (!usefileinfo || !iterate_fileconflictinfo(pool, p, iterflags, findfileconflicts_expand_cb, &cbdata))
+	{
+	  /* if we cannot get the header the block is just dropped */
+	  handle = (*handle_cb)(pool, p, handle_cbdata);
+	  if (handle)
+	    {
+	      hdrfetches++;
+	      rpm_iterate_filelist(handle, iterflags, findfileconflicts_expand_cb, &cbdata);
+	    }
+	}
       /* clear hash and map again */
       for (i = 0; i < j; i += 4)
 	{
@@ -15,5 +15,12 @@ extern int pool_findfileconflicts(Pool *pool, Queue *pkgs, int cutoff, Queue *co
 #define FINDFILECONFLICTS_USE_SOLVABLEFILELIST	(1 << 0)
 #define FINDFILECONFLICTS_CHECK_DIRALIASING	(1 << 1)
 #define FINDFILECONFLICTS_USE_ROOTDIR		(1 << 2)
+/* With FINDFILECONFLICTS_THREADED the handle_cb callback is called
+ * concurrently from multiple threads, so it must be thread safe. The
+ * handle it returns must stay valid until the next handle_cb call made
+ * by the same thread. A callback that returns the header of one shared
+ * rpm state does not fulfil this, it needs one rpm state per thread. */
+#define FINDFILECONFLICTS_THREADED		(1 << 3)
+#define FINDFILECONFLICTS_USE_FILECONFLICTINFO	(1 << 4)	/* use the info stored with RPM_ADD_WITH_FILECONFLICTINFO */
 
 #endif
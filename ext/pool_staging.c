@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026, SUSE LLC
+ *
+ * This program is licensed under the BSD license, read LICENSE.BSD
+ * for further information
+ */
+
+/*
+ * pool_staging.c
+ *
+ * Parse repositories into private staging pools and merge them
+ * into the real pool afterwards.
+ *
+ * A pool does not share any data with other pools, so the staging
+ * pools can be filled by different threads, e.g. one thread per
+ * repository. Merging is done by serializing the staged repository
+ * and adding it with repo_add_solv(), which integrates the strings
+ * and relations in one pass and remaps all Ids. The merge must be
+ * done with no other thread using the real pool.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "repo_solv.h"
+#include "repo_write.h"
+#include "util.h"
+#include "solv_xfopen.h"
+#include "pool_staging.h"
+
+/* all pool flags, new flags must be added here */
+static int staging_flags[] = {
+  POOL_FLAG_PROMOTEEPOCH,
+  POOL_FLAG_FORBIDSELFCONFLICTS,
+  POOL_FLAG_OBSOLETEUSESPROVIDES,
+  POOL_FLAG_IMPLICITOBSOLETEUSESPROVIDES,
+  POOL_FLAG_OBSOLETEUSESCOLORS,
+  POOL_FLAG_NOINSTALLEDOBSOLETES,
+  POOL_FLAG_HAVEDISTEPOCH,
+  POOL_FLAG_NOOBSOLETESMULTIVERSION,
+  POOL_FLAG_ADDFILEPROVIDESFILTERED,
+  POOL_FLAG_IMPLICITOBSOLETEUSESCOLORS,
+  POOL_FLAG_NOWHATPROVIDESAUX,
+  POOL_FLAG_WHATPROVIDESWITHDISABLED,
+  POOL_FLAG_INCREMENTALWHATPROVIDES,
+  0
+};
+
+/* create an empty pool that parses data like the specified one */
+Pool *
+pool_create_staging(Pool *pool)
+{
+  Pool *spool = pool_create();
+  int i;
+
+  pool_setdisttype(spool, pool->disttype);
+  for (i = 0; staging_flags[i]; i++)
+    pool_set_flag(spool, staging_flags[i], pool_get_flag(pool, staging_flags[i]));
+  if (pool_get_rootdir(pool))
+    pool_set_rootdir(spool, pool_get_rootdir(pool));
+  /* the debug callback is not copied, it may not be safe to call it
+   * from another thread */
+  spool->debugmask = pool->debugmask;
+  return spool;
+}
+
+/* add the solvables and the data of a staged repository to repo.
+ * the staged repository is not modified, free its pool once
+ * it is no longer needed */
+int
+repo_add_staged(Repo *repo, Repo *staged, int flags)
+{
+  Pool *pool = repo->pool;
+  FILE *fp;
+  int ret;
+#ifndef WITHOUT_COOKIEOPEN
+  char *buf = 0;
+  size_t bufl = 0;
+#endif
+
+  if (staged->pool == pool)
+    return pool_error(pool, -1, "repo_add_staged: repository is not staged");
+#ifndef WITHOUT_COOKIEOPEN
+  fp = solv_xfopen_buf(0, &buf, &bufl, "w");
+#else
+  fp = tmpfile();
+#endif
+  if (!fp)
+    return pool_error(pool, -1, "repo_add_staged: could not create buffer");
+  if (repo_write(staged, fp) != 0)
+    {
+      fclose(fp);
+#ifndef WITHOUT_COOKIEOPEN
+      solv_free(buf);
+#endif
+      return pool_error(pool, -1, "repo_add_staged: %s", pool_errstr(staged->pool));
+    }
+#ifndef WITHOUT_COOKIEOPEN
+  if (fclose(fp))
+    {
+      solv_free(buf);
+      return pool_error(pool, -1, "repo_add_staged: write error");
+    }
+  fp = solv_fmemopen(buf, bufl, "rf");
+  if (!fp)
+    {
+      solv_free(buf);
+      return pool_error(pool, -1, "repo_add_staged: could not open buffer");
+    }
+#else
+  if (fflush(fp) || fseek(fp, 0, SEEK_SET))
+    {
+      fclose(fp);
+      return pool_error(pool, -1, "repo_add_staged: write error");
+    }
+#endif
+  ret = repo_add_solv(repo, fp, flags);
+  fclose(fp);
+  return ret;
+}
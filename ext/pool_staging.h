@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2026, SUSE LLC
+ *
+ * This program is licensed under the BSD license, read LICENSE.BSD
+ * for further information
+ */
+
+#ifndef POOL_STAGING_H
+#define POOL_STAGING_H
+
+#include "pool.h"
+#include "repo.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern Pool *pool_create_staging(Pool *pool);
+extern int repo_add_staged(Repo *repo, Repo *staged, int flags);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1089,6 +1089,108 @@ addchangelog(Repodata *data, Id handle, RpmHead *rpmhead)
   solv_free(cn);
 }
 
+/* file conflict info: the part of the file list pool_findfileconflicts
+ * needs, so that it does not have to fetch the header of an installed
+ * package again. Layout, numbers are stored like ids in the solv format:
+ *   version, dircount, dircount * dirname,
+ *   then for every non-ghost file: diridx, basename, mode, color, digest
+ * strings are zero terminated. Hex digests are stored as 2 * len plus
+ * the binary data, other digests as 2 * len + 1 plus the string.
+ */
+
+#define FILECONFLICTINFO_VERSION	1
+#define FILECONFLICTINFO_DIGESTSIZE	(2 * 128 + 1)	/* hex digest plus terminator */
+
+struct fileconflictinfo {
+  unsigned char *buf;
+  int len;
+  int bad;
+};
+
+static void
+fileconflictinfo_addnum(struct fileconflictinfo *fci, unsigned int x)
+{
+  unsigned char *dp;
+
+  fci->buf = solv_extend(fci->buf, fci->len, 5, 1, 4095);
+  dp = fci->buf + fci->len;
+  if (x >= (1 << 14))
+    {
+      if (x >= (1 << 28))
+	*dp++ = (x >> 28) | 128;
+      if (x >= (1 << 21))
+	*dp++ = (x >> 21) | 128;
+      *dp++ = (x >> 14) | 128;
+    }
+  if (x >= (1 << 7))
+    *dp++ = (x >> 7) | 128;
+  *dp++ = x & 127;
+  fci->len = dp - fci->buf;
+}
+
+static void
+fileconflictinfo_addblob(struct fileconflictinfo *fci, const void *blob, int len)
+{
+  fci->buf = solv_extend(fci->buf, fci->len, len, 1, 4095);
+  memcpy(fci->buf + fci->len, blob, len);
+  fci->len += len;
+}
+
+static void
+fileconflictinfo_cb(void *cbdata, const char *fn, struct filelistinfo *info)
+{
+  struct fileconflictinfo *fci = cbdata;
+  const char *d = info->digest;
+  unsigned char bin[128];
+  int i, l = strlen(d);
+
+  if (l > 2 * (int)sizeof(bin))
+    {
+      fci->bad = 1;	/* does not fit the replay buffer */
+      return;
+    }
+  fileconflictinfo_addnum(fci, info->diridx);
+  fileconflictinfo_addblob(fci, fn + info->dirlen, strlen(fn + info->dirlen) + 1);
+  fileconflictinfo_addnum(fci, info->mode);
+  fileconflictinfo_addnum(fci, info->color);
+  for (i = 0; i < l; i++)
+    if (!((d[i] >= '0' && d[i] <= '9') || (d[i] >= 'a' && d[i] <= 'f')))
+      break;
+  if (i < l || (l & 1) != 0)
+    {
+      fileconflictinfo_addnum(fci, 2 * l + 1);
+      fileconflictinfo_addblob(fci, d, l);
+      return;
+    }
+  solv_hex2bin(&d, bin, l / 2);
+  fileconflictinfo_addnum(fci, l);
+  fileconflictinfo_addblob(fci, bin, l / 2);
+}
+
+static void
+addfileconflictinfo(Repodata *data, Id handle, RpmHead *rpmhead)
+{
+  struct fileconflictinfo fci;
+  char **dn;
+  int i, dcnt = 0;
+
+  /* without digests we cannot do the file expansion, so let
+   * pool_findfileconflicts fall back to the header */
+  if (headexists(rpmhead, TAG_BASENAMES) && !headexists(rpmhead, TAG_FILEMD5S))
+    return;
+  memset(&fci, 0, sizeof(fci));
+  fileconflictinfo_addnum(&fci, FILECONFLICTINFO_VERSION);
+  dn = headstringarray(rpmhead, TAG_DIRNAMES, &dcnt);
+  fileconflictinfo_addnum(&fci, dn ? dcnt : 0);
+  for (i = 0; dn && i < dcnt; i++)
+    fileconflictinfo_addblob(&fci, dn[i], strlen(dn[i]) + 1);
+  solv_free(dn);
+  rpm_iterate_filelist(rpmhead, RPM_ITERATE_FILELIST_WITHMD5 | RPM_ITERATE_FILELIST_WITHCOL | RPM_ITERATE_FILELIST_NOGHOSTS, fileconflictinfo_cb, &fci);
+  if (!fci.bad)
+    repodata_set_binary(data, handle, SOLVABLE_FILECONFLICTINFO, fci.buf, fci.len);
+  solv_free(fci.buf);
+}
+
 static void
 set_description_author(Repodata *data, Id handle, const char *str)
 {
@@ -1277,6 +1379,8 @@ rpmhead2solv(Pool *pool, Repo *repo, Repodata *data, Solvable *s, RpmHead *rpmhe
 	}
       if ((flags & RPM_ADD_NO_FILELIST) == 0)
 	addfilelist(data, handle, rpmhead, flags);
+      if ((flags & RPM_ADD_WITH_FILECONFLICTINFO) != 0)
+	addfileconflictinfo(data, handle, rpmhead);
       if ((flags & RPM_ADD_WITH_CHANGELOG) != 0)
 	addchangelog(data, handle, rpmhead);
     }
@@ -1856,7 +1960,8 @@ repo_add_rpmdb(Repo *repo, Repo *ref, int flags)
 	      if (id)
 		{
 		  Solvable *r = ref->pool->solvables + ref->start + (id - 1);
-		  if (r->repo == ref && solvable_copy(s, r, data, dircache, &oldkeyskip))
+		  /* re-read the header if the reference lacks the wanted file conflict info */
+		  if (r->repo == ref && ((flags & RPM_ADD_WITH_FILECONFLICTINFO) == 0 || solvable_lookup_type(r, SOLVABLE_FILECONFLICTINFO)) && solvable_copy(s, r, data, dircache, &oldkeyskip))
 		    continue;
 		}
 	    }
@@ -2390,6 +2495,134 @@ rpm_iterate_filelist(void *rpmhandle, int flags, void (*cb)(void *, const char *
   solv_free(ff);
 }
 
+static inline const unsigned char *
+fileconflictinfo_getnum(const unsigned char *dp, const unsigned char *dpe, unsigned int *xp)
+{
+  unsigned int x = 0;
+  while (dp < dpe)
+    {
+      x = (x << 7) | (*dp & 127);
+      if (!(*dp++ & 128))
+	{
+	  *xp = x;
+	  return dp;
+	}
+    }
+  return 0;
+}
+
+static inline const unsigned char *
+fileconflictinfo_getstr(const unsigned char *dp, const unsigned char *dpe, const char **strp)
+{
+  const unsigned char *e = dp && dp < dpe ? memchr(dp, 0, dpe - dp) : 0;
+  if (!e)
+    return 0;
+  *strp = (const char *)dp;
+  return e + 1;
+}
+
+/* parse one file entry, returns 0 if it is corrupt */
+static const unsigned char *
+fileconflictinfo_getentry(const unsigned char *dp, const unsigned char *dpe, unsigned int dcnt, unsigned int *diridxp, const char **bnp, unsigned int *modep, unsigned int *colorp, const char **digestp, unsigned int *dlp)
+{
+  dp = fileconflictinfo_getnum(dp, dpe, diridxp);
+  dp = fileconflictinfo_getstr(dp, dpe, bnp);
+  if (dp)
+    dp = fileconflictinfo_getnum(dp, dpe, modep);
+  if (dp)
+    dp = fileconflictinfo_getnum(dp, dpe, colorp);
+  if (dp)
+    dp = fileconflictinfo_getnum(dp, dpe, dlp);
+  if (!dp || *diridxp >= dcnt || *dlp / 2 > (unsigned int)(dpe - dp) || ((*dlp & 1) ? *dlp / 2 : *dlp) >= FILECONFLICTINFO_DIGESTSIZE)
+    return 0;
+  *digestp = (const char *)dp;
+  return dp + *dlp / 2;
+}
+
+/* replay the file list stored with RPM_ADD_WITH_FILECONFLICTINFO. Ghost
+ * files are not stored, so RPM_ITERATE_FILELIST_NOGHOSTS is implied.
+ * Returns 0 if the info cannot be used, the callback is not called in
+ * that case, so the caller can fall back to the rpm header. */
+int
+rpm_iterate_fileconflictinfo(const void *info, int infol, int flags, void (*cb)(void *, const char *, struct filelistinfo *), void *cbdata)
+{
+  const unsigned char *dp = info, *dpe = dp + infol, *entries;
+  const char **dn, *bn, *d;
+  unsigned int version, dcnt, diridx, mode, color, dl;
+  unsigned int i, l, l1, lastdir, lastdirl;
+  char *space = 0;
+  unsigned int spacen = 0;
+  char digest[FILECONFLICTINFO_DIGESTSIZE];
+  struct filelistinfo finfo;
+
+  if (!dp || !(dp = fileconflictinfo_getnum(dp, dpe, &version)) || version != FILECONFLICTINFO_VERSION)
+    return 0;
+  if (!(dp = fileconflictinfo_getnum(dp, dpe, &dcnt)) || dcnt > (unsigned int)(dpe - dp))
+    return 0;
+  dn = solv_calloc(dcnt ? dcnt : 1, sizeof(char *));
+  for (i = 0; i < dcnt; i++)
+    if (!(dp = fileconflictinfo_getstr(dp, dpe, dn + i)))
+      {
+	solv_free(dn);
+	return 0;
+      }
+  /* check all entries first, so that a corrupt entry does not
+   * result in a truncated file list */
+  for (entries = dp; dp < dpe; )
+    if (!(dp = fileconflictinfo_getentry(dp, dpe, dcnt, &diridx, &bn, &mode, &color, &d, &dl)))
+      {
+	solv_free(dn);
+	return 0;
+      }
+  if ((flags & RPM_ITERATE_FILELIST_ONLYDIRS) != 0)
+    {
+      for (i = 0; i < dcnt; i++)
+	(*cb)(cbdata, dn[i], 0);
+      solv_free(dn);
+      return 1;
+    }
+  lastdir = dcnt;
+  lastdirl = 0;
+  memset(&finfo, 0, sizeof(finfo));
+  for (dp = entries; dp < dpe; )
+    {
+      dp = fileconflictinfo_getentry(dp, dpe, dcnt, &diridx, &bn, &mode, &color, &d, &dl);
+      l1 = lastdir == diridx ? lastdirl : strlen(dn[diridx]);
+      l = l1 + strlen(bn) + 1;
+      if (l > spacen)
+	{
+	  spacen = l + 16;
+	  space = solv_realloc(space, spacen);
+	}
+      if (lastdir != diridx)
+	{
+	  strcpy(space, dn[diridx]);
+	  lastdir = diridx;
+	  lastdirl = l1;
+	}
+      strcpy(space + l1, bn);
+      finfo.diridx = diridx;
+      finfo.dirlen = l1;
+      finfo.mode = mode;
+      if ((flags & RPM_ITERATE_FILELIST_WITHMD5) != 0)
+	{
+	  if ((dl & 1) != 0)
+	    {
+	      memcpy(digest, d, dl / 2);
+	      digest[dl / 2] = 0;
+	    }
+	  else
+	    solv_bin2hex((const unsigned char *)d, dl / 2, digest);
+	  finfo.digest = digest;
+	}
+      finfo.color = (flags & RPM_ITERATE_FILELIST_WITHCOL) != 0 ? color : 0;
+      (*cb)(cbdata, space, &finfo);
+    }
+  solv_free(space);
+  solv_free(dn);
+  return 1;
+}
+
 char *
 rpm_query(void *rpmhandle, Id what)
 {
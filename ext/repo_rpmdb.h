@@ -28,6 +28,7 @@ extern Id repo_add_rpm(Repo *repo, const char *rpm, int flags);
 #define RPM_ADD_FILTERED_FILELIST	(1 << 18)
 #define RPMDB_KEEP_GPG_PUBKEY		(1 << 19)
 #define RPM_ADD_WITH_ORDERWITHREQUIRES	(1 << 20)
+#define RPM_ADD_WITH_FILECONFLICTINFO	(1 << 21)
 
 #define RPMDB_EMPTY_REFREPO		(1 << 30)	/* internal */
 
@@ -66,4 +67,6 @@ extern char *rpm_query(void *rpmhandle, Id what);
 extern unsigned long long rpm_query_num(void *rpmhandle, Id what, unsigned long long notfound);
 extern void rpm_query_idarray(void *rpmhandle, Id what, Pool *pool, Queue *q, int flags);
 extern void rpm_iterate_filelist(void *rpmhandle, int flags, void (*cb)(void *, const char *, struct filelistinfo *), void *cbdata);
+/* same as rpm_iterate_filelist, but works on a SOLVABLE_FILECONFLICTINFO blob */
+extern int rpm_iterate_fileconflictinfo(const void *info, int infol, int flags, void (*cb)(void *, const char *, struct filelistinfo *), void *cbdata);
 extern Id   repo_add_rpm_handle(Repo *repo, void *rpmhandle, int flags);
@@ -158,7 +158,25 @@ static inline lzma_ret setup_alone_encoder(lzma_stream *strm, int level)
 
 static lzma_stream stream_init = LZMA_STREAM_INIT;
 
-static LZFILE *lzopen(const char *path, const char *mode, int fd, int isxz)
+#if defined(ENABLE_READAHEAD) && LZMA_VERSION >= 50040002
+/* multi-threaded decoding of multi-block xz files */
+#define LZMA_DECODER_MT
+#define LZMA_DECODER_MT_MEMLIMIT	(256 << 20)
+
+static lzma_ret setup_mt_decoder(lzma_stream *strm)
+{
+  lzma_mt mt;
+  memset(&mt, 0, sizeof(mt));
+  mt.threads = lzma_cputhreads();
+  if (mt.threads < 1)
+    mt.threads = 1;
+  mt.memlimit_threading = LZMA_DECODER_MT_MEMLIMIT;
+  mt.memlimit_stop = LZMA_DECODER_MT_MEMLIMIT;
+  return lzma_stream_decoder_mt(strm, &mt);
+}
+#endif
+
+static LZFILE *lzopen(const char *path, const char *mode, int fd, int isxz, int threaded)
 {
   int level = 7;
   int encoding = 0;
@@ -188,6 +206,10 @@ static LZFILE *lzopen(const char *path, const char *mode, int fd, int isxz)
       else
 	ret = setup_alone_encoder(&lzfile->strm, level);
     }
+#ifdef LZMA_DECODER_MT
+  else if (isxz && threaded)
+    ret = setup_mt_decoder(&lzfile->strm);
+#endif
   else
     ret = lzma_auto_decoder(&lzfile->strm, 100 << 20, 0);
   if (ret != LZMA_OK)
@@ -304,25 +326,33 @@ static ssize_t lzwrite(void *cookie, const char *buf, size_t len)
 
 static inline FILE *myxzfopen(const char *fn, const char *mode)
 {
-  LZFILE *lzf = lzopen(fn, mode, -1, 1);
+  LZFILE *lzf = lzopen(fn, mode, -1, 1, 0);
   return solv_cookieopen(lzf, mode, lzread, lzwrite, lzclose);
 }
 
 static inline FILE *myxzfdopen(int fd, const char *mode)
 {
-  LZFILE *lzf = lzopen(0, mode, fd, 1);
+  LZFILE *lzf = lzopen(0, mode, fd, 1, 0);
   return solv_cookieopen(lzf, mode, lzread, lzwrite, lzclose);
 }
 
+#ifdef LZMA_DECODER_MT
+static inline FILE *myxzfopen_mt(const char *fn, int fd)
+{
+  LZFILE *lzf = fd >= 0 ? lzopen(0, "r", fd, 1, 1) : lzopen(fn, "r", -1, 1, 1);
+  return solv_cookieopen(lzf, "r", lzread, lzwrite, lzclose);
+}
+#endif
+
 static inline FILE *mylzfopen(const char *fn, const char *mode)
 {
-  LZFILE *lzf = lzopen(fn, mode, -1, 0);
+  LZFILE *lzf = lzopen(fn, mode, -1, 0, 0);
   return solv_cookieopen(lzf, mode, lzread, lzwrite, lzclose);
 }
 
 static inline FILE *mylzfdopen(int fd, const char *mode)
 {
-  LZFILE *lzf = lzopen(0, mode, fd, 0);
+  LZFILE *lzf = lzopen(0, mode, fd, 0, 0);
   return solv_cookieopen(lzf, mode, lzread, lzwrite, lzclose);
 }
 
@@ -644,6 +674,156 @@ static inline FILE *myzchunkfdopen(int fd, const char *mode)
 
 #endif /* ENABLE_ZCHUNK_COMPRESSION */
 
+#ifdef ENABLE_READAHEAD
+
+/* read-ahead: decompress in a background thread into a ring of buffers */
+
+#include <pthread.h>
+
+#define READAHEAD_NBUFS		4
+#define READAHEAD_BUFSIZE	(256 * 1024)
+
+struct readahead {
+  FILE *fp;		/* the decompressing stream, only used by the thread */
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  char *mem;
+  size_t lens[READAHEAD_NBUFS];
+  int head;		/* next buffer to fill */
+  int tail;		/* next buffer to consume */
+  int count;		/* number of filled buffers */
+  size_t off;		/* consumed bytes of the tail buffer */
+  int eof;
+  int error;
+  int stop;
+};
+
+static void *readahead_thread(void *arg)
+{
+  struct readahead *ra = arg;
+  char *buf;
+  size_t l;
+  int done;
+
+  for (;;)
+    {
+      pthread_mutex_lock(&ra->lock);
+      while (ra->count == READAHEAD_NBUFS && !ra->stop)
+	pthread_cond_wait(&ra->cond, &ra->lock);
+      if (ra->stop)
+	{
+	  pthread_mutex_unlock(&ra->lock);
+	  break;
+	}
+      buf = ra->mem + (size_t)ra->head * READAHEAD_BUFSIZE;
+      pthread_mutex_unlock(&ra->lock);
+      l = fread(buf, 1, READAHEAD_BUFSIZE, ra->fp);
+      pthread_mutex_lock(&ra->lock);
+      if (l)
+	{
+	  ra->lens[ra->head] = l;
+	  ra->head = (ra->head + 1) % READAHEAD_NBUFS;
+	  ra->count++;
+	}
+      if (l < READAHEAD_BUFSIZE)
+	{
+	  if (ferror(ra->fp))
+	    ra->error = 1;
+	  else
+	    ra->eof = 1;
+	}
+      done = ra->eof || ra->error;
+      pthread_cond_broadcast(&ra->cond);
+      pthread_mutex_unlock(&ra->lock);
+      if (done)
+	break;
+    }
+  return 0;
+}
+
+static ssize_t cookie_raread(void *cookie, char *buf, size_t nbytes)
+{
+  struct readahead *ra = cookie;
+  size_t l;
+
+  pthread_mutex_lock(&ra->lock);
+  while (!ra->count && !ra->eof && !ra->error)
+    pthread_cond_wait(&ra->cond, &ra->lock);
+  if (!ra->count)
+    {
+      /* all data consumed */
+      int r = ra->error ? -1 : 0;
+      pthread_mutex_unlock(&ra->lock);
+      return r;
+    }
+  pthread_mutex_unlock(&ra->lock);
+  /* the tail buffer belongs to us until we hand it back */
+  l = ra->lens[ra->tail] - ra->off;
+  if (l > nbytes)
+    l = nbytes;
+  memcpy(buf, ra->mem + (size_t)ra->tail * READAHEAD_BUFSIZE + ra->off, l);
+  ra->off += l;
+  if (ra->off == ra->lens[ra->tail])
+    {
+      pthread_mutex_lock(&ra->lock);
+      ra->off = 0;
+      ra->tail = (ra->tail + 1) % READAHEAD_NBUFS;
+      ra->count--;
+      pthread_cond_broadcast(&ra->cond);
+      pthread_mutex_unlock(&ra->lock);
+    }
+  return l;
+}
+
+static int cookie_raclose(void *cookie)
+{
+  struct readahead *ra = cookie;
+  int r;
+
+  pthread_mutex_lock(&ra->lock);
+  ra->stop = 1;
+  pthread_cond_broadcast(&ra->cond);
+  pthread_mutex_unlock(&ra->lock);
+  pthread_join(ra->thread, 0);
+  r = fclose(ra->fp);
+  pthread_cond_destroy(&ra->cond);
+  pthread_mutex_destroy(&ra->lock);
+  solv_free(ra->mem);
+  solv_free(ra);
+  return r;
+}
+
+static FILE *readaheadopen(FILE *fp)
+{
+  struct readahead *ra;
+  FILE *rafp;
+
+  ra = solv_calloc(1, sizeof(*ra));
+  ra->fp = fp;
+  ra->mem = solv_malloc2(READAHEAD_NBUFS, READAHEAD_BUFSIZE);
+  pthread_mutex_init(&ra->lock, 0);
+  pthread_cond_init(&ra->cond, 0);
+  if (pthread_create(&ra->thread, 0, readahead_thread, ra) != 0)
+    {
+      /* no thread, just read directly from the stream */
+      pthread_cond_destroy(&ra->cond);
+      pthread_mutex_destroy(&ra->lock);
+      solv_free(ra->mem);
+      solv_free(ra);
+      return fp;
+    }
+  rafp = solv_cookieopen(ra, "r", cookie_raread, 0, cookie_raclose);
+  if (!rafp)
+    {
+      cookie_raclose(ra);
+      return 0;
+    }
+  return rafp;
+}
+
+#endif /* ENABLE_READAHEAD */
+
 #else
 /* no cookies no compression */
 #undef ENABLE_ZLIB_COMPRESSION
@@ -651,10 +831,52 @@ static inline FILE *myzchunkfdopen(int fd, const char *mode)
 #undef ENABLE_BZIP2_COMPRESSION
 #undef ENABLE_ZSTD_COMPRESSION
 #undef ENABLE_ZCHUNK_COMPRESSION
+#undef ENABLE_READAHEAD
 #endif
 
 
 
+/* handle the 'R' mode flag: read compressed files with read-ahead */
+static FILE *
+xfopen_readahead(const char *fn, int fd, int usefd, const char *mode)
+{
+  char rmode[16];
+  FILE *fp;
+  size_t i, j;
+#ifdef ENABLE_READAHEAD
+  int readonly;
+#endif
+#ifdef LZMA_DECODER_MT
+  const char *suf;
+#endif
+
+  for (i = j = 0; mode[i] && j < sizeof(rmode) - 1; i++)
+    if (mode[i] != 'R')
+      rmode[j++] = mode[i];
+  if (!j)
+    rmode[j++] = 'r';
+  rmode[j] = 0;
+#ifdef ENABLE_READAHEAD
+  /* "r", "rb", "re", ... all open the file for reading only */
+  readonly = rmode[0] == 'r' && !strpbrk(rmode, "+wa");
+#endif
+  fp = 0;
+#ifdef LZMA_DECODER_MT
+  suf = fn ? strrchr(fn, '.') : 0;
+  if (suf && !strcmp(suf, ".xz") && readonly)
+    fp = myxzfopen_mt(fn, usefd ? fd : -1);
+#endif
+  if (!fp)
+    fp = usefd ? solv_xfopen_fd(fn, fd, rmode) : solv_xfopen(fn, rmode);
+#ifdef ENABLE_READAHEAD
+  /* libzstd has no threaded decoder, so zstd (like gzip and bzip2)
+   * only gets the decompression overlapped with the parsing */
+  if (fp && readonly && solv_xfopen_iscompressed(fn) > 0)
+    fp = readaheadopen(fp);
+#endif
+  return fp;
+}
+
 FILE *
 solv_xfopen(const char *fn, const char *mode)
 {
@@ -667,6 +889,8 @@ solv_xfopen(const char *fn, const char *mode)
     }
   if (!mode)
     mode = "r";
+  if (strchr(mode, 'R'))
+    return xfopen_readahead(fn, -1, 0, mode);
   suf = strrchr(fn, '.');
 #ifdef ENABLE_ZLIB_COMPRESSION
   if (suf && !strcmp(suf, ".gz"))
@@ -734,6 +958,8 @@ solv_xfopen_fd(const char *fn, int fd, const char *mode)
   const char *simplemode = mode;
   const char *suf;
 
+  if (mode && strchr(mode, 'R'))
+    return xfopen_readahead(fn, fd, 1, mode);
   suf = fn ? strrchr(fn, '.') : 0;
   if (!mode)
     {
@@ -886,8 +1112,8 @@ static ssize_t cookie_bufwrite(void *cookie, const char *buf, size_t nbytes)
   if (n)
     {
       *bc->bufp = solv_extend(*bc->bufp, *bc->buflp, n + 1, 1, 4095);
-      memcpy(*bc->bufp, buf, n);
-      (*bc->bufp)[n] = 0;	/* zero-terminate */
+      memcpy(*bc->bufp + *bc->buflp, buf, n);
+      (*bc->bufp)[*bc->buflp + n] = 0;	/* zero-terminate */
       *bc->buflp += n;
     }
   return n;
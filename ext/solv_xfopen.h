@@ -17,6 +17,9 @@
   #include <unistd.h>
 #endif
 
+/* an 'R' in the read mode decompresses in a background thread if
+ * libsolv was built with read-ahead support, it is ignored otherwise.
+ * Multi-block xz files are then also decoded with multiple threads. */
 extern FILE *solv_xfopen(const char *fn, const char *mode);
 extern FILE *solv_xfopen_fd(const char *fn, int fd, const char *mode);
 extern FILE *solv_xfopen_buf(const char *fn, char **bufp, size_t *buflp, const char *mode);
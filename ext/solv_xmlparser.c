@@ -10,11 +10,20 @@
  */
 
 #include <sys/types.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#ifdef WITH_LIBXML2
+#ifdef WITH_BUILTIN_XMLPARSER
+#undef WITH_LIBXML2		/* the builtin parser takes precedence */
+#endif
+
+#if defined(WITH_BUILTIN_XMLPARSER)
+/* the builtin parser uses the expat callback signatures */
+typedef char XML_Char;
+#define XMLCALL
+#elif defined(WITH_LIBXML2)
 #include <libxml/parser.h>
 #else
 #include <expat.h>
@@ -244,7 +253,694 @@ set_error(struct solv_xmlparser *xmlp, const char *errstr, unsigned int line, un
   xmlp->column = column;
 }
 
-#ifdef WITH_LIBXML2
+#if defined(WITH_BUILTIN_XMLPARSER)
+
+/*
+ * The builtin xml tokenizer. The file is read into a big buffer which
+ * is tokenized in place: element names, attribute names and attribute
+ * values are zero terminated inside of the buffer and entities are
+ * expanded in place, so nothing needs to be copied. Like expat, we
+ * support UTF-8, US-ASCII and ISO-8859-1 input, the latter gets
+ * converted to UTF-8 when it is read. Document type declarations are
+ * skipped.
+ */
+
+#define XMLBUF_BLOCK	(256 * 1024)
+
+struct xmlbuf {
+  char *buf;
+  size_t len;			/* bytes in the buffer */
+  size_t alloc;			/* allocated bytes */
+  size_t pos;			/* start of the next token */
+  int eof;
+  int seenroot;			/* 1: in root element, 2: after root element */
+  int latin1;			/* convert the input from ISO-8859-1 */
+  unsigned int line;		/* line of the current token */
+  unsigned int nextline;	/* line of the next token */
+  const char *tok;		/* start of the current token */
+  unsigned int bufcol;		/* column of the first byte of the buffer */
+  Queue nameq;			/* offsets of the open element names */
+  char *names;
+  size_t lnames;
+  size_t anames;
+  const char **atts;
+  int aatts;
+};
+
+static inline int
+create_parser(struct solv_xmlparser *xmlp)
+{
+  struct xmlbuf *xb = solv_calloc(1, sizeof(*xb));
+  xb->line = xb->nextline = 1;
+  queue_init(&xb->nameq);
+  xmlp->parser = xb;
+  return 1;
+}
+
+static inline void
+free_parser(struct solv_xmlparser *xmlp)
+{
+  struct xmlbuf *xb = xmlp->parser;
+  if (!xb)
+    return;
+  solv_free(xb->buf);
+  solv_free(xb->names);
+  solv_free(xb->atts);
+  queue_free(&xb->nameq);
+  xmlp->parser = solv_free(xb);
+}
+
+static inline int
+isxmlspace(int c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static int
+xmlbuf_error(struct solv_xmlparser *xmlp, struct xmlbuf *xb, const char *p, const char *errstr)
+{
+  const char *s = p;
+  unsigned int line = xb->line, col;
+
+  /* the error may be on a later line than the start of the token */
+  for (s = xb->tok; s && s < p; s++)
+    if (*s == '\n')
+      line++;
+  for (s = p; s > xb->buf && s[-1] != '\n'; s--)
+    ;
+  col = p - s;
+  if (s == xb->buf)
+    col += xb->bufcol;
+  set_error(xmlp, errstr, line, col);
+  return 0;
+}
+
+/* convert the ISO-8859-1 input from off to the end of the buffer to UTF-8 */
+static void
+xmlbuf_latin1_to_utf8(struct xmlbuf *xb, size_t off)
+{
+  unsigned char *b;
+  size_t i, j, n = 0;
+
+  for (i = off; i < xb->len; i++)
+    if (xb->buf[i] & 0x80)
+      n++;
+  if (!n)
+    return;
+  if (xb->len + n + 1 > xb->alloc)
+    {
+      xb->alloc = xb->len + n + 1;
+      xb->buf = solv_realloc(xb->buf, xb->alloc);
+    }
+  /* work backwards so that we can convert in place */
+  b = (unsigned char *)xb->buf;
+  j = xb->len + n;
+  b[j] = 0;
+  for (i = xb->len; i-- > off; )
+    {
+      if (b[i] & 0x80)
+	{
+	  b[--j] = 0x80 | (b[i] & 0x3f);
+	  b[--j] = 0xc0 | (b[i] >> 6);
+	}
+      else
+	b[--j] = b[i];
+    }
+  xb->len += n;
+}
+
+static char *
+xmlbuf_find(char *s, char *end, const char *str, size_t l)
+{
+  while (end - s >= (ptrdiff_t)l && (s = memchr(s, *str, end - s - l + 1)) != 0)
+    {
+      if (!memcmp(s, str, l))
+	return s;
+      s++;
+    }
+  return 0;
+}
+
+/* expand the entity at *sp into d, returns the new d or 0 if the entity is invalid */
+static char *
+expand_entity(char *d, char **sp, char *end)
+{
+  char *s = *sp + 1, *semi;
+  unsigned int c = 0;
+
+  semi = memchr(s, ';', end - s > 12 ? 12 : end - s);
+  if (!semi || semi == s)
+    return 0;
+  if (*s == '#')
+    {
+      int base = 10;
+      if (++s < semi && *s == 'x')
+	{
+	  base = 16;
+	  s++;
+	}
+      if (s == semi)
+	return 0;
+      for (; s < semi; s++)
+	{
+	  int v = *s;
+	  if (v >= '0' && v <= '9')
+	    v -= '0';
+	  else if (base == 16 && v >= 'a' && v <= 'f')
+	    v -= 'a' - 10;
+	  else if (base == 16 && v >= 'A' && v <= 'F')
+	    v -= 'A' - 10;
+	  else
+	    return 0;
+	  c = c * base + v;
+	  if (c > 0x10ffff)
+	    return 0;
+	}
+      if (!c || (c >= 0xd800 && c < 0xe000))
+	return 0;
+      /* utf-8 encode, the result is never longer than the reference */
+      if (c < 0x80)
+	*d++ = c;
+      else if (c < 0x800)
+	{
+	  *d++ = 0xc0 | (c >> 6);
+	  *d++ = 0x80 | (c & 0x3f);
+	}
+      else if (c < 0x10000)
+	{
+	  *d++ = 0xe0 | (c >> 12);
+	  *d++ = 0x80 | ((c >> 6) & 0x3f);
+	  *d++ = 0x80 | (c & 0x3f);
+	}
+      else
+	{
+	  *d++ = 0xf0 | (c >> 18);
+	  *d++ = 0x80 | ((c >> 12) & 0x3f);
+	  *d++ = 0x80 | ((c >> 6) & 0x3f);
+	  *d++ = 0x80 | (c & 0x3f);
+	}
+    }
+  else if (semi - s == 2 && s[0] == 'l' && s[1] == 't')
+    *d++ = '<';
+  else if (semi - s == 2 && s[0] == 'g' && s[1] == 't')
+    *d++ = '>';
+  else if (semi - s == 3 && !memcmp(s, "amp", 3))
+    *d++ = '&';
+  else if (semi - s == 4 && !memcmp(s, "quot", 4))
+    *d++ = '"';
+  else if (semi - s == 4 && !memcmp(s, "apos", 4))
+    *d++ = '\'';
+  else
+    return 0;
+  *sp = semi + 1;
+  return d;
+}
+
+#define XMLTEXT_CONTENT	0
+#define XMLTEXT_ATTR	1
+#define XMLTEXT_CDATA	2
+
+/* expand entities and normalize line ends/white space in place,
+ * returns the new end or 0 on error. In case of an error *errp
+ * points to the offending character. */
+static char *
+normalize_text(char *s, char *end, int mode, char **errp)
+{
+  char *d;
+  int c;
+
+  for (; s < end; s++)
+    {
+      c = *s;
+      if (c == '\r' || (c == '&' && mode != XMLTEXT_CDATA))
+	break;
+      if (mode == XMLTEXT_ATTR && (c == '\t' || c == '\n' || c == '<'))
+	break;
+    }
+  for (d = s; s < end; )
+    {
+      c = *s;
+      if (c == '&' && mode != XMLTEXT_CDATA)
+	{
+	  if (!(d = expand_entity(d, &s, end)))
+	    {
+	      *errp = s;
+	      return 0;
+	    }
+	  continue;
+	}
+      s++;
+      if (c == '\r')
+	{
+	  if (s < end && *s == '\n')
+	    s++;
+	  c = '\n';
+	}
+      if (mode == XMLTEXT_ATTR)
+	{
+	  if (c == '<')
+	    {
+	      *errp = s - 1;
+	      return 0;
+	    }
+	  if (c == '\t' || c == '\n')
+	    c = ' ';
+	}
+      *d++ = c;
+    }
+  return d;
+}
+
+/* the expat error message for a normalize_text error at *pp. For
+ * invalid tokens *pp is moved to the offending character. */
+static const char *
+text_errstr(char **pp, char *end)
+{
+  char *p = *pp, *s = p + 1;
+  int hex = 0;
+  if (*p != '&')
+    return "not well-formed (invalid token)";
+  if (s < end && *s == '#')
+    {
+      if (++s < end && *s == 'x')
+	{
+	  hex = 1;
+	  s++;
+	}
+      for (p = s; s < end && ((*s >= '0' && *s <= '9') || (hex && ((*s >= 'a' && *s <= 'f') || (*s >= 'A' && *s <= 'F')))); s++)
+	;
+      if (s < end && *s == ';' && s != p)
+	return "reference to invalid character number";
+    }
+  else
+    {
+      for (p = s; s < end && ((*s >= 'a' && *s <= 'z') || (*s >= 'A' && *s <= 'Z') || (*s >= '0' && *s <= '9') || *s == '_' || *s == ':' || *s == '.' || *s == '-' || (*s & 0x80)); s++)
+	;
+      if (s < end && *s == ';' && s != p)
+	return "undefined entity";
+    }
+  *pp = s;
+  return "not well-formed (invalid token)";
+}
+
+#define XMLENC_UTF8	0
+#define XMLENC_LATIN1	1
+#define XMLENC_UNKNOWN	2
+#define XMLENC_WRONG	3
+
+/* check the encoding of the xml declaration, *encp is set to the
+ * encoding name for the error message */
+static int
+check_xmldecl(char *s, char *end, char **encp)
+{
+  char *enc = xmlbuf_find(s, end, "encoding", 8);
+  char *e;
+  if (!enc)
+    return XMLENC_UTF8;
+  *encp = enc;
+  for (s = enc + 8; s < end && isxmlspace(*s); s++)
+    ;
+  if (s == end || *s++ != '=')
+    return XMLENC_UNKNOWN;
+  while (s < end && isxmlspace(*s))
+    s++;
+  if (s == end || (*s != '"' && *s != '\''))
+    return XMLENC_UNKNOWN;
+  e = memchr(s + 1, *s, end - s - 1);
+  if (!e)
+    return XMLENC_UNKNOWN;
+  *encp = ++s;
+  if ((e - s == 5 && !strncasecmp(s, "utf-8", 5)) || (e - s == 8 && !strncasecmp(s, "us-ascii", 8)))
+    return XMLENC_UTF8;
+  if (e - s == 10 && !strncasecmp(s, "iso-8859-1", 10))
+    return XMLENC_LATIN1;
+  /* we cannot read UTF-16 if the declaration was readable */
+  if (e - s >= 6 && !strncasecmp(s, "utf-16", 6))
+    return XMLENC_WRONG;
+  return XMLENC_UNKNOWN;
+}
+
+static int
+parse_starttag(struct solv_xmlparser *xmlp, struct xmlbuf *xb, char *p, char *end)
+{
+  char *s, *name, *nameend, *an, *ane, *v, *ve, *ep;
+  int i, natts = 0, empty = 0;
+  size_t l;
+
+  name = s = p + 1;
+  while (s < end && !isxmlspace(*s) && *s != '/')
+    s++;
+  if (s == name)
+    return xmlbuf_error(xmlp, xb, p, "not well-formed (invalid token)");
+  nameend = s;
+  for (;;)
+    {
+      while (s < end && isxmlspace(*s))
+	s++;
+      if (s == end)
+	break;
+      if (*s == '/')
+	{
+	  if (s + 1 != end)
+	    return xmlbuf_error(xmlp, xb, s, "not well-formed (invalid token)");
+	  empty = 1;
+	  break;
+	}
+      an = s;
+      while (s < end && *s != '=' && !isxmlspace(*s))
+	s++;
+      ane = s;
+      while (s < end && isxmlspace(*s))
+	s++;
+      if (an == ane || s == end || *s != '=')
+	return xmlbuf_error(xmlp, xb, an, "not well-formed (invalid token)");
+      for (s++; s < end && isxmlspace(*s); s++)
+	;
+      if (s == end || (*s != '"' && *s != '\''))
+	return xmlbuf_error(xmlp, xb, s, "not well-formed (invalid token)");
+      v = s + 1;
+      s = memchr(v, *s, end - v);	/* cannot fail, see find_tagend */
+      if (!(ve = normalize_text(v, s, XMLTEXT_ATTR, &ep)))
+	{
+	  const char *errstr = text_errstr(&ep, s);
+	  /* expat reports undefined entities in attributes at the tag */
+	  return xmlbuf_error(xmlp, xb, *ep == '&' && !strcmp(errstr, "undefined entity") ? p : ep, errstr);
+	}
+      s++;
+      if (s < end && !isxmlspace(*s) && *s != '/')
+	return xmlbuf_error(xmlp, xb, s, "not well-formed (invalid token)");
+      for (i = 0; i < natts; i++)
+	if (!strncmp(xb->atts[2 * i], an, ane - an) && !xb->atts[2 * i][ane - an])
+	  return xmlbuf_error(xmlp, xb, an, "duplicate attribute");
+      *ane = 0;
+      *ve = 0;
+      if (2 * natts + 3 > xb->aatts)
+	{
+	  xb->aatts = 2 * natts + 16;
+	  xb->atts = solv_realloc2(xb->atts, xb->aatts, sizeof(const char *));
+	}
+      xb->atts[2 * natts] = an;
+      xb->atts[2 * natts + 1] = v;
+      natts++;
+    }
+  *nameend = 0;
+  if (!xb->atts)
+    xb->atts = solv_calloc(xb->aatts = 16, sizeof(const char *));
+  xb->atts[2 * natts] = 0;
+
+  if (xb->seenroot == 2)
+    return xmlbuf_error(xmlp, xb, p, "junk after document element");
+  xb->seenroot = 1;
+  /* remember the name so that we can check the end tag */
+  l = nameend - name + 1;
+  if (xb->lnames + l > xb->anames)
+    {
+      xb->anames = xb->lnames + l + 256;
+      xb->names = solv_realloc(xb->names, xb->anames);
+    }
+  memcpy(xb->names + xb->lnames, name, l);
+  queue_push(&xb->nameq, xb->lnames);
+  xb->lnames += l;
+
+  start_element(xmlp, name, xb->atts);
+  if (empty)
+    {
+      xb->lnames = queue_pop(&xb->nameq);
+      if (!xb->nameq.count)
+	xb->seenroot = 2;
+      end_element(xmlp, name);
+    }
+  return 1;
+}
+
+static int
+parse_endtag(struct solv_xmlparser *xmlp, struct xmlbuf *xb, char *p, char *end)
+{
+  char *name = p + 2, *s = end;
+  const char *oname;
+
+  while (s > name && isxmlspace(s[-1]))
+    s--;
+  if (!xb->nameq.count)
+    return xmlbuf_error(xmlp, xb, p, "not well-formed (invalid token)");
+  oname = xb->names + xb->nameq.elements[xb->nameq.count - 1];
+  if (strncmp(oname, name, s - name) || oname[s - name])
+    return xmlbuf_error(xmlp, xb, p + 2, "mismatched tag");
+  *s = 0;
+  xb->lnames = queue_pop(&xb->nameq);
+  if (!xb->nameq.count)
+    xb->seenroot = 2;
+  end_element(xmlp, name);
+  return 1;
+}
+
+/* find the '>' of a tag, skipping quoted attribute values */
+static char *
+find_tagend(char *s, char *end)
+{
+  for (;;)
+    {
+      while (s < end && *s != '>' && *s != '"' && *s != '\'')
+	s++;
+      if (s == end || *s == '>')
+	return s < end ? s : 0;
+      if (!(s = memchr(s + 1, *s, end - s - 1)))
+	return 0;
+      s++;
+    }
+}
+
+/* find the end of a document type declaration */
+static char *
+find_doctypeend(char *s, char *end)
+{
+  int depth = 0;
+  for (; s < end; s++)
+    {
+      if (*s == '"' || *s == '\'')
+	{
+	  if (!(s = memchr(s + 1, *s, end - s - 1)))
+	    return 0;
+	}
+      else if (*s == '[')
+	depth++;
+      else if (*s == ']')
+	depth--;
+      else if (*s == '>' && depth <= 0)
+	return s;
+    }
+  return 0;
+}
+
+static inline void
+count_lines(struct xmlbuf *xb, const char *s, const char *end)
+{
+  xb->line = xb->nextline;
+  xb->tok = s;
+  while (s < end && (s = memchr(s, '\n', end - s)) != 0)
+    {
+      xb->nextline++;
+      s++;
+    }
+}
+
+/* parse all complete tokens in the buffer */
+static int
+parse_tokens(struct solv_xmlparser *xmlp, struct xmlbuf *xb)
+{
+  char *buf = xb->buf, *end = buf + xb->len;
+  char *p, *e, *s, *ep;
+
+  for (;;)
+    {
+      p = buf + xb->pos;
+      if (p == end)
+	return 1;
+      if (*p != '<')
+	{
+	  /* character data */
+	  if (!(e = memchr(p, '<', end - p)))
+	    {
+	      if (!xb->eof)
+		return 1;
+	      e = end;
+	    }
+	  count_lines(xb, p, e);
+	  if (!xb->nameq.count)
+	    {
+	      for (s = p; s < e; s++)
+		if (!isxmlspace(*s))
+		  return xmlbuf_error(xmlp, xb, s, xb->seenroot ? "junk after document element" : "syntax error");
+	    }
+	  else if (xmlp->docontent || memchr(p, '&', e - p))
+	    {
+	      /* also check the entities of the content we do not want */
+	      if (!(s = normalize_text(p, e, XMLTEXT_CONTENT, &ep)))
+		{
+		  const char *errstr = text_errstr(&ep, e);
+		  return xmlbuf_error(xmlp, xb, ep, errstr);
+		}
+	      if (xmlp->docontent)
+		character_data(xmlp, p, s - p);
+	    }
+	  xb->pos = e - buf;
+	  continue;
+	}
+      if (end - p < 9 && !xb->eof)
+	return 1;
+      if (p[1] == '/')
+	{
+	  if (!(e = memchr(p, '>', end - p)))
+	    break;
+	  count_lines(xb, p, e);
+	  if (!parse_endtag(xmlp, xb, p, e))
+	    return 0;
+	}
+      else if (p[1] == '?')
+	{
+	  if (!(e = xmlbuf_find(p + 2, end, "?>", 2)))
+	    break;
+	  count_lines(xb, p, e);
+	  if (!xb->seenroot && !strncmp(p, "<?xml", 5) && isxmlspace(p[5]))
+	    {
+	      char *enc = p;
+	      switch (check_xmldecl(p + 6, e, &enc))
+		{
+		case XMLENC_LATIN1:
+		  if (!xb->latin1)
+		    {
+		      size_t eoff = e - buf;
+		      xb->latin1 = 1;
+		      xmlbuf_latin1_to_utf8(xb, eoff + 2);
+		      buf = xb->buf;
+		      end = buf + xb->len;
+		      e = buf + eoff;
+		    }
+		  break;
+		case XMLENC_UNKNOWN:
+		  return xmlbuf_error(xmlp, xb, enc, "unknown encoding");
+		case XMLENC_WRONG:
+		  return xmlbuf_error(xmlp, xb, enc, "encoding specified in XML declaration is incorrect");
+		default:
+		  break;
+		}
+	    }
+	  e++;
+	}
+      else if (p[1] == '!')
+	{
+	  if (!strncmp(p, "<!--", 4))
+	    {
+	      if (!(e = xmlbuf_find(p + 4, end, "-->", 3)))
+		break;
+	      count_lines(xb, p, e);
+	      e += 2;
+	    }
+	  else if (!strncmp(p, "<![CDATA[", 9))
+	    {
+	      if (!(e = xmlbuf_find(p + 9, end, "]]>", 3)))
+		{
+		  if (!xb->eof)
+		    break;
+		  /* like expat, report the end of the input */
+		  count_lines(xb, p, end);
+		  return xmlbuf_error(xmlp, xb, end, "unclosed CDATA section");
+		}
+	      count_lines(xb, p, e);
+	      if (!xb->nameq.count)
+		return xmlbuf_error(xmlp, xb, p, "not well-formed (invalid token)");
+	      if (xmlp->docontent)
+		{
+		  s = normalize_text(p + 9, e, XMLTEXT_CDATA, &ep);
+		  character_data(xmlp, p + 9, s - (p + 9));
+		}
+	      e += 2;
+	    }
+	  else if (!strncmp(p, "<!DOCTYPE", 9))
+	    {
+	      if (!(e = find_doctypeend(p + 9, end)))
+		break;
+	      count_lines(xb, p, e);
+	    }
+	  else
+	    return xmlbuf_error(xmlp, xb, p, "not well-formed (invalid token)");
+	}
+      else
+	{
+	  if (!(e = find_tagend(p + 1, end)))
+	    break;
+	  count_lines(xb, p, e);
+	  if (!parse_starttag(xmlp, xb, p, e))
+	    return 0;
+	}
+      xb->pos = e + 1 - buf;
+    }
+  /* incomplete token */
+  if (xb->eof)
+    {
+      xb->line = xb->nextline;
+      xb->tok = p;
+      return xmlbuf_error(xmlp, xb, p, "unclosed token");
+    }
+  return 1;
+}
+
+static int
+parse_file(struct solv_xmlparser *xmlp, FILE *fp)
+{
+  struct xmlbuf *xb = xmlp->parser;
+  size_t l;
+
+  for (;;)
+    {
+      /* move the incomplete token to the start of the buffer */
+      if (xb->pos)
+	{
+	  const char *s = xb->buf + xb->pos;
+	  while (s > xb->buf && s[-1] != '\n')
+	    s--;
+	  xb->bufcol = (s == xb->buf ? xb->bufcol : 0) + (unsigned int)(xb->buf + xb->pos - s);
+	  if (xb->pos < xb->len)
+	    memmove(xb->buf, xb->buf + xb->pos, xb->len - xb->pos);
+	  xb->len -= xb->pos;
+	  xb->pos = 0;
+	}
+      if (xb->len + XMLBUF_BLOCK + 1 > xb->alloc)
+	{
+	  xb->alloc = xb->len + XMLBUF_BLOCK + 1;
+	  xb->buf = solv_realloc(xb->buf, xb->alloc);
+	}
+      l = fread(xb->buf + xb->len, 1, XMLBUF_BLOCK, fp);
+      if (!l)
+	xb->eof = 1;
+      if (!xb->seenroot && xb->nextline == 1 && !xb->len && l >= 3 && !memcmp(xb->buf, "\357\273\277", 3))
+	xb->pos = 3;	/* skip the byte order mark */
+      xb->len += l;
+      xb->buf[xb->len] = 0;
+      if (xb->latin1)
+	xmlbuf_latin1_to_utf8(xb, xb->len - l);
+      if (!parse_tokens(xmlp, xb))
+	return 0;
+      if (xb->eof)
+	break;
+    }
+  if (xb->nameq.count || !xb->seenroot)
+    {
+      xb->line = xb->nextline;
+      xb->tok = 0;
+      return xmlbuf_error(xmlp, xb, xb->buf + xb->len, "no element found");
+    }
+  return 1;
+}
+
+unsigned int
+solv_xmlparser_lineno(struct solv_xmlparser *xmlp)
+{
+  struct xmlbuf *xb = xmlp->parser;
+  return xb ? xb->line : 0;
+}
+
+#elif defined(WITH_LIBXML2)
 
 static inline int
 create_parser(struct solv_xmlparser *xmlp)
@@ -344,11 +1040,29 @@ solv_xmlparser_lineno(struct solv_xmlparser *xmlp)
 
 #endif
 
+#ifndef WITH_BUILTIN_XMLPARSER
+static int
+parse_file(struct solv_xmlparser *xmlp, FILE *fp)
+{
+  char buf[8192];
+  int l;
+
+  for (;;)
+    {
+      l = fread(buf, 1, sizeof(buf), fp);
+      if (!parse_block(xmlp, buf, l))
+	return 0;
+      if (!l)
+	break;
+    }
+  return 1;
+}
+#endif
+
 int
 solv_xmlparser_parse(struct solv_xmlparser *xmlp, FILE *fp)
 {
-  char buf[8192];
-  int l, ret = SOLV_XMLPARSER_OK;
+  int ret = SOLV_XMLPARSER_OK;
 
   xmlp->state = 0;
   xmlp->unknowncnt = 0;
@@ -361,17 +1075,8 @@ solv_xmlparser_parse(struct solv_xmlparser *xmlp, FILE *fp)
       set_error(xmlp, "could not create parser", 0, 0);
       return SOLV_XMLPARSER_ERROR;
     }
-  for (;;)
-    {
-      l = fread(buf, 1, sizeof(buf), fp);
-      if (!parse_block(xmlp, buf, l))
-	{
-	  ret = SOLV_XMLPARSER_ERROR;
-	  break;
-	}
-      if (!l)
-	break;
-    }
+  if (!parse_file(xmlp, fp))
+    ret = SOLV_XMLPARSER_ERROR;
   free_parser(xmlp);
   return ret;
 }
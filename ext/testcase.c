@@ -103,6 +103,8 @@ static struct resultflags2str {
   { TESTCASE_RESULT_ORDER,		"order" },
   { TESTCASE_RESULT_ORDEREDGES,		"orderedges" },
   { TESTCASE_RESULT_PROOF,		"proof" },
+  { TESTCASE_RESULT_STATS,		"stats" },
+  { TESTCASE_RESULT_ORDER_SCC,		"orderscc" },
   { 0, 0 }
 };
 
@@ -140,6 +142,12 @@ static struct solverflags2str {
   { SOLVER_FLAG_ONLY_NAMESPACE_RECOMMENDED, "onlynamespacerecommended", 0 },
   { SOLVER_FLAG_STRICT_REPO_PRIORITY,       "strictrepopriority", 0 },
   { SOLVER_FLAG_FOCUS_NEW,                  "focusnew", 0 },
+  { SOLVER_FLAG_RESTART_POLICY,             "restartpolicy", 0 },
+  { SOLVER_FLAG_RESTART_INTERVAL,           "restartinterval", 0 },
+  { SOLVER_FLAG_LEARNTRULE_LIMIT,           "learntrulelimit", 0 },
+  { SOLVER_FLAG_TIMEOUT,                    "timeout", 0 },
+  { SOLVER_FLAG_KEEP_LEARNT_RULES,          "keeplearntrules", 0 },
+  { SOLVER_FLAG_LAZY_PKGRULES,              "lazypkgrules", 0 },
   { 0, 0, 0 }
 };
 
@@ -160,6 +168,7 @@ static struct poolflags2str {
   { POOL_FLAG_ADDFILEPROVIDESFILTERED,      "addfileprovidesfiltered", 0 },
   { POOL_FLAG_NOWHATPROVIDESAUX,            "nowhatprovidesaux", 0 },
   { POOL_FLAG_WHATPROVIDESWITHDISABLED,     "whatprovideswithdisabled", 0 },
+  { POOL_FLAG_INCREMENTALWHATPROVIDES,     "incrementalwhatprovides", 0 },
   { 0, 0, 0 }
 };
 
@@ -1016,6 +1025,14 @@ testcase_getsolverflags(Solver *solv)
       v = solver_get_flag(solv, solverflags2str[i].flag);
       if (v == solverflags2str[i].def)
 	continue;
+      if (v != 0 && v != 1)
+	{
+	  char buf[24];
+	  sprintf(buf, "=%d", v);
+	  str = pool_tmpappend(pool, str, " ", solverflags2str[i].str);
+	  str = pool_tmpappend(pool, str, buf, 0);
+	  continue;
+	}
       str = pool_tmpappend(pool, str, v ? " " : " !", solverflags2str[i].str);
     }
   return str ? str + 1 : "";
@@ -1024,7 +1041,7 @@ testcase_getsolverflags(Solver *solv)
 int
 testcase_setsolverflags(Solver *solv, const char *str)
 {
-  const char *p = str, *s;
+  const char *p = str, *s, *e;
   int i, v;
   for (;;)
     {
@@ -1039,13 +1056,21 @@ testcase_setsolverflags(Solver *solv, const char *str)
       if (!*p)
 	break;
       s = p;
-      while (*p && *p != ' ' && *p != '\t' && *p != ',')
+      while (*p && *p != ' ' && *p != '\t' && *p != ',' && *p != '=')
 	p++;
+      e = p;
+      if (*p == '=')
+	{
+	  /* flag with a numeric value */
+	  v = atoi(p + 1);
+	  while (*p && *p != ' ' && *p != '\t' && *p != ',')
+	    p++;
+	}
       for (i = 0; solverflags2str[i].str; i++)
-	if (!strncmp(solverflags2str[i].str, s, p - s) && solverflags2str[i].str[p - s] == 0)
+	if (!strncmp(solverflags2str[i].str, s, e - s) && solverflags2str[i].str[e - s] == 0)
 	  break;
       if (!solverflags2str[i].str)
-	return pool_error(solv->pool, 0, "setsolverflags: unknown flag '%.*s'", (int)(p - s), s);
+	return pool_error(solv->pool, 0, "setsolverflags: unknown flag '%.*s'", (int)(e - s), s);
       if (solver_set_flag(solv, solverflags2str[i].flag, v) == -1)
         return pool_error(solv->pool, 0, "setsolverflags: unsupported flag '%s'", solverflags2str[i].str);
     }
@@ -1515,13 +1540,26 @@ testcase_solverresult(Solver *solv, int resultflags)
 	}
       queue_free(&q);
     }
+  if ((resultflags & TESTCASE_RESULT_STATS) != 0)
+    {
+      /* just the statistics that do not depend on timing */
+      char buf[64];
+      sprintf(buf, "stat aborted %d", solver_aborted(solv));
+      strqueue_push(&sq, buf);
+      sprintf(buf, "stat keptlearntrules %d", solver_get_stat(solv, SOLVER_STAT_KEPT_LEARNT_RULES));
+      strqueue_push(&sq, buf);
+      sprintf(buf, "stat lazyrounds %d", solver_get_stat(solv, SOLVER_STAT_LAZY_ROUNDS));
+      strqueue_push(&sq, buf);
+      sprintf(buf, "stat reusedpkgrules %d", solver_get_stat(solv, SOLVER_STAT_REUSED_PKG_RULES));
+      strqueue_push(&sq, buf);
+    }
   if ((resultflags & TESTCASE_RESULT_ORDER) != 0)
     {
       int i;
       char buf[256];
       Id p;
       Transaction *trans = solver_create_transaction(solv);
-      transaction_order(trans, 0);
+      transaction_order(trans, (resultflags & TESTCASE_RESULT_ORDER_SCC) != 0 ? SOLVER_TRANSACTION_ORDER_SCC : 0);
       for (i = 0; i < trans->steps.count; i++)
 	{
 	  p = trans->steps.elements[i];
@@ -1540,7 +1578,7 @@ testcase_solverresult(Solver *solv, int resultflags)
       int i, j;
       Id p, p2;
       Transaction *trans = solver_create_transaction(solv);
-      transaction_order(trans, SOLVER_TRANSACTION_KEEP_ORDEREDGES);
+      transaction_order(trans, SOLVER_TRANSACTION_KEEP_ORDEREDGES | ((resultflags & TESTCASE_RESULT_ORDER_SCC) != 0 ? SOLVER_TRANSACTION_ORDER_SCC : 0));
       queue_init(&q);
       for (i = 0; i < trans->steps.count; i++)
 	{
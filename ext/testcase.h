@@ -24,6 +24,8 @@
 #define TESTCASE_RESULT_ORDER		(1 << 12)
 #define TESTCASE_RESULT_ORDEREDGES	(1 << 13)
 #define TESTCASE_RESULT_PROOF		(1 << 14)
+#define TESTCASE_RESULT_STATS		(1 << 15)
+#define TESTCASE_RESULT_ORDER_SCC	(1 << 16)	/* order with SOLVER_TRANSACTION_ORDER_SCC */
 
 /* reuse solver hack, testsolv use only */
 #define TESTCASE_RESULT_REUSE_SOLVER	(1 << 31)
@@ -16,6 +16,7 @@
 #include <string.h>
 #include "evr.h"
 #include "pool.h"
+#include "pool_private.h"
 
 #ifdef ENABLE_CONDA
 #include "conda.h"
@@ -475,15 +476,51 @@ pool_evrcmp_str(const Pool *pool, const char *evr1, const char *evr2, int mode)
   return r;
 }
 
+/*
+ * The evr cache memoizes the result of pool_evrcmp for pairs of evr ids.
+ * Ids are never reused for different strings, so the entries stay
+ * valid until the compare semantics change (disttype, promoteepoch,
+ * havedistepoch). Each entry consists of evr1, evr2, mode and result.
+ * The cache is allocated in pool_create(), so pool_evrcmp() can fill it
+ * through the pointer while still taking a const pool.
+ */
+
+#define evrcache_hash(evr1, evr2, mode) (((Hashval)(evr1) * 31 ^ (Hashval)(evr2) * 7 ^ (Hashval)(mode)) & (EVRCACHE_SIZE - 1))
+
+void
+pool_clear_evrcache(Pool *pool)
+{
+  if (pool->evrcache)
+    memset(pool->evrcache, 0, EVRCACHE_SIZE * 4 * sizeof(Id));
+}
+
 int
 pool_evrcmp(const Pool *pool, Id evr1id, Id evr2id, int mode)
 {
   const char *evr1, *evr2;
+  Id *ce;
+  int r;
+
   if (evr1id == evr2id)
     return 0;
+  ce = pool_evrcache(pool);
+  if (ce)
+    {
+      ce += 4 * evrcache_hash(evr1id, evr2id, mode);
+      if (ce[0] == evr1id && ce[1] == evr2id && ce[2] == mode)
+	return ce[3];
+    }
   evr1 = pool_id2str(pool, evr1id);
   evr2 = pool_id2str(pool, evr2id);
-  return pool_evrcmp_str(pool, evr1, evr2, mode);
+  r = pool_evrcmp_str(pool, evr1, evr2, mode);
+  if (ce)
+    {
+      ce[0] = evr1id;
+      ce[1] = evr2id;
+      ce[2] = mode;
+      ce[3] = r;
+    }
+  return r;
 }
 
 int
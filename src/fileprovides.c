@@ -657,7 +657,8 @@ pool_addfileprovides_queue(Pool *pool, Queue *idq, Queue *idqinst)
   free_dirs_names_array(&cbd);
   solv_free(cbd.dids);
   pool_freewhatprovides(pool);	/* as we have added provides */
-  POOL_DEBUG(SOLV_DEBUG_STATS, "addfileprovides took %d ms\n", solv_timems(now));
+  pool->stats_addfileprovidestime = solv_timems(now);
+  POOL_DEBUG(SOLV_DEBUG_STATS, "addfileprovides took %d ms\n", pool->stats_addfileprovidestime);
 }
 
 void
@@ -62,6 +62,33 @@ strhash_cont(const char *str, Hashval r)
   return r;
 }
 
+/* word at a time hash function, used for the string pool
+ * (string, len) -> hash
+ * the result depends on the byte order, so it must not be stored
+ */
+static inline Hashval
+strnhash_words(const char *str, unsigned int len)
+{
+  Hashval r = len * 0x9e3779b1U;
+  Hashval w;
+  for (; len >= 4; len -= 4, str += 4)
+    {
+      memcpy(&w, str, 4);
+      r = (r ^ w) * 0x5bd1e995U;
+      r ^= r >> 15;
+    }
+  if (len)
+    {
+      w = 0;
+      memcpy(&w, str, len);
+      r = (r ^ w) * 0x5bd1e995U;
+    }
+  r ^= r >> 13;
+  r *= 0xc2b2ae35U;
+  r ^= r >> 16;
+  return r;
+}
+
 
 /* hash for rel
  * rel -> hash
@@ -107,6 +107,7 @@ struct orderdata {
   Transaction *trans;
   struct s_TransactionElement *tes;
   int ntes;
+  Id *p2te;		/* solvable -> te mapping, used when creating the edges */
   Id *edgedata;
   int nedgedata;
   Id *invedgedata;
@@ -165,7 +166,6 @@ addedge(struct orderdata *od, Id from, Id to, int type)
   Transaction *trans = od->trans;
   Pool *pool = trans->pool;
   Solvable *s;
-  struct s_TransactionElement *te;
   int i;
 
   /* printf("addedge %d %d type %d\n", from, to, type); */
@@ -209,20 +209,10 @@ addedge(struct orderdata *od, Id from, Id to, int type)
     }
 
   /* map from/to to te numbers */
-  for (i = 1, te = od->tes + i; i < od->ntes; i++, te++)
-    if (te->p == to)
-      break;
-  if (i == od->ntes)
+  to = od->p2te[to];
+  from = od->p2te[from];
+  if (!to || !from)
     return;
-  to = i;
-
-  for (i = 1, te = od->tes + i; i < od->ntes; i++, te++)
-    if (te->p == from)
-      break;
-  if (i == od->ntes)
-    return;
-  from = i;
-
   addteedge(od, from, to, type);
 }
 
@@ -872,6 +862,453 @@ share_cycle(struct orderdata *od, Id p1, Id p2)
   return 0;
 }
 
+/* find and break all cycles with a depth first search. If sccs is set,
+ * the search is restricted to the strongly connected components */
+static void
+killcycles(struct orderdata *od, Queue *todo, Id *sccs)
+{
+  struct s_TransactionElement *te;
+  int i, j, k, cycstart, cycel;
+  Id *cycle;
+
+  for (i = od->ntes - 1; i > 0; i--)
+    {
+      if (sccs && !sccs[i])
+	od->tes[i].mark = 2;	/* not in a cycle */
+      else
+	queue_push(todo, i);
+    }
+
+  while (todo->count)
+    {
+      i = queue_pop(todo);
+      /* printf("- look at TE %d\n", i); */
+      if (i < 0)
+	{
+	  i = -i;
+	  od->tes[i].mark = 2;	/* done with that one */
+	  continue;
+	}
+      te = od->tes + i;
+      if (te->mark == 2)
+	continue;		/* already finished before */
+      if (te->mark == 0)
+	{
+	  int edgestovisit = 0;
+	  /* new node, visit edges */
+	  for (j = te->edges; (k = od->edgedata[j]) != 0; j += 2)
+	    {
+	      if ((od->edgedata[j + 1] & TYPE_BROKEN) != 0)
+		continue;
+	      if (sccs && sccs[k] != sccs[i])
+		continue;	/* edge leaves the component, cannot be part of a cycle */
+	      if (od->tes[k].mark == 2)
+		continue;	/* no need to visit again */
+	      if (!edgestovisit++)
+	        queue_push(todo, -i);	/* end of edges marker */
+	      queue_push(todo, k);
+	    }
+	  if (!edgestovisit)
+	    te->mark = 2;	/* no edges, done with that one */
+	  else
+	    te->mark = 1;	/* under investigation */
+	  continue;
+	}
+      /* oh no, we found a cycle */
+      /* find start of cycle node (<0) */
+      for (j = todo->count - 1; j >= 0; j--)
+	if (todo->elements[j] == -i)
+	  break;
+      assert(j >= 0);
+      cycstart = j;
+      /* build te/edge chain */
+      k = cycstart;
+      for (j = k; j < todo->count; j++)
+	if (todo->elements[j] < 0)
+	  todo->elements[k++] = -todo->elements[j];
+      cycel = k - cycstart;
+      assert(cycel > 1);
+      /* make room for edges, two extra element for cycle loop + terminating 0 */
+      while (todo->count < cycstart + 2 * cycel + 2)
+	queue_push(todo, 0);
+      cycle = todo->elements + cycstart;
+      cycle[cycel] = i;		/* close the loop */
+      cycle[2 * cycel + 1] = 0;	/* terminator */
+      for (k = cycel; k > 0; k--)
+	{
+	  cycle[k * 2] = cycle[k];
+	  te = od->tes + cycle[k - 1];
+	  assert(te->mark == 1);
+	  te->mark = 0;	/* reset investigation marker */
+	  /* printf("searching for edge from %d to %d\n", cycle[k - 1], cycle[k]); */
+	  for (j = te->edges; od->edgedata[j]; j += 2)
+	    if (od->edgedata[j] == cycle[k])
+	      break;
+	  assert(od->edgedata[j]);
+	  cycle[k * 2 - 1] = j;
+	}
+      /* now cycle looks like this: */
+      /* te1 edge te2 edge te3 ... teN edge te1 0 */
+      breakcycle(od, cycle);
+      /* restart with start of cycle */
+      todo->count = cycstart + 1;
+    }
+}
+
+/* find the strongly connected components of the graph of unbroken
+ * edges with Tarjan's algorithm, only edges of at least type minedge
+ * are followed. sccs[i] is set to the component number of TE i, or to
+ * zero if the TE is not part of a cycle. Returns the number of
+ * components with more than one element. */
+static int
+findsccs(struct orderdata *od, Id *sccs, int minedge)
+{
+  Id *index, *lowlink, *edgep;
+  Queue stack, callstack;
+  int i, j, k, root, idx = 0, nsccs = 0;
+
+  index = solv_calloc(od->ntes, sizeof(Id));
+  lowlink = solv_calloc(od->ntes, sizeof(Id));
+  edgep = solv_calloc(od->ntes, sizeof(Id));
+  queue_init(&stack);
+  queue_init(&callstack);
+  for (root = 1; root < od->ntes; root++)
+    {
+      if (index[root])
+	continue;
+      index[root] = lowlink[root] = ++idx;
+      edgep[root] = od->tes[root].edges;
+      sccs[root] = -1;		/* on the stack */
+      queue_push(&stack, root);
+      queue_push(&callstack, root);
+      while (callstack.count)
+	{
+	  i = callstack.elements[callstack.count - 1];
+	  j = edgep[i];
+	  if ((k = od->edgedata[j]) != 0)
+	    {
+	      edgep[i] = j + 2;
+	      if ((od->edgedata[j + 1] & TYPE_BROKEN) != 0 || od->edgedata[j + 1] < minedge)
+		continue;
+	      if (!index[k])
+		{
+		  /* new TE, descend */
+		  index[k] = lowlink[k] = ++idx;
+		  edgep[k] = od->tes[k].edges;
+		  sccs[k] = -1;
+		  queue_push(&stack, k);
+		  queue_push(&callstack, k);
+		}
+	      else if (sccs[k] == -1 && index[k] < lowlink[i])
+		lowlink[i] = index[k];
+	      continue;
+	    }
+	  /* all edges visited */
+	  queue_pop(&callstack);
+	  if (callstack.count && lowlink[i] < lowlink[callstack.elements[callstack.count - 1]])
+	    lowlink[callstack.elements[callstack.count - 1]] = lowlink[i];
+	  if (lowlink[i] != index[i])
+	    continue;
+	  /* i is the root of a component, pop it from the stack */
+	  if (stack.elements[stack.count - 1] == i)
+	    {
+	      queue_pop(&stack);
+	      sccs[i] = 0;	/* just a single TE */
+	      continue;
+	    }
+	  nsccs++;
+	  do
+	    {
+	      k = queue_pop(&stack);
+	      sccs[k] = nsccs;
+	    }
+	  while (k != i);
+	}
+    }
+  queue_free(&stack);
+  queue_free(&callstack);
+  solv_free(index);
+  solv_free(lowlink);
+  solv_free(edgep);
+  return nsccs;
+}
+
+static int
+sccpair_cmp(const void *ap, const void *bp, void *dp)
+{
+  const Id *a = ap, *b = bp;
+  if (a[0] != b[0])
+    return a[0] - b[0];
+  return a[1] - b[1];
+}
+
+/* like reachable(), but only follow edges inside component scc */
+static void
+sccreachable(struct orderdata *od, Id i, Id *sccs, Id scc)
+{
+  struct s_TransactionElement *te = od->tes + i;
+  int j, k;
+
+  te->mark = 1;
+  for (j = te->edges; (k = od->edgedata[j]) != 0; j += 2)
+    {
+      if ((od->edgedata[j + 1] & TYPE_BROKEN) != 0 || sccs[k] != scc)
+	continue;
+      if (!od->tes[k].mark)
+        sccreachable(od, k, sccs, scc);
+      if (od->tes[k].mark == 2)
+	{
+	  te->mark = 2;
+	  return;
+	}
+    }
+  te->mark = -1;
+}
+
+/* sort the TEs by component, the members of component n are
+ * list[start[n]] ... list[start[n + 1] - 1] */
+static Id *
+sccmembers(struct orderdata *od, Id *sccs, int nsccs, Id **startp)
+{
+  Id *start = solv_calloc(nsccs + 2, sizeof(Id));
+  Id *list;
+  int i;
+
+  for (i = 1; i < od->ntes; i++)
+    if (sccs[i])
+      start[sccs[i] + 1]++;
+  for (i = 1; i <= nsccs + 1; i++)
+    start[i] += start[i - 1];
+  list = solv_calloc(start[nsccs + 1] + 1, sizeof(Id));
+  for (i = 1; i < od->ntes; i++)
+    if (sccs[i])
+      list[start[sccs[i]]++] = i;
+  for (i = nsccs + 1; i > 0; i--)
+    start[i] = start[i - 1];
+  start[0] = 0;
+  *startp = start;
+  return list;
+}
+
+/* the severity part of addcycleedges: the cycles made of requires
+ * edges are processed first there, so that their elements stay together
+ * even if they are part of a bigger cycle with weaker edges.
+ * hardsccs are the components of the graph of requires edges. If such
+ * a component is smaller than the component it is part of, keep its
+ * elements together inside that component: the elements of the big
+ * component that depend on it are ordered after its last elements,
+ * its first elements after the elements it depends on. Edges that would
+ * create a new cycle are not added, like in addcycleedges. */
+static void
+addhardsccedges(struct orderdata *od, Id *sccs, int nsccs, Id *hardsccs, int nhardsccs, Queue *todo)
+{
+  struct s_TransactionElement *te;
+  Id *members, *start, *hardmembers, *hardstart;
+  Id *cm, *hm;
+  Queue tailq, headq, firstq, lastq;
+  int h, c, i, j, k, l, ncm, nhm;
+
+  members = sccmembers(od, sccs, nsccs, &start);
+  hardmembers = sccmembers(od, hardsccs, nhardsccs, &hardstart);
+  queue_init(&tailq);
+  queue_init(&headq);
+  queue_init(&firstq);
+  queue_init(&lastq);
+  for (h = 1; h <= nhardsccs; h++)
+    {
+      hm = hardmembers + hardstart[h];
+      nhm = hardstart[h + 1] - hardstart[h];
+      c = sccs[hm[0]];
+      cm = members + start[c];
+      ncm = start[c + 1] - start[c];
+      if (nhm == ncm)
+	continue;	/* same as the component, done in addsccedges */
+
+      /* the first and last elements of the hard component */
+      queue_empty(&firstq);
+      queue_empty(&lastq);
+      for (i = 0; i < ncm; i++)
+	od->tes[cm[i]].mark = 0;
+      for (i = 0; i < nhm; i++)
+	{
+	  te = od->tes + hm[i];
+	  for (j = te->edges; (k = od->edgedata[j]) != 0; j += 2)
+	    if ((od->edgedata[j + 1] & TYPE_BROKEN) == 0 && hardsccs[k] == h)
+	      {
+		te->mark |= 1;			/* depends on the component */
+		od->tes[k].mark |= 2;		/* the component depends on it */
+	      }
+	}
+      for (i = 0; i < nhm; i++)
+	{
+	  if (!(od->tes[hm[i]].mark & 1))
+	    queue_push(&firstq, hm[i]);
+	  if (!(od->tes[hm[i]].mark & 2))
+	    queue_push(&lastq, hm[i]);
+	}
+
+      /* tail edges: see what we can reach from the hard component */
+      for (i = 0; i < ncm; i++)
+	od->tes[cm[i]].mark = 0;
+      queue_empty(todo);
+      for (i = 0; i < nhm; i++)
+	{
+	  od->tes[hm[i]].mark = 2;
+	  queue_push(todo, hm[i]);
+	}
+      while (todo->count)
+	{
+	  te = od->tes + queue_pop(todo);
+	  for (j = te->edges; (k = od->edgedata[j]) != 0; j += 2)
+	    {
+	      if ((od->edgedata[j + 1] & TYPE_BROKEN) != 0 || sccs[k] != c || od->tes[k].mark)
+		continue;
+	      od->tes[k].mark = 1;
+	      queue_push(todo, k);
+	    }
+	}
+      /* the elements that are not reachable can be ordered after it */
+      queue_empty(&tailq);
+      for (i = 0; i < ncm; i++)
+	{
+	  te = od->tes + cm[i];
+	  if (te->mark)
+	    continue;
+	  for (j = te->edges; (k = od->edgedata[j]) != 0; j += 2)
+	    if ((od->edgedata[j + 1] & TYPE_BROKEN) == 0 && hardsccs[k] == h)
+	      break;
+	  if (k)
+	    queue_push(&tailq, cm[i]);
+	}
+      for (i = 0; i < tailq.count; i++)
+	for (l = 0; l < lastq.count; l++)
+	  addteedge(od, tailq.elements[i], lastq.elements[l], TYPE_CYCLETAIL);
+
+      /* head edges: the dependencies that cannot reach the hard component */
+      for (i = 0; i < ncm; i++)
+	od->tes[cm[i]].mark = 0;
+      for (i = 0; i < nhm; i++)
+	od->tes[hm[i]].mark = 2;
+      queue_empty(&headq);
+      for (i = 0; i < nhm; i++)
+	{
+	  te = od->tes + hm[i];
+	  for (j = te->edges; (k = od->edgedata[j]) != 0; j += 2)
+	    {
+	      if ((od->edgedata[j + 1] & TYPE_BROKEN) != 0 || sccs[k] != c)
+		continue;
+	      if (!od->tes[k].mark)
+		sccreachable(od, k, sccs, c);
+	      if (od->tes[k].mark == -1)
+		{
+		  queue_push(&headq, k);
+		  od->tes[k].mark = -2;	/* no need to add that one again */
+		}
+	    }
+	}
+      for (i = 0; i < headq.count; i++)
+	for (l = 0; l < firstq.count; l++)
+	  addteedge(od, firstq.elements[l], headq.elements[i], TYPE_CYCLEHEAD);
+    }
+  queue_free(&tailq);
+  queue_free(&headq);
+  queue_free(&firstq);
+  queue_free(&lastq);
+  solv_free(members);
+  solv_free(start);
+  solv_free(hardmembers);
+  solv_free(hardstart);
+}
+
+/* the scc version of addcycleedges: instead of adding edges for every
+ * broken cycle, which needs a walk over the complete graph per cycle,
+ * keep the elements of every component together. Everything that
+ * depends on a component gets an edge to the last elements of the
+ * component (the ones no other element depends on), the first elements
+ * get an edge to everything the component depends on. As the new edges
+ * follow the component graph, no new cycles can be created. */
+static void
+addsccedges(struct orderdata *od, Id *sccs, int nsccs)
+{
+  struct s_TransactionElement *te;
+  Queue tailq, headq, firstq, lastq;
+  Id *first, *last;
+  int i, j, k, l, scc;
+
+  queue_init(&tailq);
+  queue_init(&headq);
+  first = solv_calloc(od->ntes, sizeof(Id));	/* no edge to the component */
+  last = solv_calloc(od->ntes, sizeof(Id));	/* no edge from the component */
+  for (i = 1; i < od->ntes; i++)
+    if (sccs[i])
+      first[i] = last[i] = 1;
+  for (i = 1, te = od->tes + i; i < od->ntes; i++, te++)
+    {
+      for (j = te->edges; (k = od->edgedata[j]) != 0; j += 2)
+	{
+	  if ((od->edgedata[j + 1] & TYPE_BROKEN) != 0)
+	    continue;
+	  if (sccs[i] && sccs[k] == sccs[i])
+	    {
+	      first[i] = 0;
+	      last[k] = 0;
+	      continue;
+	    }
+	  if (sccs[k])
+	    queue_push2(&tailq, sccs[k], i);	/* i depends on the component */
+	  if (sccs[i])
+	    queue_push2(&headq, sccs[i], k);	/* the component depends on k */
+	}
+    }
+  /* collect the first and last elements of every component */
+  queue_init(&firstq);
+  queue_init(&lastq);
+  for (i = 1; i < od->ntes; i++)
+    {
+      if (first[i])
+	queue_push2(&firstq, sccs[i], i);
+      if (last[i])
+	queue_push2(&lastq, sccs[i], i);
+    }
+  solv_sort(tailq.elements, tailq.count / 2, 2 * sizeof(Id), sccpair_cmp, 0);
+  solv_sort(headq.elements, headq.count / 2, 2 * sizeof(Id), sccpair_cmp, 0);
+  solv_sort(firstq.elements, firstq.count / 2, 2 * sizeof(Id), sccpair_cmp, 0);
+  solv_sort(lastq.elements, lastq.count / 2, 2 * sizeof(Id), sccpair_cmp, 0);
+  for (scc = 1, i = j = k = l = 0; scc <= nsccs; scc++)
+    {
+      int tailstart, headstart, firststart, laststart;
+      int ti, hi, fi, li;
+      for (tailstart = i; i < tailq.count && tailq.elements[i] == scc; i += 2)
+	;
+      for (headstart = j; j < headq.count && headq.elements[j] == scc; j += 2)
+	;
+      for (firststart = k; k < firstq.count && firstq.elements[k] == scc; k += 2)
+	;
+      for (laststart = l; l < lastq.count && lastq.elements[l] == scc; l += 2)
+	;
+      for (ti = tailstart; ti < i; ti += 2)
+	{
+	  if (ti > tailstart && tailq.elements[ti + 1] == tailq.elements[ti - 1])
+	    continue;	/* already done */
+	  for (li = laststart; li < l; li += 2)
+	    addteedge(od, tailq.elements[ti + 1], lastq.elements[li + 1], TYPE_CYCLETAIL);
+	}
+      for (hi = headstart; hi < j; hi += 2)
+	{
+	  if (hi > headstart && headq.elements[hi + 1] == headq.elements[hi - 1])
+	    continue;	/* already done */
+	  for (fi = firststart; fi < k; fi += 2)
+	    addteedge(od, firstq.elements[fi + 1], headq.elements[hi + 1], TYPE_CYCLEHEAD);
+	}
+    }
+  queue_free(&tailq);
+  queue_free(&headq);
+  queue_free(&firstq);
+  queue_free(&lastq);
+  solv_free(first);
+  solv_free(last);
+}
+
 void
 transaction_order(Transaction *trans, int flags)
 {
@@ -880,21 +1317,23 @@ transaction_order(Transaction *trans, int flags)
   Repo *installed = pool->installed;
   Id p;
   Solvable *s;
-  int i, j, k, numte, numedge;
+  int i, j, numte, numedge;
   struct orderdata od;
   struct s_TransactionElement *te;
   Queue todo, obsq, samerepoq, uninstq;
-  int cycstart, cycel;
-  Id *cycle;
   int oldcount;
   int start, now;
   Repo *lastrepo;
   int lastmedia, lastte;
   Id *temedianr;
   unsigned char *incycle;
+  Id *sccs, *hardsccs;
+  int nsccs = 0, nhardsccs = 0;
 
   start = now = solv_timems(0);
   POOL_DEBUG(SOLV_DEBUG_STATS, "ordering transaction\n");
+  trans->stats_ordertime = trans->stats_edgetime = trans->stats_cycletime = 0;
+  trans->stats_edges = trans->stats_cycles = 0;
   /* free old data if present */
   if (trans->orderdata)
     transaction_free_orderdata(trans);
@@ -925,6 +1364,8 @@ transaction_order(Transaction *trans, int flags)
   queue_init(&od.cyclesdata);
   queue_init(&od.edgedataq);
 
+  od.p2te = solv_calloc(pool->nsolvables, sizeof(Id));
+
   /* initialize TEs */
   for (i = 0, te = od.tes + 1; i < tr->count; i++)
     {
@@ -933,20 +1374,24 @@ transaction_order(Transaction *trans, int flags)
       if (installed && s->repo == installed && trans->transaction_installed[p - installed->start])
 	continue;
       te->p = p;
+      od.p2te[p] = te - od.tes;
       te++;
     }
 
   /* create dependency graph */
   for (i = 0; i < tr->count; i++)
     addsolvableedges(&od, pool->solvables + tr->elements[i]);
+  od.p2te = solv_free(od.p2te);
 
   /* count edges */
   numedge = 0;
   for (i = 1, te = od.tes + i; i < numte; i++, te++)
     for (j = te->edges; od.edgedata[j]; j += 2)
       numedge++;
+  trans->stats_edges = numedge;
+  trans->stats_edgetime = solv_timems(now);
   POOL_DEBUG(SOLV_DEBUG_STATS, "edges: %d, edge space: %d\n", numedge, od.nedgedata / 2);
-  POOL_DEBUG(SOLV_DEBUG_STATS, "edge creation took %d ms\n", solv_timems(now));
+  POOL_DEBUG(SOLV_DEBUG_STATS, "edge creation took %d ms\n", trans->stats_edgetime);
 
 #if 0
   dump_tes(&od);
@@ -955,105 +1400,51 @@ transaction_order(Transaction *trans, int flags)
   now = solv_timems(0);
   /* kill all cycles */
   queue_init(&todo);
-  for (i = numte - 1; i > 0; i--)
-    queue_push(&todo, i);
-
-  while (todo.count)
+  sccs = hardsccs = 0;
+  if ((flags & SOLVER_TRANSACTION_ORDER_SCC) != 0)
     {
-      i = queue_pop(&todo);
-      /* printf("- look at TE %d\n", i); */
-      if (i < 0)
-	{
-	  i = -i;
-	  od.tes[i].mark = 2;	/* done with that one */
-	  continue;
-	}
-      te = od.tes + i;
-      if (te->mark == 2)
-	continue;		/* already finished before */
-      if (te->mark == 0)
-	{
-	  int edgestovisit = 0;
-	  /* new node, visit edges */
-	  for (j = te->edges; (k = od.edgedata[j]) != 0; j += 2)
-	    {
-	      if ((od.edgedata[j + 1] & TYPE_BROKEN) != 0)
-		continue;
-	      if (od.tes[k].mark == 2)
-		continue;	/* no need to visit again */
-	      if (!edgestovisit++)
-	        queue_push(&todo, -i);	/* end of edges marker */
-	      queue_push(&todo, k);
-	    }
-	  if (!edgestovisit)
-	    te->mark = 2;	/* no edges, done with that one */
-	  else
-	    te->mark = 1;	/* under investigation */
-	  continue;
-	}
-      /* oh no, we found a cycle */
-      /* find start of cycle node (<0) */
-      for (j = todo.count - 1; j >= 0; j--)
-	if (todo.elements[j] == -i)
-	  break;
-      assert(j >= 0);
-      cycstart = j;
-      /* build te/edge chain */
-      k = cycstart;
-      for (j = k; j < todo.count; j++)
-	if (todo.elements[j] < 0)
-	  todo.elements[k++] = -todo.elements[j];
-      cycel = k - cycstart;
-      assert(cycel > 1);
-      /* make room for edges, two extra element for cycle loop + terminating 0 */
-      while (todo.count < cycstart + 2 * cycel + 2)
-	queue_push(&todo, 0);
-      cycle = todo.elements + cycstart;
-      cycle[cycel] = i;		/* close the loop */
-      cycle[2 * cycel + 1] = 0;	/* terminator */
-      for (k = cycel; k > 0; k--)
-	{
-	  cycle[k * 2] = cycle[k];
-	  te = od.tes + cycle[k - 1];
-	  assert(te->mark == 1);
-	  te->mark = 0;	/* reset investigation marker */
-	  /* printf("searching for edge from %d to %d\n", cycle[k - 1], cycle[k]); */
-	  for (j = te->edges; od.edgedata[j]; j += 2)
-	    if (od.edgedata[j] == cycle[k])
-	      break;
-	  assert(od.edgedata[j]);
-	  cycle[k * 2 - 1] = j;
-	}
-      /* now cycle looks like this: */
-      /* te1 edge te2 edge te3 ... teN edge te1 0 */
-      breakcycle(&od, cycle);
-      /* restart with start of cycle */
-      todo.count = cycstart + 1;
+      sccs = solv_calloc(numte, sizeof(Id));
+      nsccs = findsccs(&od, sccs, 0);
+      hardsccs = solv_calloc(numte, sizeof(Id));
+      nhardsccs = findsccs(&od, hardsccs, TYPE_REQ);
+      POOL_DEBUG(SOLV_DEBUG_STATS, "strongly connected components: %d, %d of them with requires cycles\n", nsccs, nhardsccs);
     }
+  killcycles(&od, &todo, sccs);
+  trans->stats_cycles = od.ncycles;
+  trans->stats_cycletime = solv_timems(now);
   POOL_DEBUG(SOLV_DEBUG_STATS, "cycles broken: %d\n", od.ncycles);
-  POOL_DEBUG(SOLV_DEBUG_STATS, "cycle breaking took %d ms\n", solv_timems(now));
+  POOL_DEBUG(SOLV_DEBUG_STATS, "cycle breaking took %d ms\n", trans->stats_cycletime);
 
   incycle = 0;
   if (od.cycles.count)
     {
       now = solv_timems(0);
-      incycle = solv_calloc(numte, 1);
-      /* now go through all broken cycles and create cycle edges to help
-	 the ordering */
-      for (i = od.cycles.count - 4; i >= 0; i -= 4)
-	{
-	  if (od.cycles.elements[i + 2] >= TYPE_REQ)
-	    addcycleedges(&od, od.cyclesdata.elements + od.cycles.elements[i], &todo);
-	}
-      for (i = od.cycles.count - 4; i >= 0; i -= 4)
+      if (sccs)
 	{
-	  if (od.cycles.elements[i + 2] < TYPE_REQ)
-	    addcycleedges(&od, od.cyclesdata.elements + od.cycles.elements[i], &todo);
+	  /* like addcycleedges, do the requires cycles first */
+	  addhardsccedges(&od, sccs, nsccs, hardsccs, nhardsccs, &todo);
+	  addsccedges(&od, sccs, nsccs);
 	}
-      for (i = od.cycles.count - 4; i >= 0; i -= 4)
+      else
 	{
-	  for (j = od.cycles.elements[i]; od.cyclesdata.elements[j]; j++)
-	    incycle[od.cyclesdata.elements[j]] = 1;
+	  incycle = solv_calloc(numte, 1);
+	  /* now go through all broken cycles and create cycle edges to help
+	     the ordering */
+	  for (i = od.cycles.count - 4; i >= 0; i -= 4)
+	    {
+	      if (od.cycles.elements[i + 2] >= TYPE_REQ)
+		addcycleedges(&od, od.cyclesdata.elements + od.cycles.elements[i], &todo);
+	    }
+	  for (i = od.cycles.count - 4; i >= 0; i -= 4)
+	    {
+	      if (od.cycles.elements[i + 2] < TYPE_REQ)
+		addcycleedges(&od, od.cyclesdata.elements + od.cycles.elements[i], &todo);
+	    }
+	  for (i = od.cycles.count - 4; i >= 0; i -= 4)
+	    {
+	      for (j = od.cycles.elements[i]; od.cyclesdata.elements[j]; j++)
+		incycle[od.cyclesdata.elements[j]] = 1;
+	    }
 	}
       POOL_DEBUG(SOLV_DEBUG_STATS, "cycle edge creation took %d ms\n", solv_timems(now));
     }
@@ -1150,11 +1541,11 @@ transaction_order(Transaction *trans, int flags)
 	i = queue_shift(&uninstq);
       else if (samerepoq.count)
 	{
-	  if (lastte && incycle && incycle[lastte])
+	  if (lastte && (sccs ? sccs[lastte] != 0 : incycle && incycle[lastte]))
 	    {
 	      /* last installed package was in a cycle, prefer packages from the same cycle */
 	      for (j = 0; j < samerepoq.count; j++)
-		if (incycle[samerepoq.elements[j]] && share_cycle(&od, lastte, samerepoq.elements[j]))
+		if (sccs ? sccs[samerepoq.elements[j]] == sccs[lastte] : incycle[samerepoq.elements[j]] && share_cycle(&od, lastte, samerepoq.elements[j]))
 		  {
 		    /* yes, bring to front! */
 		    i = samerepoq.elements[j];
@@ -1224,6 +1615,8 @@ printf("free %s [%d]\n", pool_solvid2str(pool, te2->p), temedianr[od.invedgedata
     }
   solv_free(temedianr);
   solv_free(incycle);
+  solv_free(sccs);
+  solv_free(hardsccs);
   queue_free(&todo);
   queue_free(&samerepoq);
   queue_free(&uninstq);
@@ -1236,7 +1629,8 @@ printf("free %s [%d]\n", pool_solvid2str(pool, te2->p), temedianr[od.invedgedata
   assert(tr->count == oldcount);
 
   POOL_DEBUG(SOLV_DEBUG_STATS, "creating new transaction took %d ms\n", solv_timems(now));
-  POOL_DEBUG(SOLV_DEBUG_STATS, "transaction ordering took %d ms\n", solv_timems(start));
+  trans->stats_ordertime = solv_timems(start);
+  POOL_DEBUG(SOLV_DEBUG_STATS, "transaction ordering took %d ms\n", trans->stats_ordertime);
 
   if ((flags & (SOLVER_TRANSACTION_KEEP_ORDERDATA | SOLVER_TRANSACTION_KEEP_ORDERCYCLES | SOLVER_TRANSACTION_KEEP_ORDEREDGES)) != 0)
     {
@@ -23,6 +23,7 @@
 #include "repo.h"
 #include "poolid.h"
 #include "poolarch.h"
+#include "pool_private.h"
 #include "util.h"
 #include "bitmap.h"
 #include "evr.h"
@@ -56,6 +57,9 @@ pool_create(void)
   queue_init(&pool->vendormap);
   queue_init(&pool->pooljobs);
   queue_init(&pool->lazywhatprovidesq);
+  pool->evrcache = solv_calloc(EVRCACHE_SIZE * 4, sizeof(Id));
+  pool->pagecache = solv_calloc(1, sizeof(Repopagecache));
+  pool->pagecache->maxpages = REPOPAGECACHE_DEFAULT_SIZE / REPOPAGE_BLOBSIZE;
 
 #if defined(DEBIAN)
   pool->disttype = DISTTYPE_DEB;
@@ -99,6 +103,7 @@ pool_free(Pool *pool)
 {
   int i;
 
+  pool_unfreeze(pool);
   pool_freewhatprovides(pool);
   pool_freeidhashes(pool);
   pool_freeallrepos(pool, 1);
@@ -117,6 +122,8 @@ pool_free(Pool *pool)
   solv_free(pool->errstr);
   solv_free(pool->rootdir);
   solv_free(pool->nonstd_ids);
+  solv_free(pool->evrcache);
+  solv_free(pool->pagecache);
   solv_free(pool);
 }
 
@@ -162,6 +169,8 @@ pool_setdisttype(Pool *pool, int disttype)
     }
   pool->disttype = disttype;
   pool->solvables[SYSTEMSOLVABLE].arch = pool->noarchid;
+  if (disttype != olddisttype)
+    pool_clear_evrcache(pool);
   return olddisttype;
 #else
   return pool->disttype == disttype ? disttype : -1;
@@ -197,6 +206,45 @@ pool_get_flag(Pool *pool, int flag)
       return pool->nowhatprovidesaux;
     case POOL_FLAG_WHATPROVIDESWITHDISABLED:
       return pool->whatprovideswithdisabled;
+    case POOL_FLAG_INCREMENTALWHATPROVIDES:
+      return pool->incrementalwhatprovides;
+    default:
+      break;
+    }
+  return -1;
+}
+
+int
+pool_get_stat(Pool *pool, int stat)
+{
+  switch (stat)
+    {
+    case POOL_STAT_WHATPROVIDES_TIME:
+      return pool->stats_whatprovidestime;
+    case POOL_STAT_ADDFILEPROVIDES_TIME:
+      return pool->stats_addfileprovidestime;
+    case POOL_STAT_ADD_SOLV_TIME:
+      return pool->stats_addsolvtime;
+    case POOL_STAT_SOLVABLES:
+      return pool->nsolvables;
+    case POOL_STAT_STRINGS:
+      return pool->ss.nstrings;
+    case POOL_STAT_RELS:
+      return pool->nrels;
+    case POOL_STAT_WHATPROVIDES_MEMORY:
+      if (!pool->whatprovides)
+	return 0;
+      return (int)(((pool->ss.nstrings + pool->nrels) * sizeof(Offset) + pool->whatprovidesdataoff * sizeof(Id) + pool->whatprovidesauxoff * sizeof(Offset) + pool->whatprovidesauxdataoff * sizeof(Id)) / 1024);
+    case POOL_STAT_MAXRSS:
+      return solv_maxrss();
+    case POOL_STAT_PAGECACHE_HITS:
+      return pool->pagecache->hits > 0x7fffffff ? 0x7fffffff : (int)pool->pagecache->hits;
+    case POOL_STAT_PAGECACHE_MISSES:
+      return pool->pagecache->misses > 0x7fffffff ? 0x7fffffff : (int)pool->pagecache->misses;
+    case POOL_STAT_PAGECACHE_EVICTIONS:
+      return pool->pagecache->evictions > 0x7fffffff ? 0x7fffffff : (int)pool->pagecache->evictions;
+    case POOL_STAT_PAGECACHE_MEMORY:
+      return (int)(pool->pagecache->npages * (REPOPAGE_BLOBSIZE / 1024));
     default:
       break;
     }
@@ -211,6 +259,7 @@ pool_set_flag(Pool *pool, int flag, int value)
     {
     case POOL_FLAG_PROMOTEEPOCH:
       pool->promoteepoch = value;
+      pool_clear_evrcache(pool);
       break;
     case POOL_FLAG_FORBIDSELFCONFLICTS:
       pool->forbidselfconflicts = value;
@@ -232,6 +281,7 @@ pool_set_flag(Pool *pool, int flag, int value)
       break;
     case POOL_FLAG_HAVEDISTEPOCH:
       pool->havedistepoch = value;
+      pool_clear_evrcache(pool);
       break;
     case POOL_FLAG_NOOBSOLETESMULTIVERSION:
       pool->noobsoletesmultiversion = value;
@@ -245,6 +295,9 @@ pool_set_flag(Pool *pool, int flag, int value)
     case POOL_FLAG_WHATPROVIDESWITHDISABLED:
       pool->whatprovideswithdisabled = value;
       break;
+    case POOL_FLAG_INCREMENTALWHATPROVIDES:
+      pool->incrementalwhatprovides = value;
+      break;
     default:
       break;
     }
@@ -279,6 +332,8 @@ pool_free_solvable_block(Pool *pool, Id start, int count, int reuseids)
 {
   if (!count)
     return;
+  if (pool->incrementalwhatprovides)
+    pool_invalidatewhatprovides(pool, start, start + count);
   if (reuseids && start + count == pool->nsolvables)
     {
       /* might want to shrink solvable array */
@@ -293,8 +348,11 @@ pool_set_installed(Pool *pool, Repo *installed)
 {
   if (pool->installed == installed)
     return;
+  if (pool->installed)
+    pool_invalidatewhatprovides(pool, pool->installed->start, pool->installed->end);
+  if (installed)
+    pool_invalidatewhatprovides(pool, installed->start, installed->end);
   pool->installed = installed;
-  pool_freewhatprovides(pool);
 }
 
 void
@@ -423,24 +481,25 @@ pool_search(Pool *pool, Id p, Id key, const char *match, int flags, int (*callba
 void
 pool_clear_pos(Pool *pool)
 {
-  memset(&pool->pos, 0, sizeof(pool->pos));
+  memset(pool_pos(pool), 0, sizeof(Datapos));
 }
 
 char *
 pool_alloctmpspace(Pool *pool, int len)
 {
-  int n = pool->tmpspace.n;
+  struct s_Pool_tmpspace *ts = pool_tmpspace(pool);
+  int n = ts->n;
   if (len <= 0)
     return 0;
   if (len >= POOL_MAX_TMPSPACE_LEN)
     solv_ovfl("tmpspace size overflow");
-  if (len > pool->tmpspace.len[n])
+  if (len > ts->len[n])
     {
-      pool->tmpspace.buf[n] = solv_realloc(pool->tmpspace.buf[n], len + 32);
-      pool->tmpspace.len[n] = len + 32;
+      ts->buf[n] = solv_realloc(ts->buf[n], len + 32);
+      ts->len[n] = len + 32;
     }
-  pool->tmpspace.n = (n + 1) % POOL_TMPSPACEBUF;
-  return pool->tmpspace.buf[n];
+  ts->n = (n + 1) % POOL_TMPSPACEBUF;
+  return ts->buf[n];
 }
 
 static char *
@@ -448,22 +507,23 @@ pool_alloctmpspace_free(Pool *pool, const char *space, int len)
 {
   if (space)
     {
+      struct s_Pool_tmpspace *ts = pool_tmpspace(pool);
       int n, oldn;
-      n = oldn = pool->tmpspace.n;
+      n = oldn = ts->n;
       for (;;)
 	{
 	  if (!n--)
 	    n = POOL_TMPSPACEBUF - 1;
 	  if (n == oldn)
 	    break;
-	  if (pool->tmpspace.buf[n] != space)
+	  if (ts->buf[n] != space)
 	    continue;
-	  if (len > pool->tmpspace.len[n])
+	  if (len > ts->len[n])
 	    {
-	      pool->tmpspace.buf[n] = solv_realloc(pool->tmpspace.buf[n], len + 32);
-	      pool->tmpspace.len[n] = len + 32;
+	      ts->buf[n] = solv_realloc(ts->buf[n], len + 32);
+	      ts->len[n] = len + 32;
 	    }
-          return pool->tmpspace.buf[n];
+          return ts->buf[n];
 	}
     }
   return 0;
@@ -472,12 +532,13 @@ pool_alloctmpspace_free(Pool *pool, const char *space, int len)
 void
 pool_freetmpspace(Pool *pool, const char *space)
 {
-  int n = pool->tmpspace.n;
+  struct s_Pool_tmpspace *ts = pool_tmpspace(pool);
+  int n = ts->n;
   if (!space)
     return;
   n = (n + (POOL_TMPSPACEBUF - 1)) % POOL_TMPSPACEBUF;
-  if (pool->tmpspace.buf[n] == space)
-    pool->tmpspace.n = n;
+  if (ts->buf[n] == space)
+    ts->n = n;
 }
 
 char *
@@ -563,8 +624,12 @@ pool_bin2hex(Pool *pool, const unsigned char *buf, int len)
 const char *
 pool_lookup_str(Pool *pool, Id entry, Id keyname)
 {
-  if (entry == SOLVID_POS && pool->pos.repo)
-    return repo_lookup_str(pool->pos.repo, pool->pos.repodataid ? entry : pool->pos.solvid, keyname);
+  if (entry == SOLVID_POS)
+    {
+      Datapos *pos = pool_pos(pool);
+      if (pos->repo)
+	return repo_lookup_str(pos->repo, pos->repodataid ? entry : pos->solvid, keyname);
+    }
   if (entry <= 0)
     return 0;
   return solvable_lookup_str(pool->solvables + entry, keyname);
@@ -573,8 +638,12 @@ pool_lookup_str(Pool *pool, Id entry, Id keyname)
 Id
 pool_lookup_id(Pool *pool, Id entry, Id keyname)
 {
-  if (entry == SOLVID_POS && pool->pos.repo)
-    return repo_lookup_id(pool->pos.repo, pool->pos.repodataid ? entry : pool->pos.solvid, keyname);
+  if (entry == SOLVID_POS)
+    {
+      Datapos *pos = pool_pos(pool);
+      if (pos->repo)
+	return repo_lookup_id(pos->repo, pos->repodataid ? entry : pos->solvid, keyname);
+    }
   if (entry <= 0)
     return 0;
   return solvable_lookup_id(pool->solvables + entry, keyname);
@@ -583,8 +652,12 @@ pool_lookup_id(Pool *pool, Id entry, Id keyname)
 unsigned long long
 pool_lookup_num(Pool *pool, Id entry, Id keyname, unsigned long long notfound)
 {
-  if (entry == SOLVID_POS && pool->pos.repo)
-    return repo_lookup_num(pool->pos.repo, pool->pos.repodataid ? entry : pool->pos.solvid, keyname, notfound);
+  if (entry == SOLVID_POS)
+    {
+      Datapos *pos = pool_pos(pool);
+      if (pos->repo)
+	return repo_lookup_num(pos->repo, pos->repodataid ? entry : pos->solvid, keyname, notfound);
+    }
   if (entry <= 0)
     return notfound;
   return solvable_lookup_num(pool->solvables + entry, keyname, notfound);
@@ -593,8 +666,12 @@ pool_lookup_num(Pool *pool, Id entry, Id keyname, unsigned long long notfound)
 int
 pool_lookup_void(Pool *pool, Id entry, Id keyname)
 {
-  if (entry == SOLVID_POS && pool->pos.repo)
-    return repo_lookup_void(pool->pos.repo, pool->pos.repodataid ? entry : pool->pos.solvid, keyname);
+  if (entry == SOLVID_POS)
+    {
+      Datapos *pos = pool_pos(pool);
+      if (pos->repo)
+	return repo_lookup_void(pos->repo, pos->repodataid ? entry : pos->solvid, keyname);
+    }
   if (entry <= 0)
     return 0;
   return solvable_lookup_void(pool->solvables + entry, keyname);
@@ -603,8 +680,12 @@ pool_lookup_void(Pool *pool, Id entry, Id keyname)
 const unsigned char *
 pool_lookup_bin_checksum(Pool *pool, Id entry, Id keyname, Id *typep)
 {
-  if (entry == SOLVID_POS && pool->pos.repo)
-    return repo_lookup_bin_checksum(pool->pos.repo, pool->pos.repodataid ? entry : pool->pos.solvid, keyname, typep);
+  if (entry == SOLVID_POS)
+    {
+      Datapos *pos = pool_pos(pool);
+      if (pos->repo)
+	return repo_lookup_bin_checksum(pos->repo, pos->repodataid ? entry : pos->solvid, keyname, typep);
+    }
   if (entry <= 0)
     return 0;
   return solvable_lookup_bin_checksum(pool->solvables + entry, keyname, typep);
@@ -613,8 +694,12 @@ pool_lookup_bin_checksum(Pool *pool, Id entry, Id keyname, Id *typep)
 const char *
 pool_lookup_checksum(Pool *pool, Id entry, Id keyname, Id *typep)
 {
-  if (entry == SOLVID_POS && pool->pos.repo)
-    return repo_lookup_checksum(pool->pos.repo, pool->pos.repodataid ? entry : pool->pos.solvid, keyname, typep);
+  if (entry == SOLVID_POS)
+    {
+      Datapos *pos = pool_pos(pool);
+      if (pos->repo)
+	return repo_lookup_checksum(pos->repo, pos->repodataid ? entry : pos->solvid, keyname, typep);
+    }
   if (entry <= 0)
     return 0;
   return solvable_lookup_checksum(pool->solvables + entry, keyname, typep);
@@ -623,8 +708,12 @@ pool_lookup_checksum(Pool *pool, Id entry, Id keyname, Id *typep)
 int
 pool_lookup_idarray(Pool *pool, Id entry, Id keyname, Queue *q)
 {
-  if (entry == SOLVID_POS && pool->pos.repo)
-    return repo_lookup_idarray(pool->pos.repo, pool->pos.repodataid ? entry : pool->pos.solvid, keyname, q);
+  if (entry == SOLVID_POS)
+    {
+      Datapos *pos = pool_pos(pool);
+      if (pos->repo)
+	return repo_lookup_idarray(pos->repo, pos->repodataid ? entry : pos->solvid, keyname, q);
+    }
   if (entry <= 0)
     return 0;
   return solvable_lookup_idarray(pool->solvables + entry, keyname, q);
@@ -711,6 +800,14 @@ pool_get_rootdir(Pool *pool)
   return pool->rootdir;
 }
 
+/* set the memory budget of the repodata page cache. The stores
+ * do not shrink, so a smaller budget only stops them from growing */
+void
+pool_set_pagecache_size(Pool *pool, unsigned int size)
+{
+  pool->pagecache->maxpages = size / REPOPAGE_BLOBSIZE;
+}
+
 /* only used in libzypp */
 void
 pool_set_custom_vendorcheck(Pool *pool, int (*vendorcheck)(Pool *, Solvable *, Solvable *))
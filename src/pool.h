@@ -166,6 +166,25 @@ struct s_Pool {
   int nonstd_nids;
 
   int whatprovideswithdisabled;
+
+  int incrementalwhatprovides;	/* keep the whatprovides index on repo changes and update it */
+  Id whatprovidesdirtystart;	/* solvable range with outdated whatprovides entries */
+  Id whatprovidesdirtyend;
+  int whatprovidesnsolvables;	/* number of solvables/strings/rels when the index was last updated */
+  int whatprovidesnstrings;
+  int whatprovidesnrels;
+  Offset whatprovidesbuildoff;	/* whatprovidesdataoff after the last full build */
+
+  Id *evrcache;			/* memoized pool_evrcmp results */
+
+  int frozen;			/* true: pool_freeze() was called */
+  struct s_Pool_frozen *frozendata;	/* lock and per-thread data of a frozen pool */
+
+  struct s_Repopagecache *pagecache;	/* budget and statistics of the repodata pages */
+
+  int stats_whatprovidestime;	/* statistic, times in ms */
+  int stats_addfileprovidestime;
+  int stats_addsolvtime;	/* summed up over all repo_add_solv calls */
 #endif
 };
 
@@ -206,6 +225,20 @@ struct s_Pool {
 #define POOL_FLAG_IMPLICITOBSOLETEUSESCOLORS		10
 #define POOL_FLAG_NOWHATPROVIDESAUX			11
 #define POOL_FLAG_WHATPROVIDESWITHDISABLED		12
+#define POOL_FLAG_INCREMENTALWHATPROVIDES		13
+
+#define POOL_STAT_WHATPROVIDES_TIME			1
+#define POOL_STAT_ADDFILEPROVIDES_TIME			2
+#define POOL_STAT_ADD_SOLV_TIME				3
+#define POOL_STAT_SOLVABLES				4
+#define POOL_STAT_STRINGS				5
+#define POOL_STAT_RELS					6
+#define POOL_STAT_WHATPROVIDES_MEMORY			7
+#define POOL_STAT_MAXRSS				8
+#define POOL_STAT_PAGECACHE_HITS			9
+#define POOL_STAT_PAGECACHE_MISSES			10
+#define POOL_STAT_PAGECACHE_EVICTIONS			11
+#define POOL_STAT_PAGECACHE_MEMORY			12
 
 /* ----------------------------------------------- */
 
@@ -249,6 +282,7 @@ extern void pool_setdebuglevel(Pool *pool, int level);
 extern int  pool_setdisttype(Pool *pool, int disttype);
 extern int  pool_set_flag(Pool *pool, int flag, int value);
 extern int  pool_get_flag(Pool *pool, int flag);
+extern int  pool_get_stat(Pool *pool, int stat);
 
 extern void pool_debug(Pool *pool, int type, const char *format, ...) __attribute__((format(printf, 3, 4)));
 extern void pool_setdebugcallback(Pool *pool, void (*debugcallback)(Pool *pool, void *data, int type, const char *str), void *debugcallbackdata);
@@ -276,6 +310,8 @@ extern const char *pool_get_rootdir(Pool *pool);
 extern char *pool_prepend_rootdir(Pool *pool, const char *dir);
 extern const char *pool_prepend_rootdir_tmp(Pool *pool, const char *dir);
 
+extern void pool_set_pagecache_size(Pool *pool, unsigned int size);
+
 /**
  * Solvable management
  */
@@ -326,11 +362,19 @@ extern void pool_createwhatprovides(Pool *pool);
 extern void pool_addfileprovides(Pool *pool);
 extern void pool_addfileprovides_queue(Pool *pool, Queue *idq, Queue *idqinst);
 extern void pool_freewhatprovides(Pool *pool);
+extern void pool_invalidatewhatprovides(Pool *pool, Id start, Id end);
+extern void pool_freeze(Pool *pool);
+extern void pool_unfreeze(Pool *pool);
+extern int pool_checkwhatprovides(Pool *pool);
+extern void pool_calc_whatprovides_cookie(Pool *pool, unsigned char *cookie);
+extern int pool_write_whatprovides(Pool *pool, FILE *fp);
+extern int pool_read_whatprovides(Pool *pool, FILE *fp);
 extern Id pool_queuetowhatprovides(Pool *pool, Queue *q);
 extern Id pool_ids2whatprovides(Pool *pool, Id *ids, int count);
 extern Id pool_searchlazywhatprovidesq(Pool *pool, Id d);
 
 extern Id pool_addrelproviders(Pool *pool, Id d);
+extern void pool_addallproviders(Pool *pool);
 
 static inline Id pool_whatprovides(Pool *pool, Id d)
 {
@@ -370,6 +414,7 @@ void pool_add_new_provider(Pool *pool, Id id, Id p);
 void pool_search(Pool *pool, Id p, Id key, const char *match, int flags, int (*callback)(void *cbdata, Solvable *s, Repodata *data, struct s_Repokey *key, struct s_KeyValue *kv), void *cbdata);
 
 void pool_clear_pos(Pool *pool);
+Datapos *pool_get_pos(Pool *pool);
 
 /* lookup functions */
 const char *pool_lookup_str(Pool *pool, Id entry, Id keyname);
@@ -18,4 +18,58 @@
 
 Id *pool_lookup_languagecache_row(Pool *pool, Id keyname);
 
+/* number of entries in the pool_evrcmp result cache, must be a power of two */
+#define EVRCACHE_SIZE		2048
+
+void pool_clear_evrcache(Pool *pool);
+
+int pool_islazyfileprovides(Pool *pool, Id id);
+
+/* frozen pools, see poolfreeze.c */
+struct s_Pool_threaddata {
+  struct s_Pool_tmpspace tmpspace;
+  Datapos pos;
+  Id *evrcache;
+  struct s_Pool_frozen *frozendata;
+  struct s_Pool_threaddata *next;
+};
+
+struct s_Pool_threaddata *pool_frozen_threaddata(const Pool *pool);
+void pool_frozen_lock(Pool *pool);
+void pool_frozen_unlock(Pool *pool);
+void pool_frozen_extend_whatprovidesdata(Pool *pool, int count);
+void pool_frozen_set_whatprovidesdata(Pool *pool, Offset off, Id *ids, int count);
+Offset pool_frozen_get_block(Pool *pool, int *sizep);
+void pool_frozen_put_blocks(Pool *pool, Queue *blocks);
+
+static inline struct s_Pool_tmpspace *
+pool_tmpspace(Pool *pool)
+{
+#ifdef ENABLE_THREADSAFE_POOL
+  if (pool->frozen)
+    return &pool_frozen_threaddata(pool)->tmpspace;
+#endif
+  return &pool->tmpspace;
+}
+
+static inline Datapos *
+pool_pos(Pool *pool)
+{
+#ifdef ENABLE_THREADSAFE_POOL
+  if (pool->frozen)
+    return &pool_frozen_threaddata(pool)->pos;
+#endif
+  return &pool->pos;
+}
+
+static inline Id *
+pool_evrcache(const Pool *pool)
+{
+#ifdef ENABLE_THREADSAFE_POOL
+  if (pool->frozen)
+    return pool_frozen_threaddata(pool)->evrcache;
+#endif
+  return pool->evrcache;
+}
+
 #endif /* LIBSOLV_POOL_PRIVATE_H */
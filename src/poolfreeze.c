@@ -0,0 +1,405 @@
+/*
+ * Copyright (c) 2026, SUSE LLC
+ *
+ * This program is licensed under the BSD license, read LICENSE.BSD
+ * for further information
+ */
+
+/*
+ * poolfreeze.c
+ *
+ * freeze a pool so that it can be used by multiple solvers
+ * running in different threads
+ *
+ * Freezing does all the work that would otherwise be done lazily
+ * when the pool gets accessed: the repodata stubs and pages get
+ * loaded, the id hashes get created, and the providers of all
+ * strings and relations get calculated.
+ *
+ * The solvers of a frozen pool put their provider lists into blocks
+ * of the whatprovidesdata area, the blocks get reused when the solver
+ * is freed.
+ *
+ * If libsolv is built with ENABLE_THREADSAFE_POOL, the tmp space,
+ * the search position and the evr compare cache are kept per thread
+ * while the pool is frozen. The block allocation is serialized by a
+ * lock. The whatprovidesdata area is moved into reserved address space
+ * that covers the biggest possible area, so that it never moves while
+ * other threads read it.
+ * If the address space cannot be reserved, the area gets a reserve
+ * instead. When it is used up, the area is copied under the lock and
+ * the old area is kept until the pool gets unfrozen. In that case the
+ * provider lists are also written under the lock.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef ENABLE_THREADSAFE_POOL
+#include <pthread.h>
+#include <sys/mman.h>
+#endif
+
+#include "pool.h"
+#include "pool_private.h"
+#include "poolid.h"
+#include "repo.h"
+#include "util.h"
+#ifdef ENABLE_LINKED_PKGS
+#include "linkedpkg.h"
+#endif
+
+/* size of the whatprovidesdata blocks handed out to the solvers */
+#define FROZEN_BLOCKSIZE	8192
+
+/* number of whatprovidesdata elements reserved when freezing or
+ * when the reserve is used up: a quarter of the used area, but
+ * at least 16 blocks */
+#define FROZEN_RESERVE(off)	((off) / 4 + 16 * FROZEN_BLOCKSIZE)
+
+struct s_Pool_frozen {
+  Queue freeblocks;		/* (offset, size) pairs of unused blocks */
+#ifdef ENABLE_THREADSAFE_POOL
+  pthread_mutex_t lock;		/* recursive, protects the lazy whatprovides data */
+  pthread_key_t key;		/* -> s_Pool_threaddata */
+  struct s_Pool_threaddata *threaddata;	/* all thread data blocks */
+  Id **oldwhatprovidesdata;	/* replaced whatprovidesdata areas */
+  int noldwhatprovidesdata;
+  Id *mapped;			/* reserved address space for whatprovidesdata */
+  size_t mappedn;		/* its size in elements */
+#endif
+};
+
+#if defined(ENABLE_THREADSAFE_POOL) && !defined(MAP_NORESERVE)
+#define MAP_NORESERVE 0
+#endif
+
+#ifdef ENABLE_THREADSAFE_POOL
+
+static void
+threaddata_free(struct s_Pool_threaddata *td)
+{
+  int i;
+  for (i = 0; i < POOL_TMPSPACEBUF; i++)
+    solv_free(td->tmpspace.buf[i]);
+  solv_free(td->evrcache);
+  solv_free(td);
+}
+
+/* called when a thread exits */
+static void
+threaddata_destructor(void *data)
+{
+  struct s_Pool_threaddata *td = data, **tdp;
+  struct s_Pool_frozen *fd = td->frozendata;
+
+  pthread_mutex_lock(&fd->lock);
+  for (tdp = &fd->threaddata; *tdp; tdp = &(*tdp)->next)
+    if (*tdp == td)
+      {
+	*tdp = td->next;
+	break;
+      }
+  pthread_mutex_unlock(&fd->lock);
+  threaddata_free(td);
+}
+
+struct s_Pool_threaddata *
+pool_frozen_threaddata(const Pool *pool)
+{
+  struct s_Pool_frozen *fd = pool->frozendata;
+  struct s_Pool_threaddata *td = pthread_getspecific(fd->key);
+
+  if (td)
+    return td;
+  td = solv_calloc(1, sizeof(*td));
+  td->frozendata = fd;
+  if (pool->evrcache)
+    td->evrcache = solv_calloc(EVRCACHE_SIZE * 4, sizeof(Id));
+  pthread_mutex_lock(&fd->lock);
+  td->next = fd->threaddata;
+  fd->threaddata = td;
+  pthread_mutex_unlock(&fd->lock);
+  if (pthread_setspecific(fd->key, td))
+    solv_oom(1, sizeof(*td));
+  return td;
+}
+
+void
+pool_frozen_lock(Pool *pool)
+{
+  pthread_mutex_lock(&pool->frozendata->lock);
+}
+
+void
+pool_frozen_unlock(Pool *pool)
+{
+  pthread_mutex_unlock(&pool->frozendata->lock);
+}
+
+/* reserve the address space for the biggest possible whatprovidesdata
+ * area and move the area there. Pages only get allocated when they
+ * are used. */
+static void
+frozen_map_whatprovidesdata(Pool *pool, struct s_Pool_frozen *fd)
+{
+  size_t n = SOLV_MAX_INDEX;
+  Id *data;
+
+  if (sizeof(size_t) <= 4)
+    return;		/* not enough address space */
+  data = mmap(0, n * sizeof(Id), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (data == MAP_FAILED)
+    return;
+  memcpy(data, pool->whatprovidesdata, pool->whatprovidesdataoff * sizeof(Id));
+  solv_free(pool->whatprovidesdata);
+  pool->whatprovidesdata = data;
+  pool->whatprovidesdataleft = n - pool->whatprovidesdataoff;
+  fd->mapped = data;
+  fd->mappedn = n;
+}
+
+static void
+frozen_unmap_whatprovidesdata(Pool *pool, struct s_Pool_frozen *fd)
+{
+  Id *data = solv_malloc2(pool->whatprovidesdataoff + 4096, sizeof(Id));
+  memcpy(data, fd->mapped, pool->whatprovidesdataoff * sizeof(Id));
+  munmap(fd->mapped, fd->mappedn * sizeof(Id));
+  pool->whatprovidesdata = data;
+  pool->whatprovidesdataleft = 4096;
+}
+
+/* the reserve is used up. Other threads may still look at the old
+ * area, so we must not realloc it. Copy it instead and free the old
+ * area when the pool gets unfrozen. */
+void
+pool_frozen_extend_whatprovidesdata(Pool *pool, int count)
+{
+  struct s_Pool_frozen *fd = pool->frozendata;
+  Id *data;
+
+  if (fd->mapped)
+    solv_ovfl("pool whatprovides data overflow");	/* the whole index range is mapped */
+  POOL_DEBUG(SOLV_DEBUG_STATS, "whatprovidesdata reserve of the frozen pool is used up\n");
+  data = solv_calloc(pool->whatprovidesdataoff + count, sizeof(Id));
+  memcpy(data, pool->whatprovidesdata, pool->whatprovidesdataoff * sizeof(Id));
+  fd->oldwhatprovidesdata = solv_extend(fd->oldwhatprovidesdata, fd->noldwhatprovidesdata, 1, sizeof(Id *), 7);
+  fd->oldwhatprovidesdata[fd->noldwhatprovidesdata++] = pool->whatprovidesdata;
+  pool->whatprovidesdata = data;
+  pool->whatprovidesdataleft = count;
+}
+
+/* write a provider list into a block. If the area can be copied by
+ * another thread, this must be done under the lock */
+void
+pool_frozen_set_whatprovidesdata(Pool *pool, Offset off, Id *ids, int count)
+{
+  struct s_Pool_frozen *fd = pool->frozendata;
+
+  if (!fd->mapped)
+    pthread_mutex_lock(&fd->lock);
+  memcpy(pool->whatprovidesdata + off, ids, count * sizeof(Id));
+  pool->whatprovidesdata[off + count] = 0;
+  if (!fd->mapped)
+    pthread_mutex_unlock(&fd->lock);
+}
+
+#else
+
+void
+pool_frozen_lock(Pool *pool)
+{
+}
+
+void
+pool_frozen_unlock(Pool *pool)
+{
+}
+
+void
+pool_frozen_extend_whatprovidesdata(Pool *pool, int count)
+{
+  pool->whatprovidesdata = solv_realloc2(pool->whatprovidesdata, pool->whatprovidesdataoff + count, sizeof(Id));
+  pool->whatprovidesdataleft = count;
+}
+
+void
+pool_frozen_set_whatprovidesdata(Pool *pool, Offset off, Id *ids, int count)
+{
+  memcpy(pool->whatprovidesdata + off, ids, count * sizeof(Id));
+  pool->whatprovidesdata[off + count] = 0;
+}
+
+#endif
+
+/* get a block of at least *sizep elements, returns the offset */
+Offset
+pool_frozen_get_block(Pool *pool, int *sizep)
+{
+  struct s_Pool_frozen *fd = pool->frozendata;
+  Queue *q = &fd->freeblocks;
+  Offset off;
+  int i;
+
+  pool_frozen_lock(pool);
+  for (i = 0; i < q->count; i += 2)
+    if (q->elements[i + 1] >= *sizep)
+      {
+	off = q->elements[i];
+	*sizep = q->elements[i + 1];
+	queue_deleten(q, i, 2);
+	pool_frozen_unlock(pool);
+	return off;
+      }
+  if (*sizep < FROZEN_BLOCKSIZE)
+    *sizep = FROZEN_BLOCKSIZE;
+  if (pool->whatprovidesdataleft < *sizep)
+    {
+      int reserve = FROZEN_RESERVE(pool->whatprovidesdataoff);
+      if ((unsigned int)(SOLV_MAX_INDEX - pool->whatprovidesdataoff) < (unsigned int)*sizep + reserve)
+	solv_ovfl("pool whatprovides data overflow");
+      pool_frozen_extend_whatprovidesdata(pool, *sizep + reserve);
+    }
+  off = pool->whatprovidesdataoff;
+  pool->whatprovidesdataoff += *sizep;
+  pool->whatprovidesdataleft -= *sizep;
+  pool_frozen_unlock(pool);
+  return off;
+}
+
+/* give back the blocks of a solver */
+void
+pool_frozen_put_blocks(Pool *pool, Queue *blocks)
+{
+  pool_frozen_lock(pool);
+  queue_insertn(&pool->frozendata->freeblocks, pool->frozendata->freeblocks.count, blocks->count, blocks->elements);
+  pool_frozen_unlock(pool);
+}
+
+static void
+pool_freeze_languages(Pool *pool)
+{
+  static Id keys[] = { SOLVABLE_SUMMARY, SOLVABLE_DESCRIPTION, SOLVABLE_EULA, 0 };
+  Id *row;
+  int i, j;
+
+  if (!pool->nlanguages)
+    return;
+  for (i = 0; keys[i]; i++)
+    {
+      row = pool_lookup_languagecache_row(pool, keys[i]);
+      for (j = 0; j < pool->nlanguages; j++)
+	if (!row[j])
+	  row[j] = pool_id2langid(pool, keys[i], pool->languages[j], 1);
+    }
+}
+
+/*
+ * freeze the pool: do all the lazy initialization now so that
+ * multiple solvers can work on the pool at the same time. The pool
+ * must not be modified until pool_unfreeze() is called.
+ */
+void
+pool_freeze(Pool *pool)
+{
+  struct s_Pool_frozen *fd;
+  Repo *repo;
+  Id repoid;
+  int now = solv_timems(0);
+
+  if (pool->frozen)
+    return;
+  /* load all stubs and pages */
+  FOR_REPOS(repoid, repo)
+    repo_disable_paging(repo);
+#ifdef ENABLE_LINKED_PKGS
+  /* finding the product links may create new ids */
+  {
+    Queue q;
+    Solvable *s;
+    Id id;
+
+    queue_init(&q);
+    FOR_POOL_SOLVABLES(id)
+      {
+	s = pool->solvables + id;
+	if (has_package_link(pool, s))
+	  {
+	    find_package_link(pool, s, 0, &q, 0, 0);
+	    queue_empty(&q);
+	  }
+      }
+    queue_free(&q);
+  }
+#endif
+  pool_freeze_languages(pool);
+  pool_addallproviders(pool);
+  pool_createidhashes(pool);
+
+  fd = solv_calloc(1, sizeof(*fd));
+  queue_init(&fd->freeblocks);
+#ifdef ENABLE_THREADSAFE_POOL
+  {
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&fd->lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+    if (pthread_key_create(&fd->key, threaddata_destructor))
+      solv_oom(1, sizeof(pthread_key_t));
+  }
+  /* the area must not move while the pool is frozen */
+  frozen_map_whatprovidesdata(pool, fd);
+  if (!fd->mapped)
+    {
+      /* moving it means copying, so reserve some space */
+      int reserve = FROZEN_RESERVE(pool->whatprovidesdataoff);
+      if (pool->whatprovidesdataleft < reserve && (unsigned int)(SOLV_MAX_INDEX - pool->whatprovidesdataoff) > (unsigned int)reserve)
+	{
+	  pool->whatprovidesdata = solv_realloc2(pool->whatprovidesdata, pool->whatprovidesdataoff + reserve, sizeof(Id));
+	  pool->whatprovidesdataleft = reserve;
+	}
+    }
+#endif
+  pool->frozendata = fd;
+  pool->frozen = 1;
+  POOL_DEBUG(SOLV_DEBUG_STATS, "pool_freeze took %d ms\n", solv_timems(now));
+}
+
+/* all solvers created while the pool was frozen must be freed before */
+void
+pool_unfreeze(Pool *pool)
+{
+  struct s_Pool_frozen *fd = pool->frozendata;
+
+  if (!pool->frozen)
+    return;
+#ifdef ENABLE_THREADSAFE_POOL
+  {
+    struct s_Pool_threaddata *td, *tdn;
+    int i;
+
+    pthread_key_delete(fd->key);
+    for (td = fd->threaddata; td; td = tdn)
+      {
+	tdn = td->next;
+	threaddata_free(td);
+      }
+    for (i = 0; i < fd->noldwhatprovidesdata; i++)
+      solv_free(fd->oldwhatprovidesdata[i]);
+    solv_free(fd->oldwhatprovidesdata);
+    if (fd->mapped)
+      frozen_unmap_whatprovidesdata(pool, fd);
+    pthread_mutex_destroy(&fd->lock);
+  }
+#endif
+  queue_free(&fd->freeblocks);
+  pool->frozendata = solv_free(fd);
+  pool->frozen = 0;
+}
+
+Datapos *
+pool_get_pos(Pool *pool)
+{
+  return pool_pos(pool);
+}
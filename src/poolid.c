@@ -396,4 +396,13 @@ pool_freeidhashes(Pool *pool)
   pool_free_rels_hash(pool);
 }
 
+/* create the hash tables so that id lookups do not modify the pool */
+void
+pool_createidhashes(Pool *pool)
+{
+  stringpool_createhash(&pool->ss);
+  if ((Hashval)pool->nrels * 2 >= pool->relhashmask)
+    pool_resize_rels_hash(pool, REL_BLOCK);
+}
+
 /* EOF */
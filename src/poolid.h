@@ -43,6 +43,7 @@ extern void pool_shrink_rels(Pool *pool);
 extern void pool_freeidhashes(Pool *pool);
 
 extern void pool_resize_rels_hash(Pool *pool, int numnew);	/* internal */
+extern void pool_createidhashes(Pool *pool);			/* internal */
 extern void pool_init_rels(Pool *pool);				/* internal */
 
 #ifdef __cplusplus
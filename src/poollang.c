@@ -70,6 +70,7 @@ pool_id2langid(Pool *pool, Id id, const char *lang, int create)
 /* 
  * The languagecache is used to cache the result of pool_id2langid().
  * It returns space for nlanguages Id elements for a given keyname.
+ * A frozen pool only returns the rows created by pool_freeze().
  */
 Id *
 pool_lookup_languagecache_row(Pool *pool, Id keyname)
@@ -78,6 +79,8 @@ pool_lookup_languagecache_row(Pool *pool, Id keyname)
   Id *row;
   if (!pool->languagecache)
     {
+      if (pool->frozen)
+	return 0;
       pool->languagecache = solv_calloc(ID_NUM_INTERNAL + cols + 1, sizeof(Id));
       pool->languagecache[0] = ID_NUM_INTERNAL;		/* current size */
     }
@@ -95,6 +98,8 @@ pool_lookup_languagecache_row(Pool *pool, Id keyname)
 	if (*row == keyname)
 	  return row + 1;
     }
+  if (pool->frozen)
+    return 0;
   /* we need to add a new row (plus the trailing zero) */
   if (pool->languagecache[0] + cols + 1 >= SOLV_MAX_INDEX)
     solv_ovfl("languagecache size overflow");
@@ -163,13 +163,310 @@ pool_shrink_whatprovidesaux(Pool *pool)
 
 
 /*
- * pool_createwhatprovides()
- *
- * create hashes over pool of solvables to ease provide lookups
+ * check if the provides of a file name are added lazily, i.e. the
+ * filelists are searched on the first lookup. Must match the setup
+ * done in pool_createwhatprovides_full().
+ */
+int
+pool_islazyfileprovides(Pool *pool, Id id)
+{
+  const char *str = pool->ss.stringspace + pool->ss.strings[id];
+  if (str[0] != '/')
+    return 0;
+  if (pool->addedfileprovides == 1)
+    {
+      /* nonstd_ids is sorted */
+      int start = 0, end = pool->nonstd_nids;
+      while (start < end)
+	{
+	  int mid = (start + end) / 2;
+	  if (pool->nonstd_ids[mid] == id)
+	    return 1;
+	  if (pool->nonstd_ids[mid] < id)
+	    start = mid + 1;
+	  else
+	    end = mid;
+	}
+      return 0;
+    }
+  return !pool->addedfileprovides && pool->disttype == DISTTYPE_RPM ? 1 : 0;
+}
+
+/* set/replace the remembered providers of a lazy file provides entry */
+static void
+pool_setlazywhatprovidesq(Pool *pool, Id id, Offset off)
+{
+  Queue *q = &pool->lazywhatprovidesq;
+  int start = 0, end = q->count;
+  while (start < end)
+    {
+      int mid = (start + end) / 2 & ~1;
+      if (q->elements[mid] < id)
+	start = mid + 2;
+      else
+	end = mid;
+    }
+  if (start < q->count && q->elements[start] == id)
+    {
+      if (off > 1)
+	q->elements[start + 1] = off;
+      else
+	queue_deleten(q, start, 2);
+    }
+  else if (off > 1)
+    queue_insert2(q, start, id, off);
+}
+
+static int
+pool_updatewhatprovides_sortcmp(const void *ap, const void *bp, void *dp)
+{
+  const Id *a = ap, *b = bp;
+  if (a[0] != b[0])
+    return a[0] - b[0];
+  return a[1] - b[1];
+}
+
+/*
+ * pool_updatewhatprovides()
  *
+ * incremental version of pool_createwhatprovides: only recreate the
+ * entries of the names that are provided by the changed solvables.
+ * If solvables were just added, only their provides are looked at,
+ * changed or removed solvables need a search of the old provider
+ * lists. The cached relation entries are cleared in one pass over
+ * the relations.
+ * The new lists are appended to whatprovidesdata, so offsets
+ * obtained before stay valid.
+ * returns 0 if a full rebuild should be done instead.
  */
-void
-pool_createwhatprovides(Pool *pool)
+static int
+pool_updatewhatprovides(Pool *pool)
+{
+  Id start = pool->whatprovidesdirtystart;
+  Id end = pool->whatprovidesdirtyend;
+  int oldnum = pool->whatprovidesnstrings;
+  int num = pool->ss.nstrings;
+  int nrels = pool->nrels;
+  Id p, id, *dp, *auxdp;
+  Solvable *s;
+  Queue pq, q, aq;
+  Map affected;
+  int i, j, naffected = 0;
+
+  /* too much garbage from old updates and solver runs, better start over */
+  if (pool->whatprovidesdataoff > 2 * pool->whatprovidesbuildoff + 65536)
+    return 0;
+  if (pool->nsolvables > pool->whatprovidesnsolvables)
+    {
+      /* new solvables were added */
+      if (start == end || pool->whatprovidesnsolvables < start)
+	start = pool->whatprovidesnsolvables;
+      if (start == end || pool->nsolvables > end)
+	end = pool->nsolvables;
+    }
+  if (num < oldnum)
+    return 0;
+
+  /* make room for new ids */
+  pool->whatprovides = solv_extend_resize(pool->whatprovides, num, sizeof(Offset), WHATPROVIDES_BLOCK);
+  pool->whatprovides_rel = solv_extend_resize(pool->whatprovides_rel, nrels, sizeof(Offset), WHATPROVIDES_BLOCK);
+  if (pool->whatprovidesaux)
+    {
+      if ((Offset)num > pool->whatprovidesauxoff)
+	{
+	  pool->whatprovidesaux = solv_realloc2(pool->whatprovidesaux, num, sizeof(Offset));
+	  memset(pool->whatprovidesaux + pool->whatprovidesauxoff, 0, (num - pool->whatprovidesauxoff) * sizeof(Offset));
+	  pool->whatprovidesauxoff = num;
+	}
+      pool->whatprovidesauxdata = solv_extend_resize(pool->whatprovidesauxdata, pool->whatprovidesauxdataoff, sizeof(Id), WHATPROVIDES_BLOCK);
+    }
+
+  map_init(&affected, num + nrels);
+  /* new ids always need an entry */
+  for (id = oldnum; id < num; id++)
+    MAPSET(&affected, id);
+
+  /* collect (name, solvable, provide) triplets of the changed solvables */
+  queue_init(&pq);
+  for (p = start; p < end && p < pool->nsolvables; p++)
+    {
+      s = pool->solvables + p;
+      if (!s->provides || !s->repo || s->repo->disabled)
+	continue;
+      if (!pool_installable_whatprovides(pool, s))
+	continue;
+      dp = s->repo->idarraydata + s->provides;
+      while ((id = *dp++) != 0)
+	{
+	  Id auxid = id;
+	  while (ISRELDEP(id))
+	    {
+	      Reldep *rd = GETRELDEP(pool, id);
+	      id = rd->name;
+	    }
+	  queue_push2(&pq, id, p);
+	  queue_push(&pq, auxid);
+	  MAPSET(&affected, id);
+	}
+    }
+  solv_sort(pq.elements, pq.count / 3, 3 * sizeof(Id), pool_updatewhatprovides_sortcmp, 0);
+
+  /* the filelist matches of the lazy file provides may have changed,
+   * redo the lazy lookup */
+  if (pool->addedfileprovides == 1)
+    {
+      for (i = 0; i < pool->nonstd_nids; i++)
+	{
+	  id = pool->nonstd_ids[i];
+	  if (id < oldnum && pool->ss.stringspace[pool->ss.strings[id]] == '/')
+	    pool->whatprovides[id] = 0;
+	}
+    }
+  else if (!pool->addedfileprovides && pool->disttype == DISTTYPE_RPM)
+    {
+      /* no file provides index, every file name is lazy */
+      for (id = 1; id < oldnum; id++)
+	if (pool->ss.stringspace[pool->ss.strings[id]] == '/')
+	  pool->whatprovides[id] = 0;
+    }
+
+  /* find the names that had one of the changed solvables as provider.
+   * new solvables cannot be in the old lists, so the provider lists
+   * only need to be searched if existing solvables were changed */
+  if (start < end && start < pool->whatprovidesnsolvables)
+    {
+      for (id = 1; id < oldnum; id++)
+	{
+	  Offset o = pool->whatprovides[id];
+	  if (MAPTST(&affected, id))
+	    continue;
+	  if (!o)
+	    o = pool_searchlazywhatprovidesq(pool, id);
+	  if (o < 2)
+	    continue;
+	  for (dp = pool->whatprovidesdata + o; (p = *dp) != 0; dp++)
+	    if (p >= start && p < end)
+	      {
+		MAPSET(&affected, id);
+		break;
+	      }
+	}
+    }
+
+  /* recreate the provider lists of the affected names */
+  queue_init(&q);
+  queue_init(&aq);
+  for (id = 1, i = 0; id < num; id++)
+    {
+      Offset o = 0, auxo = 0;
+      int haveaux = pool->whatprovidesaux ? 1 : 0;
+      int lazy;
+
+      if (!MAPTST(&affected, id))
+	continue;
+      naffected++;
+      lazy = pool_islazyfileprovides(pool, id);
+      queue_empty(&q);
+      if (id < oldnum)
+	{
+	  /* the entry of a lazy file provides may already contain the
+	   * filelist matches, use the remembered providers instead */
+	  o = lazy ? pool_searchlazywhatprovidesq(pool, id) : pool->whatprovides[id];
+	  if (haveaux)
+	    auxo = pool->whatprovidesaux[id];
+	  if (o < 2)
+	    o = 0;
+	  if (o && !auxo)
+	    haveaux = 0;
+	}
+      if (o)
+	{
+	  /* keep the providers outside of the changed range */
+	  auxdp = haveaux ? pool->whatprovidesauxdata + auxo : 0;
+	  for (dp = pool->whatprovidesdata + o; (p = *dp) != 0; dp++)
+	    {
+	      if (p < start || p >= end)
+		queue_push2(&q, p, auxdp ? *auxdp : 0);
+	      if (auxdp)
+		auxdp++;
+	    }
+	}
+      for (; i < pq.count && pq.elements[i] == id; i += 3)
+	{
+	  p = pq.elements[i + 1];
+	  if (q.count && q.elements[q.count - 2] == p)
+	    q.elements[q.count - 1] = 1;	/* multiple provides for this name */
+	  else
+	    queue_push2(&q, p, pq.elements[i + 2]);
+	}
+      if (q.count > 2)
+	solv_sort(q.elements, q.count / 2, 2 * sizeof(Id), pool_updatewhatprovides_sortcmp, 0);
+      /* split into provider and aux lists */
+      queue_empty(&aq);
+      for (j = 0; j < q.count; j += 2)
+	queue_push(&aq, q.elements[j + 1]);
+      for (j = 0; j < aq.count; j++)
+	q.elements[j] = q.elements[2 * j];
+      queue_truncate(&q, aq.count);
+
+      if (lazy)
+	{
+	  pool_setlazywhatprovidesq(pool, id, pool_queuetowhatprovides(pool, &q));
+	  pool->whatprovides[id] = 0;
+	  if (pool->whatprovidesaux)
+	    pool->whatprovidesaux[id] = 0;
+	  continue;
+	}
+      pool->whatprovides[id] = pool_queuetowhatprovides(pool, &q);
+      if (!pool->whatprovidesaux)
+	continue;
+      if (!haveaux || !aq.count)
+	{
+	  pool->whatprovidesaux[id] = 0;
+	  continue;
+	}
+      /* like after pool_shrink_whatprovidesaux, the aux list is not terminated */
+      pool->whatprovidesauxdata = solv_extend(pool->whatprovidesauxdata, pool->whatprovidesauxdataoff, aq.count, sizeof(Id), WHATPROVIDES_BLOCK);
+      pool->whatprovidesaux[id] = pool->whatprovidesauxdataoff;
+      memcpy(pool->whatprovidesauxdata + pool->whatprovidesauxdataoff, aq.elements, aq.count * sizeof(Id));
+      pool->whatprovidesauxdataoff += aq.count;
+    }
+  queue_free(&aq);
+  queue_free(&q);
+  queue_free(&pq);
+
+  /* clear the cached providers of all relations that use an affected name.
+   * some relations do not just filter the providers of the name, always
+   * clear them. */
+  for (id = 1; id < nrels; id++)
+    {
+      Reldep *rd = pool->rels + id;
+      Id name = ISRELDEP(rd->name) ? num + GETRELID(rd->name) : rd->name;
+      Id evr = ISRELDEP(rd->evr) ? num + GETRELID(rd->evr) : rd->evr;
+      if (id >= pool->whatprovidesnrels || MAPTST(&affected, name) || MAPTST(&affected, evr) ||
+	  rd->flags == REL_NAMESPACE || rd->flags == REL_ARCH || rd->flags == REL_KIND || rd->flags == REL_CONDA)
+	{
+	  pool->whatprovides_rel[id] = 0;
+	  MAPSET(&affected, num + id);
+	}
+    }
+  map_free(&affected);
+
+  POOL_DEBUG(SOLV_DEBUG_STATS, "updated whatprovides of %d ids for solvables %d-%d\n", naffected, start, end);
+  pool->whatprovidesdirtystart = pool->whatprovidesdirtyend = 0;
+  pool->whatprovidesnsolvables = pool->nsolvables;
+  pool->whatprovidesnstrings = num;
+  pool->whatprovidesnrels = nrels;
+  if (pool->whatprovidesdataoff >= SOLV_MAX_INDEX)
+    solv_ovfl("pool whatprovides overflow");
+  return 1;
+}
+
+/*
+ * create the whatprovides index from scratch
+ */
+static void
+pool_createwhatprovides_full(Pool *pool)
 {
   int i, num, np, extra;
   Offset off;
@@ -179,16 +476,7 @@ pool_createwhatprovides(Pool *pool)
   Offset *whatprovides;
   Id *whatprovidesdata, *dp, *whatprovidesauxdata;
   Offset *whatprovidesaux;
-  unsigned int now;
-
-  now = solv_timems(0);
-  POOL_DEBUG(SOLV_DEBUG_STATS, "number of solvables: %d, memory used: %d K\n", pool->nsolvables, pool->nsolvables * (int)sizeof(Solvable) / 1024);
-  POOL_DEBUG(SOLV_DEBUG_STATS, "number of ids: %d + %d\n", pool->ss.nstrings, pool->nrels);
-  POOL_DEBUG(SOLV_DEBUG_STATS, "string memory used: %d K array + %d K data,  rel memory used: %d K array\n", pool->ss.nstrings / (1024 / (int)sizeof(Id)), pool->ss.sstrings / 1024, pool->nrels * (int)sizeof(Reldep) / 1024);
-  if (pool->ss.stringhashmask || pool->relhashmask)
-    POOL_DEBUG(SOLV_DEBUG_STATS, "string hash memory: %d K, rel hash memory : %d K\n", (pool->ss.stringhashmask + 1) / (int)(1024/sizeof(Id)), (pool->relhashmask + 1) / (int)(1024/sizeof(Id)));
 
-  pool_freeidhashes(pool);	/* XXX: should not be here! */
   pool_freewhatprovides(pool);
   num = pool->ss.nstrings;
   pool->whatprovides = whatprovides = solv_calloc_block(num, sizeof(Offset), WHATPROVIDES_BLOCK);
@@ -345,7 +633,42 @@ pool_createwhatprovides(Pool *pool)
   if (pool->lazywhatprovidesq.count)
     POOL_DEBUG(SOLV_DEBUG_STATS, "lazywhatprovidesq size: %d entries\n", pool->lazywhatprovidesq.count / 2);
 
-  POOL_DEBUG(SOLV_DEBUG_STATS, "createwhatprovides took %d ms\n", solv_timems(now));
+  pool->whatprovidesnsolvables = pool->nsolvables;
+  pool->whatprovidesnstrings = num;
+  pool->whatprovidesnrels = pool->nrels;
+  pool->whatprovidesbuildoff = pool->whatprovidesdataoff;
+}
+
+/*
+ * pool_createwhatprovides()
+ *
+ * create hashes over pool of solvables to ease provide lookups
+ *
+ */
+void
+pool_createwhatprovides(Pool *pool)
+{
+  unsigned int now;
+
+  now = solv_timems(0);
+  POOL_DEBUG(SOLV_DEBUG_STATS, "number of solvables: %d, memory used: %d K\n", pool->nsolvables, pool->nsolvables * (int)sizeof(Solvable) / 1024);
+  POOL_DEBUG(SOLV_DEBUG_STATS, "number of ids: %d + %d\n", pool->ss.nstrings, pool->nrels);
+  POOL_DEBUG(SOLV_DEBUG_STATS, "string memory used: %d K array + %d K data,  rel memory used: %d K array\n", pool->ss.nstrings / (1024 / (int)sizeof(Id)), pool->ss.sstrings / 1024, pool->nrels * (int)sizeof(Reldep) / 1024);
+  if (pool->ss.stringhashmask || pool->relhashmask)
+    POOL_DEBUG(SOLV_DEBUG_STATS, "string hash memory: %d K, rel hash memory : %d K\n", (pool->ss.stringhashmask + 1) / (int)(1024/(sizeof(Id) + 1)), (pool->relhashmask + 1) / (int)(1024/sizeof(Id)));
+
+  /* the id hashes are kept in incremental mode, as we expect more
+   * repository changes */
+  if (pool->incrementalwhatprovides && pool->whatprovides && pool_updatewhatprovides(pool))
+    {
+      pool->stats_whatprovidestime = solv_timems(now);
+      POOL_DEBUG(SOLV_DEBUG_STATS, "updatewhatprovides took %d ms\n", pool->stats_whatprovidestime);
+      return;
+    }
+  pool_freeidhashes(pool);	/* XXX: should not be here! */
+  pool_createwhatprovides_full(pool);
+  pool->stats_whatprovidestime = solv_timems(now);
+  POOL_DEBUG(SOLV_DEBUG_STATS, "createwhatprovides took %d ms\n", pool->stats_whatprovidestime);
 }
 
 /*
@@ -365,6 +688,159 @@ pool_freewhatprovides(Pool *pool)
   pool->whatprovidesauxdata = solv_free(pool->whatprovidesauxdata);
   pool->whatprovidesauxoff = 0;
   pool->whatprovidesauxdataoff = 0;
+  pool->whatprovidesdirtystart = pool->whatprovidesdirtyend = 0;
+}
+
+static int
+pool_checkwhatprovides_cmp(Id *a, Id *b)
+{
+  for (; *a; a++, b++)
+    if (*a != *b)
+      return 1;
+  return *b ? 1 : 0;
+}
+
+/*
+ * compare the current whatprovides index with a freshly created one.
+ * returns the number of mismatching entries. This is a debugging aid
+ * for the incremental whatprovides update.
+ */
+int
+pool_checkwhatprovides(Pool *pool)
+{
+  Offset *owhatprovides, *owhatprovides_rel, *owhatprovidesaux;
+  Id *owhatprovidesdata, *owhatprovidesauxdata;
+  Offset owhatprovidesdataoff, owhatprovidesauxoff, owhatprovidesauxdataoff, obuildoff;
+  int owhatprovidesdataleft;
+  Queue olazyq;
+  Id id, *lq, *olq;
+  int i, num, nrels, lazydiff = 0, bad = 0;
+
+  if (!pool->whatprovides)
+    return 0;
+  if (pool->whatprovidesdirtystart != pool->whatprovidesdirtyend || pool->whatprovidesnsolvables != pool->nsolvables || pool->whatprovidesnstrings != pool->ss.nstrings || pool->whatprovidesnrels != pool->nrels)
+    pool_createwhatprovides(pool);
+  num = pool->ss.nstrings;
+  nrels = pool->nrels;
+
+  /* stash away the current index */
+  owhatprovides = pool->whatprovides;
+  owhatprovides_rel = pool->whatprovides_rel;
+  owhatprovidesdata = pool->whatprovidesdata;
+  owhatprovidesdataoff = pool->whatprovidesdataoff;
+  owhatprovidesdataleft = pool->whatprovidesdataleft;
+  owhatprovidesaux = pool->whatprovidesaux;
+  owhatprovidesauxoff = pool->whatprovidesauxoff;
+  owhatprovidesauxdata = pool->whatprovidesauxdata;
+  owhatprovidesauxdataoff = pool->whatprovidesauxdataoff;
+  obuildoff = pool->whatprovidesbuildoff;
+  olazyq = pool->lazywhatprovidesq;
+  queue_init(&pool->lazywhatprovidesq);
+  pool->whatprovides = pool->whatprovides_rel = pool->whatprovidesaux = 0;
+  pool->whatprovidesdata = pool->whatprovidesauxdata = 0;
+
+  pool_createwhatprovides_full(pool);
+
+  for (id = 1; id < num; id++)
+    {
+      Offset o = owhatprovides[id], n = pool->whatprovides[id];
+      if (!n)
+	continue;	/* lazy entry, checked below */
+      if (!o || pool_checkwhatprovides_cmp(owhatprovidesdata + o, pool->whatprovidesdata + n))
+	{
+	  POOL_DEBUG(SOLV_DEBUG_STATS, "whatprovides mismatch for %s\n", pool_id2str(pool, id));
+	  bad++;
+	  continue;
+	}
+      if (pool->whatprovidesaux && owhatprovidesaux && pool->whatprovidesaux[id] && owhatprovidesaux[id])
+	{
+	  /* the aux lists are not terminated, they have the size of the provider list */
+	  Id *dp = pool->whatprovidesdata + n;
+	  Id *oa = owhatprovidesauxdata + owhatprovidesaux[id], *na = pool->whatprovidesauxdata + pool->whatprovidesaux[id];
+	  for (; *dp; dp++)
+	    if (*oa++ != *na++)
+	      break;
+	  if (*dp)
+	    {
+	      POOL_DEBUG(SOLV_DEBUG_STATS, "whatprovidesaux mismatch for %s\n", pool_id2str(pool, id));
+	      bad++;
+	    }
+	}
+    }
+  if (olazyq.count != pool->lazywhatprovidesq.count)
+    lazydiff = 1;
+  lq = pool->lazywhatprovidesq.elements;
+  olq = olazyq.elements;
+  for (i = 0; !lazydiff && i < olazyq.count; i += 2)
+    if (olq[i] != lq[i] || pool_checkwhatprovides_cmp(owhatprovidesdata + olq[i + 1], pool->whatprovidesdata + lq[i + 1]))
+      lazydiff = 1;
+  if (lazydiff)
+    {
+      POOL_DEBUG(SOLV_DEBUG_STATS, "lazywhatprovidesq mismatch\n");
+      bad++;
+    }
+  /* check the cached relation providers */
+  for (id = 1; id < nrels; id++)
+    {
+      Offset o = owhatprovides_rel[id], n;
+      if (!o)
+	continue;
+      n = pool_whatprovides(pool, MAKERELDEP(id));
+      if (pool_checkwhatprovides_cmp(owhatprovidesdata + o, pool->whatprovidesdata + n))
+	{
+	  POOL_DEBUG(SOLV_DEBUG_STATS, "whatprovides mismatch for %s\n", pool_dep2str(pool, MAKERELDEP(id)));
+	  bad++;
+	}
+    }
+
+  /* restore the old index */
+  pool_freewhatprovides(pool);
+  queue_free(&pool->lazywhatprovidesq);
+  pool->whatprovides = owhatprovides;
+  pool->whatprovides_rel = owhatprovides_rel;
+  pool->whatprovidesdata = owhatprovidesdata;
+  pool->whatprovidesdataoff = owhatprovidesdataoff;
+  pool->whatprovidesdataleft = owhatprovidesdataleft;
+  pool->whatprovidesaux = owhatprovidesaux;
+  pool->whatprovidesauxoff = owhatprovidesauxoff;
+  pool->whatprovidesauxdata = owhatprovidesauxdata;
+  pool->whatprovidesauxdataoff = owhatprovidesauxdataoff;
+  pool->whatprovidesbuildoff = obuildoff;
+  pool->lazywhatprovidesq = olazyq;
+  pool->whatprovidesnsolvables = pool->nsolvables;
+  pool->whatprovidesnstrings = num;
+  pool->whatprovidesnrels = nrels;
+  return bad;
+}
+
+/*
+ * mark the whatprovides entries of the solvables start..end-1 as
+ * outdated. Without incremental whatprovides this simply frees the
+ * index, otherwise the next pool_createwhatprovides() call just
+ * updates the entries of the affected names.
+ */
+void
+pool_invalidatewhatprovides(Pool *pool, Id start, Id end)
+{
+  if (!pool->whatprovides)
+    return;
+  if (!pool->incrementalwhatprovides)
+    {
+      pool_freewhatprovides(pool);
+      return;
+    }
+  if (start >= end)
+    return;
+  if (pool->whatprovidesdirtystart == pool->whatprovidesdirtyend)
+    {
+      pool->whatprovidesdirtystart = start;
+      pool->whatprovidesdirtyend = end;
+      return;
+    }
+  if (start < pool->whatprovidesdirtystart)
+    pool->whatprovidesdirtystart = start;
+  if (end > pool->whatprovidesdirtyend)
+    pool->whatprovidesdirtyend = end;
 }
 
 
@@ -391,14 +867,21 @@ pool_ids2whatprovides(Pool *pool, Id *ids, int count)
   if (count >= SOLV_MAX_INDEX)
     solv_ovfl("pool whatprovides data overflow");
 
+  if (pool->frozen)
+    pool_frozen_lock(pool);
   /* extend whatprovidesdata if needed, +1 for 0-termination */
   if (pool->whatprovidesdataleft < count + 1)
     {
       POOL_DEBUG(SOLV_DEBUG_STATS, "growing provides hash data...\n");
       if ((unsigned int)(SOLV_MAX_INDEX - pool->whatprovidesdataoff) < (unsigned int)count + 4096)
 	solv_ovfl("pool whatprovides data overflow");
-      pool->whatprovidesdata = solv_realloc2(pool->whatprovidesdata, pool->whatprovidesdataoff + count + 4096, sizeof(Id));
-      pool->whatprovidesdataleft = count + 4096;
+      if (pool->frozen)
+	pool_frozen_extend_whatprovidesdata(pool, count + 4096 + pool->whatprovidesdataoff / 8);
+      else
+	{
+	  pool->whatprovidesdata = solv_realloc2(pool->whatprovidesdata, pool->whatprovidesdataoff + count + 4096, sizeof(Id));
+	  pool->whatprovidesdataleft = count + 4096;
+	}
     }
 
   /* copy queue to next free slot */
@@ -409,6 +892,8 @@ pool_ids2whatprovides(Pool *pool, Id *ids, int count)
   pool->whatprovidesdataoff += count;
   pool->whatprovidesdata[pool->whatprovidesdataoff++] = 0;
   pool->whatprovidesdataleft -= count + 1;
+  if (pool->frozen)
+    pool_frozen_unlock(pool);
 
   return (Id)off;
 }
@@ -662,8 +1147,8 @@ pool_match_flags_evr(Pool *pool, int pflags, Id pevr, int flags, int evr)
  * E.g. if you ask for "whatrequires A" and package X contains
  * "Requires: A & B", you'll get "X" as an answer.
  */
-Id
-pool_addrelproviders(Pool *pool, Id d)
+static Id
+pool_calcrelproviders(Pool *pool, Id d)
 {
   Reldep *rd;
   Reldep *prd;
@@ -894,11 +1379,14 @@ pool_addrelproviders(Pool *pool, Id d)
     {
       Id *ppaux = 0;
       int eqmagic = 0;
+      Id wp;
+      int nprovs = 0;
       /* simple version comparison relation */
 #if 0
       POOL_DEBUG(SOLV_DEBUG_STATS, "addrelproviders: what provides %s?\n", pool_dep2str(pool, name));
 #endif
-      pp = pool_whatprovides_ptr(pool, name);
+      wp = pool_whatprovides(pool, name);
+      pp = pool->whatprovidesdata + wp;
       if (!ISRELDEP(name) && (Offset)name < pool->whatprovidesauxoff)
 	ppaux = pool->whatprovidesaux[name] ? pool->whatprovidesauxdata + pool->whatprovidesaux[name] : 0;
       while (ISRELDEP(name))
@@ -909,6 +1397,7 @@ pool_addrelproviders(Pool *pool, Id d)
       while ((p = *pp++) != 0)
 	{
 	  Solvable *s = pool->solvables + p;
+	  nprovs++;
 	  if (ppaux)
 	    {
 	      pid = *ppaux++;	/* the id that provided the name, 1 if there are multiple providers */
@@ -977,6 +1466,13 @@ pool_addrelproviders(Pool *pool, Id d)
 	    continue;	/* none of the providers matched */
 	  queue_push(&plist, p);
 	}
+      if (plist.count && plist.count == nprovs)
+	{
+	  /* all providers of the name match, reuse its entry */
+	  queue_free(&plist);
+	  pool->whatprovides_rel[d] = wp;
+	  return wp;
+	}
       /* make our system solvable provide all unknown rpmlib() stuff */
       if (plist.count == 0 && !strncmp(pool_id2str(pool, name), "rpmlib(", 7))
 	queue_push(&plist, SYSTEMSOLVABLE);
@@ -991,6 +1487,149 @@ pool_addrelproviders(Pool *pool, Id d)
   return pool->whatprovides_rel[d];
 }
 
+Id
+pool_addrelproviders(Pool *pool, Id d)
+{
+  Id off;
+
+  if (!pool->frozen)
+    return pool_calcrelproviders(pool, d);
+  /* another thread may be working on the same entry */
+  pool_frozen_lock(pool);
+  off = ISRELDEP(d) ? pool->whatprovides_rel[GETRELID(d)] : pool->whatprovides[d];
+  if (!off)
+    off = pool_calcrelproviders(pool, d);
+  pool_frozen_unlock(pool);
+  return off;
+}
+
+static int
+pool_addallproviders_sortcmp(const void *ap, const void *bp, void *dp)
+{
+  Pool *pool = dp;
+  Id oa = *(Id *)ap, ob = *(Id *)bp;
+  Id *da = pool->whatprovidesdata + oa;
+  Id *db = pool->whatprovidesdata + ob;
+
+  if (oa == ob)
+    return 0;
+  for (; *da == *db; da++, db++)
+    if (!*da)
+      return oa < ob ? -1 : 1;
+  return *da < *db ? -1 : 1;
+}
+
+/*
+ * unify the provider lists that were added since startoff with
+ * each other and with the older lists, then compact the area
+ */
+static void
+pool_shrink_addedproviders(Pool *pool, Offset startoff)
+{
+  Offset endoff = pool->whatprovidesdataoff;
+  Offset *newoff, o, rep;
+  Id *sorted, *dp, *lp, id;
+  Map used;
+  int i, j, n;
+
+  if (endoff == startoff)
+    return;
+  sorted = solv_malloc2(pool->ss.nstrings + pool->nrels, sizeof(Id));
+  n = 0;
+  for (id = 1; id < pool->ss.nstrings; id++)
+    if (pool->whatprovides[id] >= 4)
+      sorted[n++] = pool->whatprovides[id];
+  for (id = 1; id < pool->nrels; id++)
+    if (pool->whatprovides_rel[id] >= 4)
+      sorted[n++] = pool->whatprovides_rel[id];
+  solv_sort(sorted, n, sizeof(Id), pool_addallproviders_sortcmp, pool);
+
+  /* map the duplicates to the first (lowest) offset with the same content */
+  newoff = solv_calloc(endoff - startoff, sizeof(Offset));
+  map_init(&used, endoff - startoff);
+  for (i = 0; i < n; i = j)
+    {
+      rep = sorted[i];
+      if (rep >= startoff)
+	MAPSET(&used, rep - startoff);
+      for (j = i + 1; j < n; j++)
+	{
+	  if ((Offset)sorted[j] == rep)
+	    continue;
+	  dp = pool->whatprovidesdata + rep;
+	  lp = pool->whatprovidesdata + sorted[j];
+	  while (*dp && *dp == *lp)
+	    dp++, lp++;
+	  if (*dp != *lp)
+	    break;
+	  if ((Offset)sorted[j] >= startoff)
+	    newoff[sorted[j] - startoff] = rep;
+	}
+    }
+  solv_free(sorted);
+
+  /* move the used lists down */
+  dp = pool->whatprovidesdata + startoff;
+  for (o = startoff; o < endoff; o = lp - pool->whatprovidesdata)
+    {
+      lp = pool->whatprovidesdata + o;
+      if (MAPTST(&used, o - startoff))
+	{
+	  newoff[o - startoff] = dp - pool->whatprovidesdata;
+	  while ((*dp++ = *lp++) != 0)
+	    ;
+	  continue;
+	}
+      while (*lp++)
+	;
+      rep = newoff[o - startoff];
+      if (rep >= startoff)
+	newoff[o - startoff] = newoff[rep - startoff];
+    }
+  map_free(&used);
+
+  for (id = 1; id < pool->ss.nstrings; id++)
+    if (pool->whatprovides[id] >= startoff)
+      pool->whatprovides[id] = newoff[pool->whatprovides[id] - startoff];
+  for (id = 1; id < pool->nrels; id++)
+    if (pool->whatprovides_rel[id] >= startoff)
+      pool->whatprovides_rel[id] = newoff[pool->whatprovides_rel[id] - startoff];
+  solv_free(newoff);
+
+  o = dp - pool->whatprovidesdata;
+  POOL_DEBUG(SOLV_DEBUG_STATS, "shrunk added providers from %d to %d\n", endoff - startoff, o - startoff);
+  memset(dp, 0, (endoff - o) * sizeof(Id));
+  pool->whatprovidesdataleft += endoff - o;
+  pool->whatprovidesdataoff = o;
+}
+
+/*
+ * compute the providers of all strings and relations now instead of
+ * doing it lazily on the first lookup. The new provider lists are
+ * unified so that identical lists share the same data.
+ */
+void
+pool_addallproviders(Pool *pool)
+{
+  Offset startoff;
+  Id id;
+  int now = solv_timems(0);
+
+  if (!pool->whatprovides)
+    pool_createwhatprovides(pool);
+  startoff = pool->whatprovidesdataoff;
+  for (id = 1; id < pool->ss.nstrings; id++)
+    if (!pool->whatprovides[id])
+      pool_addrelproviders(pool, id);
+  for (id = 1; id < pool->nrels; id++)
+    if (!pool->whatprovides_rel[id])
+      pool_addrelproviders(pool, MAKERELDEP(id));
+  /* the namespace callback may have stored offsets into the new area */
+  if (!pool->nscallback && !pool->frozen)
+    pool_shrink_addedproviders(pool, startoff);
+  POOL_DEBUG(SOLV_DEBUG_STATS, "addallproviders took %d ms\n", solv_timems(now));
+}
+
 void
 pool_flush_namespaceproviders(Pool *pool, Id ns, Id evr)
 {
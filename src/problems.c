@@ -431,6 +431,11 @@ refine_suggestion(Solver *solv, Id *problem, Id sug, Queue *refined, int essenti
        * the first problem and we don't want the solver to disable the problems */
       solver_run_sat(solv, 0, 0);
 
+      if (solv->aborted)
+	{
+	  refined->count = 0;
+	  break;
+	}
       if (!solv->problems.count)
 	{
 	  POOL_DEBUG(SOLV_DEBUG_SOLUTIONS, "no more problems!\n");
@@ -799,7 +804,16 @@ create_solutions(Solver *solv, int probnr, int solidx)
   int oldmistakes = solv->cleandeps_mistakes ? solv->cleandeps_mistakes->count : 0;
   Id extraflags = -1;
 
+  if (solv->aborted)
+    {
+      /* do not try again, just report no solutions */
+      solv->solutions.elements[solidx] = 0;
+      solv->solutions.elements[solidx + 1] = 0;
+      return;
+    }
   now = solv_timems(0);
+  solv->abort_start = now;
+  solv->abort_checkcnt = 0;
   queue_init(&redoq);
   /* save decisionq, decisionq_why, decisionmap, and decisioncnt */
   for (i = 0; i < solv->decisionq.count; i++)
@@ -852,6 +866,11 @@ create_solutions(Solver *solv, int probnr, int solidx)
     {
       int solstart = solv->solutions.count;
       refine_suggestion(solv, problem.elements, problem.elements[i], &solution, essentialok);
+      if (solv->aborted)
+	{
+	  nsol = 0;	/* partial solutions are worse than none */
+	  break;
+	}
       queue_push(&solv->solutions, 0);	/* reserve room for number of elements */
       for (j = 0; j < solution.count; j++)
 	convertsolution(solv, solution.elements[j], &solv->solutions);
@@ -933,7 +952,9 @@ create_solutions(Solver *solv, int probnr, int solidx)
 	}
     }
 
-  POOL_DEBUG(SOLV_DEBUG_STATS, "create_solutions for problem #%d took %d ms\n", probnr, solv_timems(now));
+  now = solv_timems(now);
+  solv->stats_solutionstime += now;
+  POOL_DEBUG(SOLV_DEBUG_STATS, "create_solutions for problem #%d took %d ms\n", probnr, now);
 }
 
 
@@ -77,15 +77,27 @@ queue_free(Queue *q)
 void
 queue_alloc_one(Queue *q)
 {
-  if (q->alloc && q->alloc != q->elements)
+  int l = q->alloc ? q->elements - q->alloc : 0;
+  if (l && l >= q->count / 8)
     {
       /* there's room at the front. just move data */
-      int l = q->elements - q->alloc;
       if (q->count)
         memmove(q->alloc, q->elements, q->count * sizeof(Id));
       q->elements -= l;
       q->left += l;
     }
+  else if (l)
+    {
+      /* the queue is used as a big fifo with just a few elements
+       * shifted off. grow it instead of moving all the data over and
+       * over again. */
+      int extra_space = queue_extra_space(q->count);
+      if (l + q->count + extra_space >= SOLV_MAX_QUEUECOUNT)
+	solv_ovfl("queue count overflow");
+      q->alloc = solv_realloc2(q->alloc, l + q->count + extra_space, sizeof(Id));
+      q->elements = q->alloc + l;
+      q->left = extra_space;
+    }
   else
     {
       int extra_space = queue_extra_space(q->count);
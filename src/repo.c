@@ -23,6 +23,7 @@
 
 #include "repo.h"
 #include "pool.h"
+#include "pool_private.h"
 #include "util.h"
 #include "chksum.h"
 
@@ -39,7 +40,7 @@ repo_create(Pool *pool, const char *name)
 {
   Repo *repo;
 
-  pool_freewhatprovides(pool);
+  pool_invalidatewhatprovides(pool, pool->nsolvables, pool->nsolvables);
   repo = (Repo *)solv_calloc(1, sizeof(*repo));
   if (!pool->nrepos)
     {
@@ -86,7 +87,7 @@ repo_empty(Repo *repo, int reuseids)
   Solvable *s;
   int i;
 
-  pool_freewhatprovides(pool);
+  pool_invalidatewhatprovides(pool, repo->start, repo->end);
   if (reuseids && repo->end == pool->nsolvables)
     {
       /* it's ok to reuse the ids. As this is the last repo, we can
@@ -259,6 +260,8 @@ repo_add_solvable_block_before(Repo *repo, int count, Repo *beforerepo)
     }
   beforerepo->start += count;
   beforerepo->end += count;
+  if (pool->incrementalwhatprovides)
+    pool_invalidatewhatprovides(pool, p, beforerepo->end);
   /* we now have count free solvables at id p */
   /* warning: sidedata must be extended before adapting start/end */
   if (repo->rpmdbid)
@@ -944,8 +947,8 @@ repo_lookup_repodata(Repo *repo, Id entry, Id keyname)
 
   if (entry == SOLVID_POS)
     {
-      Pool *pool = repo->pool;
-      return pool->pos.repo == repo && pool->pos.repodataid ? pool->pos.repo->repodata + pool->pos.repodataid : 0;
+      Datapos *pos = pool_pos(repo->pool);
+      return pos->repo == repo && pos->repodataid ? repo->repodata + pos->repodataid : 0;
     }
   for (rdid = repo->nrepodata - 1, data = repo->repodata + rdid; rdid > 0; rdid--, data--)
     {
@@ -969,8 +972,8 @@ repo_lookup_repodata_opt(Repo *repo, Id entry, Id keyname)
 
   if (entry == SOLVID_POS)
     {
-      Pool *pool = repo->pool;
-      return pool->pos.repo == repo && pool->pos.repodataid ? pool->pos.repo->repodata + pool->pos.repodataid : 0;
+      Datapos *pos = pool_pos(repo->pool);
+      return pos->repo == repo && pos->repodataid ? repo->repodata + pos->repodataid : 0;
     }
   for (rdid = repo->nrepodata - 1, data = repo->repodata + rdid; rdid > 0; rdid--, data--)
     {
@@ -18,6 +18,11 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
+#ifdef HAVE_MMAP
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
 
 #include "repo_solv.h"
 #include "util.h"
@@ -43,6 +48,57 @@
  * functions to extract data from a file handle
  */
 
+/*
+ * get the next byte, either from the mapped file or via stdio
+ */
+
+static inline int
+read_byte(Repodata *data)
+{
+  if (data->mapdatap)
+    return data->mapdatap < data->mapdataend ? *data->mapdatap++ : EOF;
+  return getc(data->fp);
+}
+
+/*
+ * read a blob of len bytes, return 0 on success
+ */
+
+static int
+read_blob(Repodata *data, void *buf, size_t len)
+{
+  if (!len)
+    return 0;
+  if (data->mapdatap)
+    {
+      if ((size_t)(data->mapdataend - data->mapdatap) < len)
+	{
+	  data->mapdatap = data->mapdataend;
+	  return EOF;
+	}
+      memcpy(buf, data->mapdatap, len);
+      data->mapdatap += len;
+      return 0;
+    }
+  return fread(buf, len, 1, data->fp) == 1 ? 0 : EOF;
+}
+
+/*
+ * stop reading from the mapped file. positions the file pointer
+ * so that the stdio functions continue where we stopped.
+ */
+
+static int
+read_unmap(Repodata *data)
+{
+  if (!data->mapdatap)
+    return 0;
+  if (fseeko(data->fp, (off_t)(data->mapdatap - data->mapdata), SEEK_SET) != 0)
+    return SOLV_ERROR_EOF;
+  data->mapdata = data->mapdatap = data->mapdataend = 0;
+  return 0;
+}
+
 /*
  * read u32
  */
@@ -57,7 +113,7 @@ read_u32(Repodata *data)
     return 0;
   for (i = 0; i < 4; i++)
     {
-      c = getc(data->fp);
+      c = read_byte(data);
       if (c == EOF)
 	{
 	  data->error = pool_error(data->repo->pool, SOLV_ERROR_EOF, "unexpected EOF");
@@ -80,7 +136,7 @@ read_u8(Repodata *data)
 
   if (data->error)
     return 0;
-  c = getc(data->fp);
+  c = read_byte(data);
   if (c == EOF)
     {
       data->error = pool_error(data->repo->pool, SOLV_ERROR_EOF, "unexpected EOF");
@@ -104,7 +160,7 @@ read_id(Repodata *data, Id max)
     return 0;
   for (i = 0; i < 5; i++)
     {
-      c = getc(data->fp);
+      c = read_byte(data);
       if (c == EOF)
 	{
 	  data->error = pool_error(data->repo->pool, SOLV_ERROR_EOF, "unexpected EOF");
@@ -137,7 +193,7 @@ read_idarray(Repodata *data, Id max, Id *map, Id *store, Id *end)
     return 0;
   for (;;)
     {
-      c = getc(data->fp);
+      c = read_byte(data);
       if (c == EOF)
 	{
 	  data->error = pool_error(data->repo->pool, SOLV_ERROR_EOF, "unexpected EOF");
@@ -202,7 +258,7 @@ read_idarray_block(Repodata *data, Id *block, int size)
 	  if (!clen)
 	    clen = 65536;
 	  eof = flags & 0x80;
-	  if (fread(flags & 0x40 ? cbuf : bp, clen, 1, data->fp) != 1)
+	  if (read_blob(data, flags & 0x40 ? cbuf : bp, clen) != 0)
 	    {
 	      data->error = pool_error(data->repo->pool, SOLV_ERROR_EOF, "unexpected EOF");
 	      return;
@@ -535,10 +591,12 @@ incore_add_u8(Repodata *data, unsigned int x)
 
 /*
  * read repo from .solv file and add it to pool
+ * if mapdata is set, the file is mapped into memory and read
+ * starting from mapoff
  */
 
-int
-repo_add_solv(Repo *repo, FILE *fp, int flags)
+static int
+repo_add_solv_int(Repo *repo, FILE *fp, int flags, unsigned char *mapdata, size_t mapoff, size_t maplen)
 {
   Pool *pool = repo->pool;
   int i, l;
@@ -604,6 +662,12 @@ repo_add_solv(Repo *repo, FILE *fp, int flags)
   memset(&data, 0, sizeof(data));
   data.repo = repo;
   data.fp = fp;
+  if (mapdata)
+    {
+      data.mapdata = mapdata;
+      data.mapdatap = mapdata + mapoff;
+      data.mapdataend = mapdata + maplen;
+    }
   repopagestore_init(&data.store);
 
   if (read_u32(&data) != ('S' << 24 | 'O' << 16 | 'L' << 8 | 'V'))
@@ -613,6 +677,7 @@ repo_add_solv(Repo *repo, FILE *fp, int flags)
     {
       case SOLV_VERSION_8:
       case SOLV_VERSION_9:
+      case SOLV_VERSION_10:
 	break;
       default:
         return pool_error(pool, SOLV_ERROR_UNSUPPORTED, "unsupported SOLV version");
@@ -641,6 +706,14 @@ repo_add_solv(Repo *repo, FILE *fp, int flags)
 
   if (numrel && (flags & REPO_LOCALPOOL) != 0)
     return pool_error(pool, SOLV_ERROR_CORRUPT, "relations are forbidden in a local pool");
+  if ((solvflags & SOLV_FLAG_ZSTD_PAGES) != 0)
+    {
+#ifdef ENABLE_ZSTD_PAGES
+      data.store.zstdpages = 1;
+#else
+      return pool_error(pool, SOLV_ERROR_UNSUPPORTED, "zstd compressed pages are not supported");
+#endif
+    }
   if ((flags & REPO_EXTEND_SOLVABLES) && numsolv)
     {
       /* make sure that we exactly replace the stub repodata */
@@ -659,7 +732,7 @@ repo_add_solv(Repo *repo, FILE *fp, int flags)
       if (userdatalen >= 65536)
         return pool_error(pool, SOLV_ERROR_CORRUPT, "illegal userdata length");
       while (userdatalen--)
-	if (getc(data.fp) == EOF)
+	if (read_byte(&data) == EOF)
 	  return pool_error(pool, SOLV_ERROR_EOF, "unexpected EOF");
     }
 
@@ -708,7 +781,7 @@ repo_add_solv(Repo *repo, FILE *fp, int flags)
   strsp = spool->stringspace + spool->sstrings;	/* append new entries */
   if ((solvflags & SOLV_FLAG_PREFIX_POOL) == 0)
     {
-      if (sizeid && fread(strsp, sizeid, 1, fp) != 1)
+      if (read_blob(&data, strsp, sizeid) != 0)
 	{
 	  repodata_freedata(&data);
 	  return pool_error(pool, SOLV_ERROR_EOF, "read error while reading strings");
@@ -723,7 +796,7 @@ repo_add_solv(Repo *repo, FILE *fp, int flags)
       char *dest = strsp;
       int freesp = sizeid;
 
-      if (pfsize && fread(prefix, pfsize, 1, fp) != 1)
+      if (read_blob(&data, prefix, pfsize) != 0)
 	{
 	  solv_free(prefix);
 	  repodata_freedata(&data);
@@ -1027,16 +1100,29 @@ repo_add_solv(Repo *repo, FILE *fp, int flags)
   if (maxsize > allsize)
     maxsize = allsize;
 
-  buf = solv_calloc(maxsize + DATA_READ_CHUNK + 4, 1);	/* 4 extra bytes to detect overflows */
-  bufend = buf;
-  dp = buf;
-
-  l = maxsize;
-  if (l < DATA_READ_CHUNK)
-    l = DATA_READ_CHUNK;
-  if (l > allsize)
-    l = allsize;
-  if (!l || fread(buf, l, 1, data.fp) != 1)
+  if (data.mapdatap)
+    {
+      /* decode directly from the mapped file. The bytes after bufend are
+       * the vertical data, so an overrun does not stop at bufend. It is
+       * caught by the dp > bufend checks, the zero filled rest of the last
+       * page makes sure that the decoder never reads past the mapping */
+      buf = 0;
+      bufend = dp = data.mapdatap;
+      l = allsize;
+    }
+  else
+    {
+      buf = solv_calloc(maxsize + DATA_READ_CHUNK + 4, 1);	/* 4 extra bytes to detect overflows */
+      bufend = buf;
+      dp = buf;
+
+      l = maxsize;
+      if (l < DATA_READ_CHUNK)
+	l = DATA_READ_CHUNK;
+      if (l > allsize)
+	l = allsize;
+    }
+  if (!l || (buf ? fread(buf, l, 1, data.fp) != 1 : data.mapdataend - dp < l))
     {
       if (!data.error)
         data.error = pool_error(pool, SOLV_ERROR_EOF, "unexpected EOF");
@@ -1044,8 +1130,10 @@ repo_add_solv(Repo *repo, FILE *fp, int flags)
     }
   else
     {
-      bufend = buf + l;
+      bufend = dp + l;
       allsize -= l;
+      if (!buf)
+	data.mapdatap += l;
       dp = data_read_id_max(dp, &id, 0, numschemata, &data);
     }
 
@@ -1076,7 +1164,7 @@ repo_add_solv(Repo *repo, FILE *fp, int flags)
               data.error = pool_error(pool, SOLV_ERROR_EOF, "buffer overrun");
 	      break;
 	    }
-	  if (left < maxsize)
+	  if (left < maxsize && buf)
 	    {
 	      if (left)
 		memmove(buf, dp, left);
@@ -1407,8 +1495,11 @@ data_error:
 	  }
       data.lastverticaloffset = fileoffset;
       pagesize = read_u32(&data);
+      if (!data.error && read_unmap(&data) != 0)
+	data.error = pool_error(pool, SOLV_ERROR_EOF, "could not reposition file pointer");
       if (!data.error)
 	{
+	  data.store.cache = pool->pagecache;
 	  data.error = repopagestore_read_or_setup_pages(&data.store, data.fp, pagesize, fileoffset);
 	  if (data.error == SOLV_ERROR_EOF)
 	    pool_error(pool, data.error, "repopagestore setup: unexpected EOF");
@@ -1416,7 +1507,10 @@ data_error:
 	    pool_error(pool, data.error, "repopagestore setup failed");
 	}
     }
+  if (!data.error && read_unmap(&data) != 0)
+    data.error = pool_error(pool, SOLV_ERROR_EOF, "could not reposition file pointer");
   data.fp = 0; /* no longer needed */
+  data.mapdata = data.mapdatap = data.mapdataend = 0;
 
   if (data.error)
     {
@@ -1468,12 +1562,68 @@ data_error:
 	repodata_create_stubs(repo->repodata + data.repodataid);
     }
 
-  POOL_DEBUG(SOLV_DEBUG_STATS, "repo_add_solv took %d ms\n", solv_timems(now));
+  now = solv_timems(now);
+  pool->stats_addsolvtime += now;
+  POOL_DEBUG(SOLV_DEBUG_STATS, "repo_add_solv took %d ms\n", now);
   POOL_DEBUG(SOLV_DEBUG_STATS, "repo size: %d solvables\n", repo->nsolvables);
   POOL_DEBUG(SOLV_DEBUG_STATS, "repo memory used: %d K incore, %d K idarray\n", data.incoredatalen/1024, repo->idarraysize / (int)(1024/sizeof(Id)));
   return 0;
 }
 
+#ifdef HAVE_MMAP
+
+/*
+ * map the complete file into memory. we need at least one byte of
+ * zero padding at the end, so files that end on a page boundary
+ * are read via stdio.
+ */
+
+static unsigned char *
+solv_map_file(FILE *fp, size_t *mapoffp, size_t *maplenp)
+{
+  struct stat stb;
+  off_t off;
+  long pagesize;
+  void *map;
+  int fd = fileno(fp);
+
+  if (fd < 0 || fstat(fd, &stb) != 0 || !S_ISREG(stb.st_mode))
+    return 0;
+  if ((off = ftello(fp)) < 0 || off >= stb.st_size)
+    return 0;
+  if ((pagesize = sysconf(_SC_PAGESIZE)) <= 0 || (stb.st_size % pagesize) == 0)
+    return 0;
+  if ((off_t)(size_t)stb.st_size != stb.st_size)
+    return 0;
+  map = mmap(0, (size_t)stb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (map == MAP_FAILED)
+    return 0;
+  *mapoffp = (size_t)off;
+  *maplenp = (size_t)stb.st_size;
+  return map;
+}
+
+#endif
+
+int
+repo_add_solv(Repo *repo, FILE *fp, int flags)
+{
+#ifdef HAVE_MMAP
+  if ((flags & SOLV_ADD_MMAP) != 0)
+    {
+      size_t mapoff, maplen;
+      unsigned char *mapdata = solv_map_file(fp, &mapoff, &maplen);
+      if (mapdata)
+	{
+	  int ret = repo_add_solv_int(repo, fp, flags, mapdata, mapoff, maplen);
+	  munmap(mapdata, maplen);
+	  return ret;
+	}
+    }
+#endif
+  return repo_add_solv_int(repo, fp, flags, 0, 0, 0);
+}
+
 int
 solv_read_userdata(FILE *fp, unsigned char **datap, int *lenp)
 {
@@ -1489,6 +1639,7 @@ solv_read_userdata(FILE *fp, unsigned char **datap, int *lenp)
     {
     case SOLV_VERSION_8:
     case SOLV_VERSION_9:
+    case SOLV_VERSION_10:
       break;
     default:
       return SOLV_ERROR_UNSUPPORTED;
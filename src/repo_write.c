@@ -310,6 +310,9 @@ struct cbdata {
 #define SCHEMATA_BLOCK 31
 #define EXTDATA_BLOCK 4095
 
+/* compression level for REPOWRITER_ZSTD_PAGES */
+#define ZSTD_PAGES_LEVEL 9
+
 static inline void
 data_addid(struct extdata *xd, Id sx)
 {
@@ -1012,7 +1015,7 @@ write_compressed_page(PageCompressor *comp, Repodata *data, unsigned char *page,
   int clen;
   unsigned char cpage[REPOPAGE_BLOBSIZE];
 
-  clen = repopagestore_compress_page(page, len, cpage, len - 1);
+  clen = pagecompressor_compress(comp, page, len, cpage, len - 1);
   if (!clen)
     {
       write_u32(data, len * 2);
@@ -2013,10 +2016,22 @@ for (i = 1; i < target.nkeys; i++)
     solv_flags |= SOLV_FLAG_USERDATA;
   if (cbdata.extdata[target.nkeys].len)
     solv_flags |= SOLV_FLAG_IDARRAYBLOCK;
+#ifdef ENABLE_ZSTD_PAGES
+  if ((writer->flags & REPOWRITER_ZSTD_PAGES) != 0)
+    {
+      for (i = 1; i < target.nkeys; i++)
+	if (cbdata.extdata[i].len)
+	  break;
+      if (i < target.nkeys)
+	solv_flags |= SOLV_FLAG_ZSTD_PAGES;
+    }
+#endif
 
   /* write file header */
   write_u32(&target, 'S' << 24 | 'O' << 16 | 'L' << 8 | 'V');
-  if ((solv_flags & (SOLV_FLAG_USERDATA | SOLV_FLAG_IDARRAYBLOCK)) != 0)
+  if ((solv_flags & SOLV_FLAG_ZSTD_PAGES) != 0)
+    write_u32(&target, SOLV_VERSION_10);
+  else if ((solv_flags & (SOLV_FLAG_USERDATA | SOLV_FLAG_IDARRAYBLOCK)) != 0)
     write_u32(&target, SOLV_VERSION_9);
   else
     write_u32(&target, SOLV_VERSION_8);
@@ -2176,6 +2191,8 @@ for (i = 1; i < target.nkeys; i++)
       int lpage = 0;
       PageCompressor *comp = pagecompressor_create();
 
+      if ((solv_flags & SOLV_FLAG_ZSTD_PAGES) != 0)
+	pagecompressor_set_zstd(comp, ZSTD_PAGES_LEVEL);
       write_u32(&target, REPOPAGE_BLOBSIZE);
       if (!cbdata.filelistmode)
 	{
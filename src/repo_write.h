@@ -39,6 +39,7 @@ typedef struct s_Repowriter {
 /* repowriter flags */
 #define REPOWRITER_NO_STORAGE_SOLVABLE	(1 << 0)
 #define REPOWRITER_KEEP_TYPE_DELETED	(1 << 1)
+#define REPOWRITER_ZSTD_PAGES		(1 << 2)
 #define REPOWRITER_LEGACY		(1 << 30)
 
 Repowriter *repowriter_create(Repo *repo);
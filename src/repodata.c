@@ -26,6 +26,7 @@
 
 #include "repo.h"
 #include "pool.h"
+#include "pool_private.h"
 #include "util.h"
 #include "hash.h"
 #include "chksum.h"
@@ -500,7 +501,8 @@ get_vertical_data(Repodata *data, Repokey *key, Id off, Id len)
   off += data->verticaloffset[key - data->keys];
   /* fprintf(stderr, "key %d page %d\n", key->name, off / REPOPAGE_BLOBSIZE); */
   dp = repopagestore_load_page_range(&data->store, off / REPOPAGE_BLOBSIZE, (off + len - 1) / REPOPAGE_BLOBSIZE);
-  data->storestate++;
+  if (!data->repo->pool->frozen)
+    data->storestate++;		/* all pages are loaded in a frozen pool */
   if (dp)
     dp += off % REPOPAGE_BLOBSIZE;
   return dp;
@@ -585,15 +587,15 @@ solvid2data(Repodata *data, Id solvid, Id *schemap)
     dp += 1;	/* offset of "meta" solvable */
   else if (solvid == SOLVID_POS)
     {
-      Pool *pool = data->repo->pool;
-      if (data->repo != pool->pos.repo)
+      Datapos *pos = pool_pos(data->repo->pool);
+      if (data->repo != pos->repo)
 	return 0;
-      if (data != data->repo->repodata + pool->pos.repodataid)
+      if (data != data->repo->repodata + pos->repodataid)
 	return 0;
-      dp += pool->pos.dp;
-      if (pool->pos.dp != 1)
+      dp += pos->dp;
+      if (pos->dp != 1)
         {
-          *schemap = pool->pos.schema;
+          *schemap = pos->schema;
           return dp;
 	}
     }
@@ -1331,10 +1333,11 @@ repodata_setpos_kv(Repodata *data, KeyValue *kv)
     pool_clear_pos(pool);
   else
     {
-      pool->pos.repo = data->repo;
-      pool->pos.repodataid = data - data->repo->repodata;
-      pool->pos.dp = (unsigned char *)kv->str - data->incoredata;
-      pool->pos.schema = kv->id;
+      Datapos *pos = pool_pos(pool);
+      pos->repo = data->repo;
+      pos->repodataid = data - data->repo->repodata;
+      pos->dp = (unsigned char *)kv->str - data->incoredata;
+      pos->schema = kv->id;
     }
 }
 
@@ -1766,7 +1769,7 @@ dataiterator_step(Dataiterator *di)
 	  if (!di->dp)
 	    goto di_nextrepodata;
 	  if (di->solvid == SOLVID_POS)
-	    di->solvid = di->pool->pos.solvid;
+	    di->solvid = pool_pos(di->pool)->solvid;
 	  /* reset key iterator */
 	  di->keyp = di->data->schemadata + di->data->schemata[schema];
 	  /* FALLTHROUGH */
@@ -2009,31 +2012,35 @@ dataiterator_entersub(Dataiterator *di)
 void
 dataiterator_setpos(Dataiterator *di)
 {
+  Datapos *pos;
   if (di->kv.eof == 2)
     {
       pool_clear_pos(di->pool);
       return;
     }
-  di->pool->pos.solvid = di->solvid;
-  di->pool->pos.repo = di->repo;
-  di->pool->pos.repodataid = di->data - di->repo->repodata;
-  di->pool->pos.schema = di->kv.id;
-  di->pool->pos.dp = (unsigned char *)di->kv.str - di->data->incoredata;
+  pos = pool_pos(di->pool);
+  pos->solvid = di->solvid;
+  pos->repo = di->repo;
+  pos->repodataid = di->data - di->repo->repodata;
+  pos->schema = di->kv.id;
+  pos->dp = (unsigned char *)di->kv.str - di->data->incoredata;
 }
 
 void
 dataiterator_setpos_parent(Dataiterator *di)
 {
+  Datapos *pos;
   if (!di->kv.parent || di->kv.parent->eof == 2)
     {
       pool_clear_pos(di->pool);
       return;
     }
-  di->pool->pos.solvid = di->solvid;
-  di->pool->pos.repo = di->repo;
-  di->pool->pos.repodataid = di->data - di->repo->repodata;
-  di->pool->pos.schema = di->kv.parent->id;
-  di->pool->pos.dp = (unsigned char *)di->kv.parent->str - di->data->incoredata;
+  pos = pool_pos(di->pool);
+  pos->solvid = di->solvid;
+  pos->repo = di->repo;
+  pos->repodataid = di->data - di->repo->repodata;
+  pos->schema = di->kv.parent->id;
+  pos->dp = (unsigned char *)di->kv.parent->str - di->data->incoredata;
 }
 
 /* clones just the position, not the search keys/matcher */
@@ -2170,17 +2177,18 @@ dataiterator_jump_to_solvid(Dataiterator *di, Id solvid)
   di->keyname = di->keynames[0];
   if (solvid == SOLVID_POS)
     {
-      di->repo = di->pool->pos.repo;
+      Datapos *pos = pool_pos(di->pool);
+      di->repo = pos->repo;
       if (!di->repo)
 	{
 	  di->state = di_bye;
 	  return;
 	}
       di->repoid = 0;
-      if (!di->pool->pos.repodataid && di->pool->pos.solvid == SOLVID_META) {
+      if (!pos->repodataid && pos->solvid == SOLVID_META) {
 	solvid = SOLVID_META;		/* META pos hack */
       } else {
-        di->data = di->repo->repodata + di->pool->pos.repodataid;
+        di->data = di->repo->repodata + pos->repodataid;
         di->repodataid = 0;
       }
     }
@@ -94,6 +94,10 @@ struct s_Repodata {
   FILE *fp;			/* file pointer of solv file */
   int error;			/* corrupt solv file */
 
+  unsigned char *mapdata;	/* mmapped solv file, offset 0 */
+  unsigned char *mapdatap;	/* read pointer into mapped file */
+  unsigned char *mapdataend;	/* end of mapped file */
+
   int filelisttype;		/* type of filelist */
   Id *filelistfilter;		/* filelist filter used */
   char *filelistfilterdata;	/* filelist filter string space */
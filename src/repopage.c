@@ -16,6 +16,9 @@
  * The vertical data is split into pages, each page is compressed with a fast
  * compression algorithm. These pages are read in on demand, not recently used
  * pages automatically get dropped.
+ *
+ * If libsolv is built with ENABLE_ZSTD_PAGES, the pages can also be
+ * compressed with zstd. Such files have the SOLV_FLAG_ZSTD_PAGES flag set.
  */
 
 #define _XOPEN_SOURCE 500
@@ -36,6 +39,10 @@
   #include <io.h>
 #endif
 
+#ifdef ENABLE_ZSTD_PAGES
+#include <zstd.h>
+#endif
+
 #include "repo.h"
 #include "repopage.h"
 
@@ -621,6 +628,15 @@ void repopagestore_free(Repopagestore *store)
   store->file_pages = solv_free(store->file_pages);
   store->mapped_at = solv_free(store->mapped_at);
   store->mapped = solv_free(store->mapped);
+  store->referenced = solv_free(store->referenced);
+  if (store->cache && store->nmapped)
+    store->cache->npages -= store->nmapped;
+  store->nmapped = 0;
+#ifdef ENABLE_ZSTD_PAGES
+  if (store->zstddctx)
+    ZSTD_freeDCtx(store->zstddctx);
+  store->zstddctx = 0;
+#endif
   if (store->pagefd != -1)
     close(store->pagefd);
   store->pagefd = -1;
@@ -629,6 +645,166 @@ void repopagestore_free(Repopagestore *store)
 
 /**********************************************************************/
 
+static unsigned int
+decompress_page(Repopagestore *store, const unsigned char *cpage, unsigned int len, unsigned char *page, unsigned int max)
+{
+#ifdef ENABLE_ZSTD_PAGES
+  if (store->zstdpages)
+    {
+      size_t r;
+      if (!store->zstddctx && !(store->zstddctx = ZSTD_createDCtx()))
+	return 0;
+      r = ZSTD_decompressDCtx(store->zstddctx, page, max, cpage, len);
+      return ZSTD_isError(r) ? 0 : (unsigned int)r;
+    }
+#endif
+  return unchecked_decompress_buf(cpage, len, page, max);
+}
+
+/* make room for at least NEED pages. The store also grows if the
+   page budget of the cache allows it, in that case the clock hand
+   is set to the new (unused) area. Once the store can hold all pages,
+   every page is mapped at its own page number, so ranges are always
+   consecutive and nothing needs to be evicted any more. Returns true
+   if it did grow.  */
+static int
+repopagestore_grow(Repopagestore *store, unsigned int need)
+{
+  Repopagecache *cache = store->cache;
+  unsigned int oldcan = store->nmapped;
+  unsigned int newcan = oldcan, i;
+
+  if (cache && oldcan < store->num_pages && cache->npages < cache->maxpages)
+    {
+      newcan = oldcan ? oldcan * 2 : 4;
+      if (newcan - oldcan > cache->maxpages - cache->npages)
+	newcan = oldcan + (cache->maxpages - cache->npages);
+      if (newcan > store->num_pages)
+	newcan = store->num_pages;
+    }
+  if (newcan < need)
+    newcan = need;
+  if (newcan < 4)
+    newcan = 4;
+  if (newcan <= oldcan)
+    return 0;
+  store->nmapped = newcan;
+  store->mapped = solv_realloc2(store->mapped, store->nmapped, sizeof(store->mapped[0]));
+  store->referenced = solv_realloc2(store->referenced, store->nmapped, sizeof(store->referenced[0]));
+  for (i = oldcan; i < store->nmapped; i++)
+    {
+      store->mapped[i] = -1;
+      store->referenced[i] = 0;
+    }
+  if (newcan >= store->num_pages && oldcan)
+    {
+      /* move the mapped pages to their own page number */
+      unsigned char *blob_store = solv_malloc2(store->nmapped, REPOPAGE_BLOBSIZE);
+      unsigned int pnum;
+      for (i = 0; i < oldcan; i++)
+	if ((pnum = store->mapped[i]) != -1)
+	  memcpy(blob_store + pnum * REPOPAGE_BLOBSIZE, store->blob_store + i * REPOPAGE_BLOBSIZE, REPOPAGE_BLOBSIZE);
+      for (pnum = 0; pnum < store->num_pages; pnum++)
+	if (store->mapped_at[pnum] != -1)
+	  store->mapped_at[pnum] = pnum * REPOPAGE_BLOBSIZE;
+      for (i = 0; i < store->nmapped; i++)
+	{
+	  store->mapped[i] = i < store->num_pages && store->mapped_at[i] != -1 ? i : -1;
+	  store->referenced[i] = store->mapped[i] != -1;
+	}
+      solv_free(store->blob_store);
+      store->blob_store = blob_store;
+    }
+  else
+    store->blob_store = solv_realloc2(store->blob_store, store->nmapped, REPOPAGE_BLOBSIZE);
+  store->clockhand = oldcan;
+  if (cache)
+    cache->npages += newcan - oldcan;
+#ifdef DEBUG_PAGING
+  fprintf(stderr, "PAGE: can map %d pages\n", store->nmapped);
+#endif
+  return 1;
+}
+
+/* find N consecutive logical pages that were not used since the
+   clock hand passed them the last time. Used pages get a second
+   chance, so this terminates after two rounds at most.  */
+static unsigned int
+repopagestore_clock_select(Repopagestore *store, unsigned int n)
+{
+  unsigned int i, best, hand = store->clockhand;
+
+  if (hand + n > store->nmapped && hand <= store->nmapped)
+    {
+      /* the unused pages at the end are too few, try to grow
+         instead of wrapping around */
+      for (i = hand; i < store->nmapped; i++)
+	if (store->mapped[i] != -1)
+	  break;
+      if (i == store->nmapped && repopagestore_grow(store, 0))
+	store->clockhand = hand;
+    }
+  for (;;)
+    {
+      best = store->clockhand;
+      if (best + n > store->nmapped)
+	best = 0;
+      store->clockhand = best + n;
+      for (i = best; i < best + n; i++)
+	if (store->mapped[i] != -1 && store->referenced[i])
+	  break;
+      if (i == best + n)
+	{
+	  /* no eviction needed if the pages are unused */
+	  for (i = best; i < best + n; i++)
+	    if (store->mapped[i] != -1)
+	      break;
+	  if (i == best + n || !repopagestore_grow(store, 0))
+	    return best;
+	  continue;	/* the clock hand now points to the new pages */
+	}
+      for (; i < best + n; i++)
+	store->referenced[i] = 0;
+    }
+}
+
+/* if the first (last) page of the range is already mapped and the
+   logical pages after (before) it are unused, map the range there.
+   This avoids copying pages around and leaving holes when reading
+   forward (backward). Returns -1 if this is not possible.  */
+static int
+repopagestore_extend_in_place(Repopagestore *store, unsigned int pstart, unsigned int pend)
+{
+  unsigned int i, n = pend - pstart + 1;
+  unsigned int at;
+
+  if ((at = store->mapped_at[pstart]) != -1)
+    {
+      at /= REPOPAGE_BLOBSIZE;
+      if (at + n <= store->nmapped)
+	{
+	  for (i = at + 1; i < at + n; i++)
+	    if (store->mapped[i] != -1)
+	      break;
+	  if (i == at + n)
+	    return at;
+	}
+    }
+  if ((at = store->mapped_at[pend]) != -1)
+    {
+      at /= REPOPAGE_BLOBSIZE;
+      if (at >= n - 1)
+	{
+	  for (i = at - (n - 1); i < at; i++)
+	    if (store->mapped[i] != -1)
+	      break;
+	  if (i == at)
+	    return at - (n - 1);
+	}
+    }
+  return -1;
+}
+
 unsigned char *
 repopagestore_load_page_range(Repopagestore *store, unsigned int pstart, unsigned int pend)
 {
@@ -641,7 +817,13 @@ repopagestore_load_page_range(Repopagestore *store, unsigned int pstart, unsigne
     {
       /* Quick check in case the requested page is already mapped */
       if (store->mapped_at[pstart] != -1)
-	return store->blob_store + store->mapped_at[pstart];
+	{
+	  if (store->referenced)
+	    store->referenced[store->mapped_at[pstart] / REPOPAGE_BLOBSIZE] = 1;
+	  if (store->cache)
+	    store->cache->hits++;
+	  return store->blob_store + store->mapped_at[pstart];
+	}
     }
   else
     {
@@ -653,7 +835,13 @@ repopagestore_load_page_range(Repopagestore *store, unsigned int pstart, unsigne
 		   != store->mapped_at[pnum-1] + REPOPAGE_BLOBSIZE))
 	  break;
       if (pnum > pend)
-	return store->blob_store + store->mapped_at[pstart];
+	{
+	  if (store->referenced)
+	    memset(store->referenced + store->mapped_at[pstart] / REPOPAGE_BLOBSIZE, 1, pend - pstart + 1);
+	  if (store->cache)
+	    store->cache->hits += pend - pstart + 1;
+	  return store->blob_store + store->mapped_at[pstart];
+	}
     }
 
   if (store->pagefd == -1 || !store->file_pages)
@@ -665,40 +853,22 @@ repopagestore_load_page_range(Repopagestore *store, unsigned int pstart, unsigne
 
   /* Ensure that we can map the numbers of pages we need at all.  */
   if (pend - pstart + 1 > store->nmapped)
-    {
-      unsigned int oldcan = store->nmapped;
-      store->nmapped = pend - pstart + 1;
-      if (store->nmapped < 4)
-        store->nmapped = 4;
-      store->mapped = solv_realloc2(store->mapped, store->nmapped, sizeof(store->mapped[0]));
-      for (i = oldcan; i < store->nmapped; i++)
-	store->mapped[i] = -1;
-      store->blob_store = solv_realloc2(store->blob_store, store->nmapped, REPOPAGE_BLOBSIZE);
-#ifdef DEBUG_PAGING
-      fprintf(stderr, "PAGE: can map %d pages\n", store->nmapped);
-#endif
-    }
-
-  if (store->mapped_at[pstart] != -1)
-    {
-      /* assume forward search */
-      best = store->mapped_at[pstart] / REPOPAGE_BLOBSIZE;
-      if (best + (pend - pstart) >= store->nmapped)
-	best = 0;
-    }
-  else if (store->mapped_at[pend] != -1)
-    {
-      /* assume backward search */
-      best = store->mapped_at[pend] / REPOPAGE_BLOBSIZE;
-      if (best < pend - pstart)
-	best = store->nmapped - 1;
-      best -= pend - pstart;
-    }
-  else
-    {
-      /* choose some "random" location to avoid thrashing */
-      best = (pstart + store->rr_counter++) % (store->nmapped - pend + pstart);
-    }
+    repopagestore_grow(store, pend - pstart + 1);
+
+  best = -1;
+  if (pstart != pend)
+    best = repopagestore_extend_in_place(store, pstart, pend);
+  if (best == -1)
+    best = repopagestore_clock_select(store, pend - pstart + 1);
+  if (store->nmapped >= store->num_pages)
+    best = pstart;	/* the store holds all pages, see repopagestore_grow */
+
+  /* only the pages that are already in place are hits, pages that
+     need to be copied around are not */
+  if (store->cache)
+    for (i = best, pnum = pstart; pnum <= pend; i++, pnum++)
+      if (store->mapped_at[pnum] == i * REPOPAGE_BLOBSIZE)
+	store->cache->hits++;
 
   /* So we want to map our pages from [best] to [best+pend-pstart].
      Use a very simple strategy, which doesn't make the best use of
@@ -718,6 +888,8 @@ repopagestore_load_page_range(Repopagestore *store, unsigned int pstart, unsigne
 #endif
 	  store->mapped[i] = -1;
 	  store->mapped_at[oldpnum] = -1;
+	  if (store->cache)
+	    store->cache->evictions++;
 	}
       /* check if we can copy the correct content (before it gets evicted) */
       pnum_mapped_at = store->mapped_at[pnum];
@@ -760,6 +932,8 @@ repopagestore_load_page_range(Repopagestore *store, unsigned int pstart, unsigne
 #ifdef DEBUG_PAGING
 	  fprintf(stderr, "PAGEIN: %d to %d", pnum, i);
 #endif
+	  if (store->cache)
+	    store->cache->misses++;
 #ifndef _WIN32
           if (pread(store->pagefd, compressed ? buf : dest, in_len, store->file_offset + p->page_offset) != in_len)
 	    {
@@ -779,7 +953,7 @@ repopagestore_load_page_range(Repopagestore *store, unsigned int pstart, unsigne
 	  if (compressed)
 	    {
 	      unsigned int out_len;
-	      out_len = unchecked_decompress_buf(buf, in_len, dest, REPOPAGE_BLOBSIZE);
+	      out_len = decompress_page(store, buf, in_len, dest, REPOPAGE_BLOBSIZE);
 	      if (out_len != REPOPAGE_BLOBSIZE && pnum < store->num_pages - 1)
 	        {
 #ifdef DEBUG_PAGING
@@ -797,6 +971,7 @@ repopagestore_load_page_range(Repopagestore *store, unsigned int pstart, unsigne
 	}
       store->mapped_at[pnum] = i * REPOPAGE_BLOBSIZE;
       store->mapped[i] = pnum;
+      store->referenced[i] = 1;
     }
   return store->blob_store + best * REPOPAGE_BLOBSIZE;
 }
@@ -804,25 +979,53 @@ repopagestore_load_page_range(Repopagestore *store, unsigned int pstart, unsigne
 struct s_PageCompressor {
   Ref htab[HS];
   Ref hnext[BLOCK_SIZE];
+#ifdef ENABLE_ZSTD_PAGES
+  ZSTD_CCtx *zstdcctx;
+  int zstdlevel;
+#endif
 };
 
 PageCompressor *
 pagecompressor_create()
 {
-  PageCompressor *comp = solv_malloc(sizeof(PageCompressor));
+  PageCompressor *comp = solv_calloc(1, sizeof(PageCompressor));
   return comp;
 }
 
 PageCompressor *
 pagecompressor_free(PageCompressor *comp)
 {
+#ifdef ENABLE_ZSTD_PAGES
+  if (comp->zstdcctx)
+    ZSTD_freeCCtx(comp->zstdcctx);
+#endif
   solv_free(comp);
   return 0;
 }
 
+int
+pagecompressor_set_zstd(PageCompressor *comp, int level)
+{
+#ifdef ENABLE_ZSTD_PAGES
+  if (!comp->zstdcctx && !(comp->zstdcctx = ZSTD_createCCtx()))
+    return 0;
+  comp->zstdlevel = level;
+  return 1;
+#else
+  return 0;
+#endif
+}
+
 unsigned int
 pagecompressor_compress(PageCompressor *comp, unsigned char *page, unsigned int len, unsigned char *cpage, unsigned int max)
 {
+#ifdef ENABLE_ZSTD_PAGES
+  if (comp->zstdcctx)
+    {
+      size_t r = ZSTD_compressCCtx(comp->zstdcctx, cpage, max, page, len, comp->zstdlevel);
+      return ZSTD_isError(r) ? 0 : (unsigned int)r;
+    }
+#endif
   return compress_buf(comp->htab, comp->hnext, page, len, cpage, max);
 }
 
@@ -947,7 +1150,7 @@ repopagestore_read_or_setup_pages(Repopagestore *store, FILE *fp, unsigned int p
 	    }
 	  if (compressed)
 	    {
-	      out_len = unchecked_decompress_buf(buf, in_len, dest, REPOPAGE_BLOBSIZE);
+	      out_len = decompress_page(store, buf, in_len, dest, REPOPAGE_BLOBSIZE);
 	      if (out_len != REPOPAGE_BLOBSIZE && i < npages - 1)
 	        {
 		  return SOLV_ERROR_CORRUPT;
@@ -961,8 +1164,15 @@ repopagestore_read_or_setup_pages(Repopagestore *store, FILE *fp, unsigned int p
 void
 repopagestore_disable_paging(Repopagestore *store)
 {
-  if (store->num_pages)
-    repopagestore_load_page_range(store, 0, store->num_pages - 1);
+  if (store->num_pages && !repopagestore_load_page_range(store, 0, store->num_pages - 1))
+    return;
+  /* all pages are loaded, so the store no longer takes part in the
+     eviction. This also makes lookups read-only, which the frozen
+     pool relies on.  */
+  if (store->cache && store->nmapped)
+    store->cache->npages -= store->nmapped;
+  store->cache = 0;
+  store->referenced = solv_free(store->referenced);
 }
 
 #ifdef STANDALONE
@@ -1023,6 +1233,21 @@ transfer_file(FILE * from, FILE * to, int compress)
     }
 }
 
+struct benchdata {
+  unsigned char *inb;
+  unsigned int in_len;
+  unsigned char *outb;
+  unsigned int out_len;
+  Ref *htab;
+  Ref *hnext;
+#ifdef ENABLE_ZSTD_PAGES
+  ZSTD_CCtx *cctx;
+  ZSTD_DCtx *dctx;
+  int level;
+#endif
+};
+
+#if 0
 /* Just for benchmarking purposes.  */
 static void
 dumb_memcpy(void *dest, const void *src, unsigned int len)
@@ -1034,51 +1259,47 @@ dumb_memcpy(void *dest, const void *src, unsigned int len)
 }
 
 static void
-benchmark(FILE * from)
+bench_memcpy(struct benchdata *bd)
 {
-  unsigned char inb[BLOCK_SIZE];
-  unsigned char outb[BLOCK_SIZE];
-  Ref htab[HS];
-  Ref hnext[BLOCK_SIZE];
-  unsigned int in_len = fread(inb, 1, BLOCK_SIZE, from);
-  unsigned int out_len;
-  if (!in_len)
-    {
-      perror("can't read from input");
-      exit(1);
-    }
+  dumb_memcpy(bd->outb, bd->inb, bd->in_len);
+}
+#endif
 
+static void
+bench_compress(struct benchdata *bd)
+{
+  compress_buf(bd->htab, bd->hnext, bd->inb, bd->in_len, bd->outb, BLOCK_SIZE);
+}
+
+static void
+bench_decompress(struct benchdata *bd)
+{
+  unchecked_decompress_buf(bd->outb, bd->out_len, bd->inb, BLOCK_SIZE);
+}
+
+#ifdef ENABLE_ZSTD_PAGES
+static void
+bench_zstd_compress(struct benchdata *bd)
+{
+  ZSTD_compressCCtx(bd->cctx, bd->outb, BLOCK_SIZE, bd->inb, bd->in_len, bd->level);
+}
+
+static void
+bench_zstd_decompress(struct benchdata *bd)
+{
+  ZSTD_decompressDCtx(bd->dctx, bd->inb, BLOCK_SIZE, bd->outb, bd->out_len);
+}
+#endif
+
+static void
+bench_run(const char *what, void (*fn)(struct benchdata *), struct benchdata *bd)
+{
   unsigned int calib_loop;
   unsigned int per_loop;
   unsigned int i, j;
   clock_t start, end;
   float seconds;
 
-#if 0
-  calib_loop = 1;
-  per_loop = 0;
-  start = clock();
-  while ((clock() - start) < CLOCKS_PER_SEC / 4)
-    {
-      calib_loop *= 2;
-      for (i = 0; i < calib_loop; i++)
-	dumb_memcpy(outb, inb, in_len);
-      per_loop += calib_loop;
-    }
-
-  fprintf(stderr, "memcpy:\nCalibrated to %d iterations per loop\n",
-	   per_loop);
-
-  start = clock();
-  for (i = 0; i < 10; i++)
-    for (j = 0; j < per_loop; j++)
-      dumb_memcpy(outb, inb, in_len);
-  end = clock();
-  seconds = (end - start) / (float) CLOCKS_PER_SEC;
-  fprintf(stderr, "%.2f seconds == %.2f MB/s\n", seconds,
-	   ((long long) in_len * per_loop * 10) / (1024 * 1024 * seconds));
-#endif
-
   calib_loop = 1;
   per_loop = 0;
   start = clock();
@@ -1086,46 +1307,70 @@ benchmark(FILE * from)
     {
       calib_loop *= 2;
       for (i = 0; i < calib_loop; i++)
-	compress_buf(htab, hnext, inb, in_len, outb, sizeof(outb));
+	fn(bd);
       per_loop += calib_loop;
     }
 
-  fprintf(stderr, "compression:\nCalibrated to %d iterations per loop\n",
-	   per_loop);
+  fprintf(stderr, "%s:\nCalibrated to %d iterations per loop\n",
+	   what, per_loop);
 
   start = clock();
   for (i = 0; i < 10; i++)
     for (j = 0; j < per_loop; j++)
-      compress_buf(htab, hnext, inb, in_len, outb, sizeof(outb));
+      fn(bd);
   end = clock();
   seconds = (end - start) / (float) CLOCKS_PER_SEC;
   fprintf(stderr, "%.2f seconds == %.2f MB/s\n", seconds,
-	   ((long long) in_len * per_loop * 10) / (1024 * 1024 * seconds));
-
-  out_len = compress_buf(htab, hnext, inb, in_len, outb, sizeof(outb));
+	   ((long long) bd->in_len * per_loop * 10) / (1024 * 1024 * seconds));
+}
 
-  calib_loop = 1;
-  per_loop = 0;
-  start = clock();
-  while ((clock() - start) < CLOCKS_PER_SEC / 4)
+static void
+benchmark(FILE * from, int level)
+{
+  unsigned char inb[BLOCK_SIZE];
+  unsigned char outb[BLOCK_SIZE];
+  Ref htab[HS];
+  Ref hnext[BLOCK_SIZE];
+  unsigned int in_len = fread(inb, 1, BLOCK_SIZE, from);
+  struct benchdata bd;
+  if (!in_len)
     {
-      calib_loop *= 2;
-      for (i = 0; i < calib_loop; i++)
-	unchecked_decompress_buf(outb, out_len, inb, sizeof(inb));
-      per_loop += calib_loop;
+      perror("can't read from input");
+      exit(1);
     }
 
-  fprintf(stderr, "decompression:\nCalibrated to %d iterations per loop\n",
-	   per_loop);
 
-  start = clock();
-  for (i = 0; i < 10; i++)
-    for (j = 0; j < per_loop; j++)
-      unchecked_decompress_buf(outb, out_len, inb, sizeof(inb));
-  end = clock();
-  seconds = (end - start) / (float) CLOCKS_PER_SEC;
-  fprintf(stderr, "%.2f seconds == %.2f MB/s\n", seconds,
-	   ((long long) in_len * per_loop * 10) / (1024 * 1024 * seconds));
+  memset(&bd, 0, sizeof(bd));
+  bd.inb = inb;
+  bd.in_len = in_len;
+  bd.outb = outb;
+  bd.htab = htab;
+  bd.hnext = hnext;
+#if 0
+  bench_run("memcpy", bench_memcpy, &bd);
+#endif
+  bench_run("compression", bench_compress, &bd);
+  bd.out_len = compress_buf(htab, hnext, inb, in_len, outb, sizeof(outb));
+  fprintf(stderr, "compressed %d to %d bytes\n", in_len, bd.out_len);
+  if (bd.out_len)
+    bench_run("decompression", bench_decompress, &bd);
+
+#ifdef ENABLE_ZSTD_PAGES
+  {
+    size_t r;
+    bd.cctx = ZSTD_createCCtx();
+    bd.dctx = ZSTD_createDCtx();
+    bd.level = level;
+    bench_run("zstd compression", bench_zstd_compress, &bd);
+    r = ZSTD_compressCCtx(bd.cctx, outb, sizeof(outb), inb, in_len, level);
+    bd.out_len = ZSTD_isError(r) ? 0 : (unsigned int)r;
+    fprintf(stderr, "zstd level %d compressed %d to %d bytes\n", level, in_len, bd.out_len);
+    if (bd.out_len)
+      bench_run("zstd decompression", bench_zstd_decompress, &bd);
+    ZSTD_freeCCtx(bd.cctx);
+    ZSTD_freeDCtx(bd.dctx);
+  }
+#endif
 }
 
 int
@@ -1135,7 +1380,7 @@ main(int argc, char *argv[])
   if (argc > 1 && !strcmp(argv[1], "-d"))
     compress = 0;
   if (argc > 1 && !strcmp(argv[1], "-b"))
-    benchmark(stdin);
+    benchmark(stdin, argc > 2 ? atoi(argv[2]) : 9);
   else
     transfer_file(stdin, stdout, compress);
   return 0;
@@ -20,6 +20,22 @@ typedef struct s_Attrblobpage
   unsigned int page_size;
 } Attrblobpage;
 
+/* the default budget of the page cache of a pool */
+#define REPOPAGECACHE_DEFAULT_SIZE (8 * 1024 * 1024)
+
+/* shared by all page stores of a pool. The cache is not thread
+   safe: a lookup returns a pointer into a page that stays valid until
+   the next lookup, so paged repodata must not be accessed from more
+   than one thread. pool_freeze() loads all pages and detaches the
+   stores from the cache. The counters are in pages.  */
+typedef struct s_Repopagecache {
+  unsigned int maxpages;	/* a store only grows while npages is below */
+  unsigned int npages;		/* pages allocated by all stores */
+  unsigned long long hits;	/* pages found in place */
+  unsigned long long misses;	/* pages read from the file */
+  unsigned long long evictions;	/* pages thrown out to make room */
+} Repopagecache;
+
 typedef struct s_Repopagestore {
   int pagefd;		/* file descriptor we're paging from */
   long file_offset;	/* pages in file start here */
@@ -38,7 +54,16 @@ typedef struct s_Repopagestore {
    otherwise it contains the page number (of the mapped page).  */
   unsigned int *mapped;
   unsigned int nmapped;
-  unsigned int rr_counter;
+
+  /* CLOCK eviction: referenced[i] is set when the page mapped at
+     logical page I got used since the hand passed it.  */
+  unsigned char *referenced;
+  unsigned int clockhand;
+
+  Repopagecache *cache;	/* budget and statistics, may be NULL */
+
+  int zstdpages;	/* compressed pages are zstd frames (SOLV_FLAG_ZSTD_PAGES) */
+  void *zstddctx;	/* decompression context for them */
 } Repopagestore;
 
 struct s_PageCompressor;
@@ -47,6 +72,8 @@ typedef struct s_PageCompressor PageCompressor;
 PageCompressor *pagecompressor_create(void);
 PageCompressor *pagecompressor_free(PageCompressor *comp);
 unsigned int pagecompressor_compress(PageCompressor *comp, unsigned char *page, unsigned int len, unsigned char *cpage, unsigned int max);
+/* switch the compressor to zstd, returns 0 if not supported */
+int pagecompressor_set_zstd(PageCompressor *comp, int level);
 
 
 void repopagestore_init(Repopagestore *store);
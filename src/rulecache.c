@@ -0,0 +1,437 @@
+/*
+ * Copyright (c) 2026, SUSE LLC
+ *
+ * This program is licensed under the BSD license, read LICENSE.BSD
+ * for further information
+ */
+
+/*
+ * rulecache.c
+ *
+ * write the package rules of a solver to a file and read them back
+ * into a new solver working on the same pool. This saves the pkg rule
+ * creation if many jobs get solved against an unchanged pool.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "solver.h"
+#include "solver_private.h"
+#include "pool.h"
+#include "repo.h"
+#include "chksum.h"
+#include "util.h"
+
+#define RULECACHE_MAGIC		0x534f4c52	/* 'SOLR' */
+#define RULECACHE_VERSION	2
+
+#define RULECACHE_COOKIE_IDENT	"rulecache 1"
+#define RULECACHE_JOBCOOKIE_IDENT	"rulecache job 1"
+
+#define RULES_BLOCK 63
+
+static inline void
+chksum_add_id(Chksum *chk, Id id)
+{
+  solv_chksum_add(chk, &id, sizeof(id));
+}
+
+static void
+chksum_add_idarray(Chksum *chk, Repo *repo, Offset off)
+{
+  Id *ids;
+  int n;
+  if (!off)
+    {
+      chksum_add_id(chk, 0);
+      return;
+    }
+  ids = repo->idarraydata + off;
+  for (n = 0; ids[n]; n++)
+    ;
+  solv_chksum_add(chk, ids, (n + 1) * sizeof(Id));
+}
+
+/*
+ * calculate a cookie over all the data that is used when the package
+ * rules get created. The cookie only matches if the Ids are the same,
+ * i.e. the pool was set up in exactly the same way.
+ */
+void
+solver_calc_pkgrules_cookie(Solver *solv, unsigned char *cookie)
+{
+  Pool *pool = solv->pool;
+  Chksum *chk = solv_chksum_create(REPOKEY_TYPE_SHA256);
+  Solvable *s;
+  Id p;
+
+  solv_chksum_add(chk, RULECACHE_COOKIE_IDENT, strlen(RULECACHE_COOKIE_IDENT));
+  /* ids */
+  chksum_add_id(chk, pool->ss.nstrings);
+  chksum_add_id(chk, pool->ss.sstrings);
+  solv_chksum_add(chk, pool->ss.strings, pool->ss.nstrings * sizeof(Offset));
+  solv_chksum_add(chk, pool->ss.stringspace, pool->ss.sstrings);
+  chksum_add_id(chk, pool->nrels);
+  solv_chksum_add(chk, pool->rels, pool->nrels * sizeof(Reldep));
+  /* pool settings */
+  chksum_add_id(chk, pool->disttype);
+  chksum_add_id(chk, pool->addedfileprovides);
+  chksum_add_id(chk, pool->forbidselfconflicts);
+  chksum_add_id(chk, pool->obsoleteusesprovides);
+  chksum_add_id(chk, pool->implicitobsoleteusesprovides);
+  chksum_add_id(chk, pool->obsoleteusescolors);
+  chksum_add_id(chk, pool->implicitobsoleteusescolors);
+  chksum_add_id(chk, pool->noinstalledobsoletes);
+  chksum_add_id(chk, pool->lastarch);
+  if (pool->id2arch)
+    solv_chksum_add(chk, pool->id2arch, pool->lastarch * sizeof(Id));
+  chksum_add_id(chk, pool->installed ? pool->installed->repoid : 0);
+  if (pool->considered)
+    solv_chksum_add(chk, pool->considered->map, pool->considered->size);
+  /* solver settings */
+  chksum_add_id(chk, solv->strongrecommends);
+  chksum_add_id(chk, solv->keepexplicitobsoletes);
+  /* solvables */
+  chksum_add_id(chk, pool->nsolvables);
+  for (p = 2, s = pool->solvables + p; p < pool->nsolvables; p++, s++)
+    {
+      if (!s->repo)
+	{
+	  chksum_add_id(chk, 0);
+	  continue;
+	}
+      chksum_add_id(chk, s->repo->repoid);
+      chksum_add_id(chk, s->repo->disabled);
+      chksum_add_id(chk, s->name);
+      chksum_add_id(chk, s->arch);
+      chksum_add_id(chk, s->evr);
+      chksum_add_id(chk, s->vendor);
+      chksum_add_idarray(chk, s->repo, s->provides);
+      chksum_add_idarray(chk, s->repo, s->obsoletes);
+      chksum_add_idarray(chk, s->repo, s->conflicts);
+      chksum_add_idarray(chk, s->repo, s->requires);
+      chksum_add_idarray(chk, s->repo, s->recommends);
+      chksum_add_idarray(chk, s->repo, s->suggests);
+      chksum_add_idarray(chk, s->repo, s->supplements);
+      chksum_add_idarray(chk, s->repo, s->enhances);
+    }
+  solv_chksum_free(chk, cookie);
+}
+
+static void
+chksum_add_map(Chksum *chk, Map *m)
+{
+  int size = m->size;
+  /* trailing zero bytes do not matter, an empty map is the same as no map */
+  while (size && !m->map[size - 1])
+    size--;
+  chksum_add_id(chk, size);
+  if (size)
+    solv_chksum_add(chk, m->map, size);
+}
+
+/*
+ * calculate a cookie over the job dependent solver state that is used
+ * when the package rules get created. solver_solve() compares it with
+ * the cookie of the kept pkg rules and throws them away if the job
+ * needs different rules.
+ */
+void
+solver_calc_pkgrules_jobcookie(Solver *solv, unsigned char *cookie)
+{
+  Chksum *chk = solv_chksum_create(REPOKEY_TYPE_SHA256);
+
+  solv_chksum_add(chk, RULECACHE_JOBCOOKIE_IDENT, strlen(RULECACHE_JOBCOOKIE_IDENT));
+  chksum_add_map(chk, &solv->multiversion);
+  chksum_add_id(chk, solv->fixmap_all);
+  chksum_add_map(chk, &solv->fixmap);
+  chksum_add_id(chk, solv->keepexplicitobsoletes);
+  chksum_add_id(chk, solv->strongrecommends);
+  solv_chksum_free(chk, cookie);
+}
+
+static void
+write_u32(FILE *fp, unsigned int x, int *errorp)
+{
+  unsigned char c[4];
+  if (*errorp)
+    return;
+  c[0] = x >> 24;
+  c[1] = x >> 16;
+  c[2] = x >> 8;
+  c[3] = x;
+  if (fwrite(c, 4, 1, fp) != 1)
+    *errorp = errno ? errno : EIO;
+}
+
+static void
+write_idqueue(FILE *fp, Queue *q, int *errorp)
+{
+  int i;
+  write_u32(fp, q ? q->count : 0, errorp);
+  for (i = 0; q && i < q->count; i++)
+    write_u32(fp, (unsigned int)q->elements[i], errorp);
+}
+
+static int
+rulecache_offset_cmp(const void *ap, const void *bp, void *dp)
+{
+  return *(Id *)ap - *(Id *)bp;
+}
+
+/*
+ * write the pkg rules and the data needed to recreate the addedmap
+ * to fp. The provider lists are written as literals, so that they
+ * do not depend on the state of the whatprovides data.
+ */
+int
+solver_write_pkgrules(Solver *solv, FILE *fp)
+{
+  Pool *pool = solv->pool;
+  unsigned char cookie[32];
+  Queue offq;
+  Rule *r;
+  Id rid, d, *dp;
+  int i, n, error = 0;
+
+  if (solv->pkgrules_end <= 1)
+    return pool_error(pool, -1, "solver_write_pkgrules: no pkg rules");
+  /* collect all different provider lists */
+  queue_init(&offq);
+  for (rid = 1, r = solv->rules + rid; rid < solv->pkgrules_end; rid++, r++)
+    {
+      d = r->d < 0 ? -r->d - 1 : r->d;
+      if (d)
+	queue_push(&offq, d);
+    }
+  solv_sort(offq.elements, offq.count, sizeof(Id), rulecache_offset_cmp, 0);
+  for (i = 0, d = 0; i < offq.count; i++)
+    if (!i || offq.elements[i] != offq.elements[d - 1])
+      offq.elements[d++] = offq.elements[i];
+  queue_truncate(&offq, d);
+
+  solver_calc_pkgrules_cookie(solv, cookie);
+  write_u32(fp, RULECACHE_MAGIC, &error);
+  write_u32(fp, RULECACHE_VERSION, &error);
+  if (!error && fwrite(cookie, 32, 1, fp) != 1)
+    error = errno ? errno : EIO;
+  if (!error && fwrite(solv->pkgrules_jobcookie, 32, 1, fp) != 1)
+    error = errno ? errno : EIO;
+  write_u32(fp, offq.count, &error);
+  for (i = 0; i < offq.count; i++)
+    {
+      dp = pool->whatprovidesdata + offq.elements[i];
+      for (d = 0; dp[d]; d++)
+	;
+      write_u32(fp, d, &error);
+      for (; *dp; dp++)
+	write_u32(fp, *dp, &error);
+    }
+  write_u32(fp, solv->pkgrules_end - 1, &error);
+  for (rid = 1, r = solv->rules + rid; rid < solv->pkgrules_end; rid++, r++)
+    {
+      d = r->d < 0 ? -r->d - 1 : r->d;
+      write_u32(fp, (unsigned int)r->p, &error);
+      if (d)
+	{
+	  int lo = 0, hi = offq.count - 1;
+	  while (lo < hi)
+	    {
+	      int mid = (lo + hi) / 2;
+	      if (offq.elements[mid] < d)
+		lo = mid + 1;
+	      else
+		hi = mid;
+	    }
+	  write_u32(fp, lo + 1, &error);
+	}
+      else
+	{
+	  write_u32(fp, 0, &error);
+	  write_u32(fp, (unsigned int)r->w2, &error);
+	}
+    }
+  write_idqueue(fp, &solv->addedmap_deduceq, &error);
+  write_idqueue(fp, solv->recommendsruleq, &error);
+  /* the buddies of the installed linked packages are set up together
+   * with the pkg rules */
+  n = solv->instbuddy && solv->installed ? solv->installed->end - solv->installed->start : 0;
+  write_u32(fp, n, &error);
+  for (i = 0; i < n; i++)
+    write_u32(fp, (unsigned int)solv->instbuddy[i], &error);
+  queue_free(&offq);
+  if (error)
+    return pool_error(pool, -1, "solver_write_pkgrules: write error: %s", strerror(error));
+  return 0;
+}
+
+static unsigned int
+read_u32(FILE *fp, int *errorp)
+{
+  unsigned char c[4];
+  if (*errorp)
+    return 0;
+  if (fread(c, 4, 1, fp) != 1)
+    {
+      *errorp = 1;
+      return 0;
+    }
+  return (unsigned int)c[0] << 24 | c[1] << 16 | c[2] << 8 | c[3];
+}
+
+static inline int
+valid_literal(Pool *pool, Id p)
+{
+  return p && p > -pool->nsolvables && p < pool->nsolvables;
+}
+
+/*
+ * read pkg rules written with solver_write_pkgrules. The solver must
+ * not have been used for solving yet. Fails if the pool does not
+ * match the one the rules were created with.
+ */
+int
+solver_read_pkgrules(Solver *solv, FILE *fp)
+{
+  Pool *pool = solv->pool;
+  unsigned char cookie[32], mycookie[32];
+  unsigned int nlists, nrules, n, i, j;
+  Id *lists = 0, p, d;
+  Queue q;
+  Rule *r;
+  int error = 0;
+
+  if (solv->nrules > 1 || solv->pkgrules_end)
+    return pool_error(pool, -1, "solver_read_pkgrules: solver already has rules");
+  if (!pool->whatprovides)
+    return pool_error(pool, -1, "solver_read_pkgrules: no whatprovides index");
+  if (read_u32(fp, &error) != RULECACHE_MAGIC || read_u32(fp, &error) != RULECACHE_VERSION)
+    return pool_error(pool, -1, "solver_read_pkgrules: not a rule cache");
+  if (fread(cookie, 32, 1, fp) != 1)
+    return pool_error(pool, -1, "solver_read_pkgrules: unexpected EOF");
+  solver_calc_pkgrules_cookie(solv, mycookie);
+  if (memcmp(cookie, mycookie, 32) != 0)
+    return pool_error(pool, -1, "solver_read_pkgrules: rule cache does not match the pool");
+  /* checked by solver_solve() once the job is known */
+  if (fread(solv->pkgrules_jobcookie, 32, 1, fp) != 1)
+    return pool_error(pool, -1, "solver_read_pkgrules: unexpected EOF");
+
+  /* read and internalize the provider lists */
+  nlists = read_u32(fp, &error);
+  if (error || nlists >= SOLV_MAX_INDEX)
+    return pool_error(pool, -1, "solver_read_pkgrules: bad list count");
+  lists = solv_calloc(nlists + 1, sizeof(Id));
+  queue_init(&q);
+  for (i = 0; i < nlists && !error; i++)
+    {
+      n = read_u32(fp, &error);
+      if (n < 2 || n >= (unsigned int)pool->nsolvables)
+	error = 1;
+      queue_empty(&q);
+      for (j = 0; j < n && !error; j++)
+	{
+	  p = (Id)read_u32(fp, &error);
+	  if (!valid_literal(pool, p))
+	    error = 1;
+	  queue_push(&q, p);
+	}
+      if (!error)
+	lists[i + 1] = solver_ids2whatprovides(solv, q.elements, q.count);
+    }
+  queue_free(&q);
+
+  nrules = read_u32(fp, &error);
+  if (error || nrules >= SOLV_MAX_INDEX)
+    {
+      solv_free(lists);
+      return pool_error(pool, -1, "solver_read_pkgrules: bad rule data");
+    }
+  solv->rules = solv_extend_resize(solv->rules, nrules + 1, sizeof(Rule), RULES_BLOCK);
+  for (i = 1; i <= nrules && !error; i++)
+    {
+      r = solv->rules + i;
+      memset(r, 0, sizeof(*r));
+      p = (Id)read_u32(fp, &error);
+      d = (Id)read_u32(fp, &error);
+      if (!valid_literal(pool, p) || d < 0 || (unsigned int)d > nlists)
+	{
+	  error = 1;
+	  break;
+	}
+      r->p = r->w1 = p;
+      if (d)
+	{
+	  r->d = lists[d];
+	  r->w2 = pool->whatprovidesdata[r->d];
+	}
+      else
+	{
+	  r->w2 = (Id)read_u32(fp, &error);
+	  if (r->w2 && !valid_literal(pool, r->w2))
+	    error = 1;
+	}
+    }
+  solv_free(lists);
+  if (!error)
+    {
+      n = read_u32(fp, &error);
+      for (i = 0; i < n && !error; i++)
+	{
+	  p = (Id)read_u32(fp, &error);
+	  if (!valid_literal(pool, p))
+	    error = 1;
+	  queue_push(&solv->addedmap_deduceq, p);
+	}
+    }
+  if (!error)
+    {
+      n = read_u32(fp, &error);
+      if (n && !error)
+	{
+	  solv->recommendsruleq = solv_calloc(1, sizeof(Queue));
+	  queue_init(solv->recommendsruleq);
+	}
+      for (i = 0; i < n && !error; i++)
+	{
+	  p = (Id)read_u32(fp, &error);
+	  if (p <= 0 || (unsigned int)p > nrules)
+	    error = 1;
+	  queue_push(solv->recommendsruleq, p);
+	}
+    }
+  if (!error)
+    {
+      n = read_u32(fp, &error);
+      if (n && !error && (!solv->installed || n != (unsigned int)(solv->installed->end - solv->installed->start)))
+	error = 1;
+      if (n && !error)
+	solv->instbuddy = solv_calloc(n, sizeof(Id));
+      for (i = 0; i < n && !error; i++)
+	{
+	  p = (Id)read_u32(fp, &error);
+	  if (p < 0 || p >= pool->nsolvables)
+	    error = 1;
+	  solv->instbuddy[i] = p;
+	}
+    }
+  if (error)
+    {
+      solv->instbuddy = solv_free(solv->instbuddy);
+      solver_shrinkrules(solv, 1);
+      queue_empty(&solv->addedmap_deduceq);
+      if (solv->recommendsruleq)
+	{
+	  queue_free(solv->recommendsruleq);
+	  solv->recommendsruleq = solv_free(solv->recommendsruleq);
+	}
+      return pool_error(pool, -1, "solver_read_pkgrules: bad rule data");
+    }
+  solv->nrules = nrules + 1;
+  solv->pkgrules_end = solv->nrules;
+  solv->lastpkgrule = 0;
+  POOL_DEBUG(SOLV_DEBUG_STATS, "read %d pkg rules from the rule cache\n", nrules);
+  return 0;
+}
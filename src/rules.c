@@ -381,7 +381,7 @@ makemultiversionconflict(Solver *solv, Id n, Id con)
   if (q.count == 1)
     n = 0;	/* no other package found, normal conflict handling */
   else
-    n = pool_queuetowhatprovides(pool, &q);
+    n = solver_queuetowhatprovides(solv, &q);
   queue_free(&q);
   return n;
 }
@@ -431,7 +431,7 @@ addlinks(Solver *solv, Solvable *s, Id req, Queue *qr, Id prv, Queue *qp, Map *m
   if (qr->count == 1)
     addpkgrule(solv, -(s - pool->solvables), qr->elements[0], 0, SOLVER_RULE_PKG_REQUIRES, req);
   else
-    addpkgrule(solv, -(s - pool->solvables), 0, pool_queuetowhatprovides(pool, qr), SOLVER_RULE_PKG_REQUIRES, req);
+    addpkgrule(solv, -(s - pool->solvables), 0, solver_queuetowhatprovides(solv, qr), SOLVER_RULE_PKG_REQUIRES, req);
   if (qp->count > 1)
     {
       int j;
@@ -441,7 +441,7 @@ addlinks(Solver *solv, Solvable *s, Id req, Queue *qr, Id prv, Queue *qp, Map *m
 	  for (j = i + 1; j < qp->count; j++)
 	    if (d != pool->solvables[qp->elements[j]].name)
 	      break;
-	  d = pool_ids2whatprovides(pool, qp->elements + i, j - i);
+	  d = solver_ids2whatprovides(solv, qp->elements + i, j - i);
 	  for (i = 0; i < qr->count; i++)
 	    addpkgrule(solv, -qr->elements[i], 0, d, SOLVER_RULE_PKG_REQUIRES, prv);
 	}
@@ -496,6 +496,24 @@ add_package_link(Solver *solv, Solvable *s, Map *m, Queue *workq)
 
 #endif
 
+/* lazy pkg rules: do not descend into the providers of a dependency
+ * that is already met by an installed package or by a package that
+ * we already have rules for. If the solver decides to install one of
+ * the other providers, it will get its rules in the next round. */
+static inline int
+lazy_skipproviders(Solver *solv, Id *dp, Map *m)
+{
+  Pool *pool = solv->pool;
+  Repo *installed = solv->installed;
+
+  if (!solv->lazypkgrules || solv->lazypkgrules_complete)
+    return 0;
+  for (; *dp; dp++)
+    if (MAPTST(m, *dp) || (installed && pool->solvables[*dp].repo == installed))
+      return 1;
+  return 0;
+}
+
 #ifdef ENABLE_COMPLEX_DEPS
 
 #ifdef SUSE
@@ -576,7 +594,7 @@ add_complex_deprules(Solver *solv, Id p, Id dep, int type, int dontfix, Queue *w
 	    continue;
 	  addpkgrule(solv, -p, 0, dp - pool->whatprovidesdata, type, dep);
 	  /* push all non-visited providers on the work queue */
-	  if (m)
+	  if (m && !lazy_skipproviders(solv, dp, m))
 	    for (; *dp; dp++)
 	      if (!MAPTST(m, *dp))
 		queue_push(workq, *dp);
@@ -653,7 +671,7 @@ add_complex_deprules(Solver *solv, Id p, Id dep, int type, int dontfix, Queue *w
 	      break;
 	  if (j < qcnt)
 	    continue;
-	  d = pool_ids2whatprovides(pool, qele + 1, qcnt - 1);
+	  d = solver_ids2whatprovides(solv, qele + 1, qcnt - 1);
 	  if (solv->ruleinfoq && qele[0] != p)
 	    {
 	      int oldcount = solv->ruleinfoq->count;
@@ -887,7 +905,7 @@ solver_addpkgrulesforsolvable(Solver *solv, Solvable *s, Map *m)
 	      addpkgrule(solv, -n, 0, dp - pool->whatprovidesdata, SOLVER_RULE_PKG_REQUIRES, req);
 
 	      /* push all non-visited providers on the work queue */
-	      if (m)
+	      if (m && !lazy_skipproviders(solv, dp, m))
 	        for (; *dp; dp++)
 		  if (!MAPTST(m, *dp))
 		    queue_push(&workq, *dp);
@@ -918,7 +936,7 @@ solver_addpkgrulesforsolvable(Solver *solv, Solvable *s, Map *m)
 	      if (dp[i])
 		continue;		/* provided by itself, no need to add rule */
 	      addpkgrule(solv, -n, 0, dp - pool->whatprovidesdata, SOLVER_RULE_PKG_RECOMMENDS, req);
-	      if (m)
+	      if (m && !lazy_skipproviders(solv, dp, m))
 	        for (; *dp; dp++)
 		  if (!MAPTST(m, *dp))
 		    queue_push(&workq, *dp);
@@ -1379,7 +1397,7 @@ solver_addfeaturerule(Solver *solv, Solvable *s)
     }
   if (qs.count > 1)
     {
-      Id d = pool_queuetowhatprovides(pool, &qs);
+      Id d = solver_queuetowhatprovides(solv, &qs);
       queue_free(&qs);
       solver_addrule(solv, p, 0, d);	/* allow update of s */
     }
@@ -1479,7 +1497,7 @@ solver_addupdaterule(Solver *solv, Solvable *s)
       if (i < qs.count)
 	{
 	  /* filter out all multiversion packages as they don't update */
-	  d = pool_queuetowhatprovides(pool, &qs);	/* save qs away */
+	  d = solver_queuetowhatprovides(solv, &qs);	/* save qs away */
 	  for (j = i; i < qs.count; i++)
 	     {
 	      if (MAPTST(&solv->multiversion, qs.elements[i]))
@@ -1534,7 +1552,7 @@ solver_addupdaterule(Solver *solv, Solvable *s)
     }
   if (qs.count > 1)
     {
-      d = pool_queuetowhatprovides(pool, &qs);
+      d = solver_queuetowhatprovides(solv, &qs);
       queue_free(&qs);
       solver_addrule(solv, p, 0, d);	/* allow update of s */
     }
@@ -1785,7 +1803,7 @@ solver_addinfarchrules(Solver *solv, Map *addedmap)
 	      if (lsq.count < 2)
 		solver_addrule(solv, -p, lsq.count ? lsq.elements[0] : 0, 0);
 	      else
-		solver_addrule(solv, -p, 0, pool_queuetowhatprovides(pool, &lsq));
+		solver_addrule(solv, -p, 0, solver_queuetowhatprovides(solv, &lsq));
 	    }
 	  else
 	    {
@@ -3628,7 +3646,7 @@ solver_addchoicerules(Solver *solv)
 	  if (i == q.count)
 	    continue;	/* already added that one */
 	}
-      d = q.count ? pool_queuetowhatprovides(pool, &q) : 0;
+      d = q.count ? solver_queuetowhatprovides(solv, &q) : 0;
 
       lastaddedp = r->p;
       lastaddedd = d;
@@ -3653,7 +3671,8 @@ solver_addchoicerules(Solver *solv)
   map_free(&m);
   map_free(&mneg);
   solv->choicerules_end = solv->nrules;
-  POOL_DEBUG(SOLV_DEBUG_STATS, "choice rule creation took %d ms\n", solv_timems(now));
+  solv->stats_choicerulestime = solv_timems(now);
+  POOL_DEBUG(SOLV_DEBUG_STATS, "choice rule creation took %d ms\n", solv->stats_choicerulestime);
 }
 
 /* called when a choice rule needs to be disabled by analyze_unsolvable.
@@ -3841,7 +3860,7 @@ solver_addbestrules(Solver *solv, int havebestinstalljobs, int haslockjob)
 		  if (q.count < 2)
 		    solver_addrule(solv, p2, q.count ? q.elements[0] : 0, 0);
 		  else
-		    solver_addrule(solv, p2, 0, pool_queuetowhatprovides(pool, &q));
+		    solver_addrule(solv, p2, 0, solver_queuetowhatprovides(solv, &q));
 		  if ((how & SOLVER_WEAK) != 0)
 		    queue_push(&solv->weakruleq, solv->nrules - 1);
 		  queue_push(&infoq, -(solv->jobrules + j));
@@ -3952,7 +3971,7 @@ solver_addbestrules(Solver *solv, int havebestinstalljobs, int haslockjob)
 	    {
 	      /* package is flagged both for allowuninstall and best, add negative rules */
 	      int rid;
-	      d = q.count == 1 ? q.elements[0] : -pool_queuetowhatprovides(pool, &q);
+	      d = q.count == 1 ? q.elements[0] : -solver_queuetowhatprovides(solv, &q);
 	      for (i = 0; i < q.count; i++)
 		MAPSET(&m, q.elements[i]);
 	      rid = solv->featurerules + (p - installed->start);
@@ -3982,7 +4001,7 @@ solver_addbestrules(Solver *solv, int havebestinstalljobs, int haslockjob)
 	  if (q.count < 2)
 	    solver_addrule(solv, p2, q.count ? q.elements[0] : 0, 0);
 	  else
-	    solver_addrule(solv, p2, 0, pool_queuetowhatprovides(pool, &q));
+	    solver_addrule(solv, p2, 0, solver_queuetowhatprovides(solv, &q));
 	  queue_push(&infoq, p);
 	}
       map_free(&m);
@@ -4206,7 +4225,7 @@ for (j = 0; j < qq.count; j++)
 		  if (k - groupstart == 1)
 		    solver_addrule(solv, -p, qq.elements[groupstart], 0);
 		  else
-		    solver_addrule(solv, -p, 0, pool_ids2whatprovides(pool, qq.elements + groupstart, k - groupstart));
+		    solver_addrule(solv, -p, 0, solver_ids2whatprovides(solv, qq.elements + groupstart, k - groupstart));
 		  queue_push(&infoq, qo.elements[i]);
 		}
 	      groupstart = k + 1;
@@ -4261,7 +4280,7 @@ solver_addrecommendsrules(Solver *solv)
       if (q.count == 2)
 	solver_addrule(solv, q.elements[0], q.elements[1], 0);
       else
-	solver_addrule(solv, q.elements[0], 0, pool_ids2whatprovides(pool, q.elements + 1, q.count - 1));
+	solver_addrule(solv, q.elements[0], 0, solver_ids2whatprovides(solv, q.elements + 1, q.count - 1));
       queue_push(&infoq, rid);
     }
   if (infoq.count)
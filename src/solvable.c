@@ -217,11 +217,14 @@ solvable_lookup_str_poollang(Solvable *s, Id keyname)
     return solvable_lookup_str(s, keyname);
   /* the languagecache caches the pool_id2langid result for all configured languages */
   row = pool_lookup_languagecache_row(pool, keyname);
-  for (i = 0; i < pool->nlanguages; i++, row++)
+  for (i = 0; i < pool->nlanguages; i++)
     {
-      if (!*row)
-        *row = pool_id2langid(pool, keyname, pool->languages[i], 1);
-      str = solvable_lookup_str_base(s, *row, keyname, 0);
+      Id id;
+      if (!row)
+	id = pool_id2langid(pool, keyname, pool->languages[i], 0);	/* frozen pool */
+      else if (!(id = row[i]))
+        id = row[i] = pool_id2langid(pool, keyname, pool->languages[i], 1);
+      str = id ? solvable_lookup_str_base(s, id, keyname, 0) : 0;
       if (str)
 	return str;
     }
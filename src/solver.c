@@ -21,6 +21,7 @@
 #include "solver_private.h"
 #include "bitmap.h"
 #include "pool.h"
+#include "pool_private.h"
 #include "util.h"
 #include "policy.h"
 #include "poolarch.h"
@@ -346,29 +347,98 @@ makeruledecisions(Solver *solv, int disablerules)
  * makewatches
  *
  * initial setup for all watches
+ *
+ * Every literal has an array of watchers, i.e. pairs of a rule id
+ * and a blocker literal. The blocker is some other literal of the
+ * rule, if it is true the rule is fulfilled and we do not need to
+ * look at the rule at all.
+ * New watchers are appended and the arrays are processed from the
+ * end, so the most recently added watchers are visited first.
  */
 
+static void
+freewatches(Solver *solv)
+{
+  int i;
+  Watchlist *wl;
+  if (!solv->watches)
+    return;
+  for (i = 0, wl = solv->watches; i < solv->nwatches; i++, wl++)
+    if (wl->watchers && (wl->watchers < solv->watchdata || wl->watchers >= solv->watchdata + solv->nwatchdata))
+      solv_free(wl->watchers);
+  solv->watches = solv_free(solv->watches);
+  solv->nwatches = 0;
+  solv->watchdata = solv_free(solv->watchdata);
+  solv->nwatchdata = 0;
+}
+
+static void
+growwatchlist(Solver *solv, Watchlist *wl)
+{
+  int alloc = wl->alloc ? wl->alloc * 2 : 8;
+  if (wl->watchers >= solv->watchdata && wl->watchers < solv->watchdata + solv->nwatchdata)
+    {
+      /* move out of the initial storage */
+      Id *watchers = solv_malloc2(alloc, sizeof(Id));
+      if (wl->count)
+        memcpy(watchers, wl->watchers, wl->count * sizeof(Id));
+      wl->watchers = watchers;
+    }
+  else
+    wl->watchers = solv_realloc2(wl->watchers, alloc, sizeof(Id));
+  wl->alloc = alloc;
+}
+
+static inline void
+addwatcher(Solver *solv, Watchlist *wl, Id rid, Id blocker)
+{
+  if (wl->count + 2 > wl->alloc)
+    growwatchlist(solv, wl);
+  wl->watchers[wl->count++] = rid;
+  wl->watchers[wl->count++] = blocker;
+}
+
 static void
 makewatches(Solver *solv)
 {
   Rule *r;
-  int i;
+  int i, n;
   int nsolvables = solv->pool->nsolvables;
+  Watchlist *watches;
+  Id *wd;
 
-  solv_free(solv->watches);
+  freewatches(solv);
   /* lower half for removals, upper half for installs */
-  solv->watches = solv_calloc(2 * nsolvables, sizeof(Id));
-  for (i = 1, r = solv->rules + solv->nrules - 1; i < solv->nrules; i++, r--)
+  solv->watches = solv_calloc(2 * nsolvables, sizeof(Watchlist));
+  solv->nwatches = 2 * nsolvables;
+  watches = solv->watches + nsolvables;
+  /* count the watchers of each literal */
+  for (i = 1, r = solv->rules + i, n = 0; i < solv->nrules; i++, r++)
     {
       if (!r->w2)		/* assertions do not need watches */
 	continue;
-
-      /* see addwatches_rule(solv, r) */
-      r->n1 = solv->watches[nsolvables + r->w1];
-      solv->watches[nsolvables + r->w1] = r - solv->rules;
-
-      r->n2 = solv->watches[nsolvables + r->w2];
-      solv->watches[nsolvables + r->w2] = r - solv->rules;
+      watches[r->w1].alloc += 2;
+      watches[r->w2].alloc += 2;
+      n += 4;
+    }
+  /* carve the lists out of one block, with room for a few more */
+  n += 2 * 2 * nsolvables;
+  solv->watchdata = wd = solv_malloc2(n, sizeof(Id));
+  solv->nwatchdata = n;
+  for (i = 0; i < solv->nwatches; i++)
+    if (solv->watches[i].alloc)
+      {
+	solv->watches[i].alloc += 2;
+	solv->watches[i].watchers = wd;
+	wd += solv->watches[i].alloc;
+      }
+  /* add in reverse order so that the rules get visited in order */
+  for (i = solv->nrules - 1, r = solv->rules + i; i > 0; i--, r--)
+    {
+      if (!r->w2)
+	continue;
+      addwatcher(solv, watches + r->w1, i, r->w2);
+      addwatcher(solv, watches + r->w2, i, r->w1);
     }
 }
 
@@ -384,13 +454,10 @@ makewatches(Solver *solv)
 static inline void
 addwatches_rule(Solver *solv, Rule *r)
 {
-  int nsolvables = solv->pool->nsolvables;
-
-  r->n1 = solv->watches[nsolvables + r->w1];
-  solv->watches[nsolvables + r->w1] = r - solv->rules;
+  Watchlist *watches = solv->watches + solv->pool->nsolvables;
 
-  r->n2 = solv->watches[nsolvables + r->w2];
-  solv->watches[nsolvables + r->w2] = r - solv->rules;
+  addwatcher(solv, watches + r->w1, r - solv->rules, r->w2);
+  addwatcher(solv, watches + r->w2, r - solv->rules, r->w1);
 }
 
 
@@ -424,12 +491,13 @@ static Rule *
 propagate(Solver *solv, int level)
 {
   Pool *pool = solv->pool;
-  Id *rp, *next_rp;           /* rule pointer, next rule pointer in linked list */
   Rule *r;                    /* rule */
-  Id p, pkg, other_watch;
-  Id *dp;
+  Id p, pkg, other_watch, rid, blocker;
+  Id *dp, *wp;
   Id *decisionmap = solv->decisionmap;
-  Id *watches = solv->watches + pool->nsolvables;   /* place ptr in middle */
+  Watchlist *watches = solv->watches + pool->nsolvables;   /* place ptr in middle */
+  Watchlist *wl;
+  int i, j;
 
   POOL_DEBUG(SOLV_DEBUG_PROPAGATE, "----- propagate level %d -----\n", level);
 
@@ -441,6 +509,7 @@ propagate(Solver *solv, int level)
        * negate because our watches trigger if literal goes FALSE
        */
       pkg = -solv->decisionq.elements[solv->propagate_index++];
+      solv->stats_propagations++;
 	
       IF_POOLDEBUG (SOLV_DEBUG_PROPAGATE)
         {
@@ -448,17 +517,28 @@ propagate(Solver *solv, int level)
 	  solver_printruleelement(solv, SOLV_DEBUG_PROPAGATE, 0, -pkg);
         }
 
-      /* foreach rule where 'pkg' is now FALSE */
-      for (rp = watches + pkg; *rp; rp = next_rp)
+      /* foreach rule where 'pkg' is now FALSE
+       * we go backwards through the watchers and compact the
+       * ones we keep towards the end of the array */
+      wl = watches + pkg;
+      wp = wl->watchers;
+      for (i = j = wl->count; i > 0; )
 	{
-	  r = solv->rules + *rp;
+	  blocker = wp[--i];
+	  rid = wp[--i];
+	  if (DECISIONMAP_TRUE(blocker))
+	    {
+	      /* rule is fulfilled, no need to look at it */
+	      wp[--j] = blocker;
+	      wp[--j] = rid;
+	      continue;
+	    }
+	  r = solv->rules + rid;
 	  if (r->d < 0)
 	    {
 	      /* rule is disabled, goto next */
-	      if (pkg == r->w1)
-	        next_rp = &r->n1;
-	      else
-	        next_rp = &r->n2;
+	      wp[--j] = blocker;
+	      wp[--j] = rid;
 	      continue;
 	    }
 
@@ -473,22 +553,17 @@ propagate(Solver *solv, int level)
 	   * may now be unit.
 	   */
 	  /* find the other watch */
-	  if (pkg == r->w1)
-	    {
-	      other_watch = r->w2;
-	      next_rp = &r->n1;
-	    }
-	  else
-	    {
-	      other_watch = r->w1;
-	      next_rp = &r->n2;
-	    }
+	  other_watch = pkg == r->w1 ? r->w2 : r->w1;
 
 	  /*
 	   * if the other watch is true we have nothing to do
 	   */
 	  if (DECISIONMAP_TRUE(other_watch))
-	    continue;
+	    {
+	      wp[--j] = other_watch;	/* use as new blocker */
+	      wp[--j] = rid;
+	      continue;
+	    }
 
 	  /*
 	   * The other literal is FALSE or UNDEF
@@ -540,32 +615,33 @@ propagate(Solver *solv, int level)
 			POOL_DEBUG(SOLV_DEBUG_WATCHES, "    -> move w%d to !%s\n", (pkg == r->w1 ? 1 : 2), pool_solvid2str(pool, -p));
 		    }
 
-		  *rp = *next_rp;
-		  next_rp = rp;
-
 		  if (pkg == r->w1)
-		    {
-		      r->w1 = p;
-		      r->n1 = watches[p];
-		    }
+		    r->w1 = p;
 		  else
-		    {
-		      r->w2 = p;
-		      r->n2 = watches[p];
-		    }
-		  watches[p] = r - solv->rules;
+		    r->w2 = p;
+		  addwatcher(solv, watches + p, rid, other_watch);
 		  continue;
 		}
 	      /* search failed, thus all unwatched literals are FALSE */
 		
 	    } /* not binary */
 
+	  /* we keep watching the rule */
+	  wp[--j] = other_watch;
+	  wp[--j] = rid;
+
           /*
 	   * unit clause found, set literal other_watch to TRUE
 	   */
 
 	  if (DECISIONMAP_FALSE(other_watch))	   /* check if literal is FALSE */
-	    return r;  		                   /* eek, a conflict! */
+	    {
+	      /* eek, a conflict! move the kept watchers down */
+	      if (j > i)
+		memmove(wp + i, wp + j, (wl->count - j) * sizeof(Id));
+	      wl->count -= j - i;
+	      return r;
+	    }
 
 	  IF_POOLDEBUG (SOLV_DEBUG_PROPAGATE)
 	    {
@@ -579,7 +655,7 @@ propagate(Solver *solv, int level)
 	    decisionmap[-other_watch] = -level;  /* remove! */
 
 	  queue_push(&solv->decisionq, other_watch);
-	  queue_push(&solv->decisionq_why, r - solv->rules);
+	  queue_push(&solv->decisionq_why, rid);
 
 	  IF_POOLDEBUG (SOLV_DEBUG_PROPAGATE)
 	    {
@@ -590,6 +666,14 @@ propagate(Solver *solv, int level)
 	    }
 
 	} /* foreach rule involving 'pkg' */
+
+      /* move the kept watchers down */
+      if (j)
+	{
+	  if (j < wl->count)
+	    memmove(wp, wp + j, (wl->count - j) * sizeof(Id));
+	  wl->count -= j;
+	}
 	
     } /* while we have non-decided decisions */
 
@@ -679,6 +763,7 @@ analyze(Solver *solv, int level, Rule *c, Rule **lrp)
   Id p = 0, pp, v, vv, why;
   int l, i, idx;
   int num = 0, l1num = 0;
+  int lbd;
   int learnt_why = solv->learnt_pool.count;
   Id *decisionmap = solv->decisionmap;
 
@@ -703,7 +788,9 @@ analyze(Solver *solv, int level, Rule *c, Rule **lrp)
 	  l = solv->decisionmap[vv];
 	  if (l < 0)
 	    l = -l;
-	  if (l == 1)
+	  /* with keeplearntrules we do not resolve away the level 1 literals,
+	   * as they may stem from the job */
+	  if (l == 1 && (!solv->keeplearntrules || vv == SYSTEMSOLVABLE))
 	    l1num++;			/* need to do this one in level1 pass */
 	  else if (l == level)
 	    num++;			/* need to do this one as well */
@@ -756,6 +843,22 @@ l1retry:
   map_free(&seen);
   assert(p != 0);
   assert(rlevel > 0 && rlevel < level);
+  /* calculate the literal block distance, i.e. the number of
+   * different decision levels in the new rule */
+  map_init(&seen, level + 1);
+  for (i = 0, lbd = 1; i < q.count; i++)
+    {
+      v = q.elements[i];
+      l = solv->decisionmap[v > 0 ? v : -v];
+      if (l < 0)
+	l = -l;
+      if (!MAPTST(&seen, l))
+	{
+	  MAPSET(&seen, l);
+	  lbd++;
+	}
+    }
+  map_free(&seen);
   IF_POOLDEBUG (SOLV_DEBUG_ANALYZE)
     {
       POOL_DEBUG(SOLV_DEBUG_ANALYZE, "learned rule for level %d (am %d)\n", rlevel, level);
@@ -778,17 +881,25 @@ l1retry:
     }
   else
     {
-      Id d = pool_queuetowhatprovides(pool, &q);
+      Id d = solver_queuetowhatprovides(solv, &q);
       queue_free(&q);
       r = solver_addrule(solv, p, 0, d);
     }
   assert(solv->learnt_why.count == (r - solv->rules) - solv->learntrules);
   queue_push(&solv->learnt_why, learnt_why);
+  queue_push(&solv->learnt_lbd, lbd);
+  solv->restart_conflicts++;
+  solv->lbd_sum += lbd;
+  if (solv->restart_conflicts == 1)
+    solv->lbd_fast = lbd << 8;
+  else
+    solv->lbd_fast += ((lbd << 8) - solv->lbd_fast) / 32;
   if (r->w2)
     {
       /* needs watches */
       watch2onhighest(solv, r);
       addwatches_rule(solv, r);
+      solv->learnt_active++;
     }
   else
     {
@@ -1061,6 +1172,248 @@ analyze_unsolvable(Solver *solv, Rule *cr, int disablerules)
 }
 
 
+/*-------------------------------------------------------------------
+ *
+ * restarts and learnt rule retirement
+ */
+
+/* the luby sequence 1 1 2 1 1 2 4 1 1 2 ... */
+static int
+luby(int x)
+{
+  int size, seq;
+  for (size = 1, seq = 0; size < x + 1; seq++)
+    size = 2 * size + 1;
+  while (size - 1 != x)
+    {
+      size = (size - 1) >> 1;
+      seq--;
+      x = x % size;
+    }
+  return 1 << (seq < 20 ? seq : 20);
+}
+
+static int
+restart_due(Solver *solv)
+{
+  int interval = solv->restartinterval;
+  switch (solv->restartpolicy)
+    {
+    case SOLVER_RESTART_LUBY:
+      return solv->restart_conflicts >= (interval ? interval : 32) * luby(solv->restart_luby);
+    case SOLVER_RESTART_GLUCOSE:
+      /* the minimal distance grows with every restart so that we
+       * are guaranteed to terminate */
+      if (solv->restart_conflicts < (interval ? interval : 50) + solv->stats_restarts)
+	return 0;
+      /* restart if the recently learnt rules are worse than the average */
+      return solv->lbd_fast * 0.8 > 256.0 * solv->lbd_sum / solv->stats_learned;
+    default:
+      return 0;
+    }
+}
+
+static int
+learntrule_retire_cmp(const void *ap, const void *bp, void *dp)
+{
+  Id a = *(Id *)ap;
+  Id b = *(Id *)bp;
+  Id *lbd = dp;
+  if (lbd[a] != lbd[b])
+    return lbd[b] - lbd[a];	/* worst first */
+  return a - b;			/* then oldest first */
+}
+
+/*
+ * retire the worse half of the learnt rules by removing them from the
+ * watch chains. We can't delete them as they may be part of the proof
+ * of other learnt rules or of problems, but they no longer slow down
+ * propagation. Rules with a lbd of 2 or less are always kept.
+ */
+static void
+retire_learntrules(Solver *solv)
+{
+  Pool *pool = solv->pool;
+  Id *lbd = solv->learnt_lbd.elements;
+  Watchlist *wl;
+  Id rid;
+  Queue q;
+  int i, j, k, n;
+
+  queue_init(&q);
+  for (i = 0; i < solv->learnt_lbd.count; i++)
+    if (lbd[i] > 2 && solv->rules[solv->learntrules + i].w2)
+      queue_push(&q, i);
+  n = solv->learnt_active / 2;
+  if (n > q.count)
+    n = q.count;
+  if (n)
+    {
+      solv_sort(q.elements, q.count, sizeof(Id), learntrule_retire_cmp, lbd);
+      for (i = 0; i < n; i++)
+	lbd[q.elements[i]] = 0;
+      for (k = 0, wl = solv->watches; k < solv->nwatches; k++, wl++)
+	{
+	  for (i = j = 0; i < wl->count; i += 2)
+	    {
+	      rid = wl->watchers[i];
+	      if (rid >= solv->learntrules && !lbd[rid - solv->learntrules])
+		continue;	/* drop watcher */
+	      wl->watchers[j++] = rid;
+	      wl->watchers[j++] = wl->watchers[i + 1];
+	    }
+	  wl->count = j;
+	}
+      solv->learnt_active -= n;
+      solv->stats_retired += n;
+    }
+  POOL_DEBUG(SOLV_DEBUG_ANALYZE, "retired %d learnt rules, %d still active\n", n, solv->learnt_active);
+  queue_free(&q);
+  solv->learnt_reducelimit = solv->learnt_active + solv->learntrulelimit;
+}
+
+/*
+ * remember the learnt rules that were derived from pkg rules only.
+ * They do not depend on the job, so the next solver_solve() call can
+ * add them again. We store the literals instead of the rules as
+ * the whatprovides data may be recreated in between. Format:
+ *   lbd nwhy why... nlits literals...
+ * where a why is either a pkg rule id or -n for the n-th kept rule.
+ */
+static void
+save_learntrules(Solver *solv)
+{
+  Pool *pool = solv->pool;
+  Queue *kq = &solv->learnt_keep;
+  Id *kept;
+  Id why, v, pp;
+  Rule *r;
+  int i, j, n, start, nkept = 0;
+
+  queue_empty(kq);
+  if (!solv->keeplearntrules || !solv->learntrules || solv->nrules <= solv->learntrules)
+    return;
+  n = solv->nrules - solv->learntrules;
+  kept = solv_calloc(n, sizeof(Id));
+  for (i = 0, r = solv->rules + solv->learntrules; i < n; i++, r++)
+    {
+      start = kq->count;
+      queue_push2(kq, solv->learnt_lbd.elements[i], 0);
+      for (j = solv->learnt_why.elements[i]; (why = solv->learnt_pool.elements[j]) != 0; j++)
+	{
+	  if (why > 0 && why < solv->pkgrules_end && !(solv->weakrulemap.size && MAPTST(&solv->weakrulemap, why)))
+	    queue_push(kq, why);
+	  else if (why >= solv->learntrules && why < solv->learntrules + i && kept[why - solv->learntrules])
+	    queue_push(kq, -kept[why - solv->learntrules]);
+	  else
+	    break;
+	}
+      if (why)
+	{
+	  queue_truncate(kq, start);	/* depends on the job */
+	  continue;
+	}
+      kq->elements[start + 1] = kq->count - start - 2;
+      start = kq->count;
+      queue_push(kq, 0);
+      FOR_RULELITERALS(v, pp, r)
+	queue_push(kq, v);
+      kq->elements[start] = kq->count - start - 1;
+      kept[i] = ++nkept;
+    }
+  solv_free(kept);
+  POOL_DEBUG(SOLV_DEBUG_STATS, "keeping %d of %d learnt rules\n", nkept, n);
+}
+
+/*
+ * add the kept learnt rules of the last run again. pkgmap maps the old
+ * pkg rule ids to the new ones, rules that depend on a pkg rule that
+ * went away are dropped.
+ */
+static void
+add_keptlearntrules(Solver *solv, Id *pkgmap, int npkgmap)
+{
+  Pool *pool = solv->pool;
+  Queue *kq = &solv->learnt_keep;
+  Queue newids, q;
+  Id *whys, *lits, why, d;
+  Rule *r;
+  int i, j, nwhy, nlits, lbd;
+
+  queue_init(&newids);
+  queue_init(&q);
+  for (i = 0; i < kq->count; i += 3 + nwhy + nlits)
+    {
+      lbd = kq->elements[i];
+      nwhy = kq->elements[i + 1];
+      whys = kq->elements + i + 2;
+      nlits = whys[nwhy];
+      lits = whys + nwhy + 1;
+      for (j = 0; j < nwhy; j++)
+	{
+	  why = whys[j];
+	  if (why > 0 ? (why >= npkgmap || !pkgmap[why]) : !newids.elements[-why - 1])
+	    break;
+	}
+      if (j < nwhy || !nlits)
+	{
+	  queue_push(&newids, 0);
+	  continue;
+	}
+      queue_push(&solv->learnt_why, solv->learnt_pool.count);
+      for (j = 0; j < nwhy; j++)
+	{
+	  why = whys[j];
+	  queue_push(&solv->learnt_pool, why > 0 ? pkgmap[why] : newids.elements[-why - 1]);
+	}
+      queue_push(&solv->learnt_pool, 0);
+      if (nlits < 3)
+	r = solver_addrule(solv, lits[0], nlits > 1 ? lits[1] : 0, 0);
+      else
+	{
+	  queue_empty(&q);
+	  queue_insertn(&q, 0, nlits - 1, lits + 1);
+	  d = solver_queuetowhatprovides(solv, &q);
+	  r = solver_addrule(solv, lits[0], 0, d);
+	}
+      queue_push(&newids, r - solv->rules);
+      queue_push(&solv->learnt_lbd, lbd ? lbd : nlits);
+      if (r->w2)
+	solv->learnt_active++;
+      solv->stats_keptlearnt++;
+    }
+  queue_free(&q);
+  queue_free(&newids);
+  queue_empty(kq);
+  POOL_DEBUG(SOLV_DEBUG_STATS, "added %d kept learnt rules\n", solv->stats_keptlearnt);
+}
+
+/*
+ * check if we ran out of time or the abort callback wants us to stop.
+ * This is called for every decision and conflict, so only do the real
+ * check every 16th time.
+ */
+static int
+check_abort(Solver *solv)
+{
+  Pool *pool = solv->pool;
+
+  if (solv->aborted)
+    return 1;
+  if (!solv->timeout && !solv->abortcallback)
+    return 0;
+  if ((++solv->abort_checkcnt & 15) != 0)
+    return 0;
+  if (solv->timeout && solv_timems(solv->abort_start) >= (unsigned int)solv->timeout)
+    solv->aborted = 1;
+  else if (solv->abortcallback && solv->abortcallback(solv, solv->abortcallbackdata))
+    solv->aborted = 1;
+  if (solv->aborted)
+    POOL_DEBUG(SOLV_DEBUG_SOLVER, "aborting the solver run\n");
+  return solv->aborted;
+}
+
+
 /*-------------------------------------------------------------------
  *
  * setpropagatelearn
@@ -1073,7 +1426,7 @@ analyze_unsolvable(Solver *solv, Rule *cr, int disablerules)
  * rule to learnt rule set, make decision from learnt
  * rule (always unit) and re-propagate.
  *
- * returns the new solver level or -1 if unsolvable
+ * returns the new solver level or -1 if unsolvable or aborted
  *
  */
 
@@ -1082,7 +1435,10 @@ setpropagatelearn(Solver *solv, int level, Id decision, int disablerules, Id rul
 {
   Pool *pool = solv->pool;
   Rule *r, *lr;
+  int conflicts = 0;
 
+  if (check_abort(solv))
+    return -1;
   if (decision)
     {
       level++;
@@ -1093,6 +1449,7 @@ setpropagatelearn(Solver *solv, int level, Id decision, int disablerules, Id rul
       queue_push(&solv->decisionq, decision);
       queue_push(&solv->decisionq_why, -ruleid);	/* <= 0 -> free decision */
       queue_push(&solv->decisionq_reason, reason);
+      solv->stats_decisions++;
     }
   assert(ruleid >= 0 && level > 0);
   for (;;)
@@ -1100,10 +1457,14 @@ setpropagatelearn(Solver *solv, int level, Id decision, int disablerules, Id rul
       r = propagate(solv, level);
       if (!r)
 	break;
+      solv->stats_conflicts++;
       if (level == 1)
 	return analyze_unsolvable(solv, r, disablerules);
+      if (check_abort(solv))
+	return -1;
       POOL_DEBUG(SOLV_DEBUG_ANALYZE, "conflict with rule #%d\n", (int)(r - solv->rules));
       level = analyze(solv, level, r, &lr);
+      conflicts++;
       /* the new rule is unit by design */
       decision = lr->p;
       solv->decisionmap[decision > 0 ? decision : -decision] = decision > 0 ? level : -level;
@@ -1117,6 +1478,21 @@ setpropagatelearn(Solver *solv, int level, Id decision, int disablerules, Id rul
 	  solver_printrule(solv, SOLV_DEBUG_ANALYZE, lr);
 	}
     }
+  if (!conflicts)
+    return level;
+  if (solv->learntrulelimit && solv->learnt_active > solv->learnt_reducelimit)
+    retire_learntrules(solv);
+  if (level > 1 && restart_due(solv))
+    {
+      /* we already backjumped, so our callers can deal with a
+       * restart at level 1 */
+      POOL_DEBUG(SOLV_DEBUG_ANALYZE, "restarting after %d conflicts (level %d)\n", solv->restart_conflicts, level);
+      revert(solv, 1);
+      level = 1;
+      solv->restart_conflicts = 0;
+      solv->restart_luby++;
+      solv->stats_restarts++;
+    }
   return level;
 }
 
@@ -1430,10 +1806,14 @@ solver_create(Pool *pool)
   queue_init(&solv->orphaned);
   queue_init(&solv->learnt_why);
   queue_init(&solv->learnt_pool);
+  queue_init(&solv->learnt_lbd);
+  queue_init(&solv->learnt_keep);
   queue_init(&solv->branches);
   queue_init(&solv->weakruleq);
   queue_init(&solv->ruleassertions);
   queue_init(&solv->addedmap_deduceq);
+  queue_init(&solv->lazypkgq);
+  queue_init(&solv->frozenblocks);
 
   queue_push(&solv->learnt_pool, 0);	/* so that 0 does not describe a proof */
 
@@ -1486,6 +1866,8 @@ solver_free(Solver *solv)
   queue_free(&solv->decisionq_reason);
   queue_free(&solv->learnt_why);
   queue_free(&solv->learnt_pool);
+  queue_free(&solv->learnt_lbd);
+  queue_free(&solv->learnt_keep);
   queue_free(&solv->problems);
   queue_free(&solv->solutions);
   queue_free(&solv->orphaned);
@@ -1493,6 +1875,10 @@ solver_free(Solver *solv)
   queue_free(&solv->weakruleq);
   queue_free(&solv->ruleassertions);
   queue_free(&solv->addedmap_deduceq);
+  queue_free(&solv->lazypkgq);
+  if (solv->frozenblocks.count && solv->pool->frozen)
+    pool_frozen_put_blocks(solv->pool, &solv->frozenblocks);
+  queue_free(&solv->frozenblocks);
   queuep_free(&solv->cleandeps_updatepkgs);
   queuep_free(&solv->cleandeps_mistakes);
   queuep_free(&solv->update_targets);
@@ -1522,7 +1908,7 @@ solver_free(Solver *solv)
   solv_free(solv->favormap);
   solv_free(solv->decisionmap);
   solv_free(solv->rules);
-  solv_free(solv->watches);
+  freewatches(solv);
   solv_free(solv->obsoletes);
   solv_free(solv->obsoletes_data);
   solv_free(solv->specialupdaters);
@@ -1581,6 +1967,18 @@ solver_get_flag(Solver *solv, int flag)
     return solv->focus_installed;
   case SOLVER_FLAG_FOCUS_NEW:
     return solv->focus_new;
+  case SOLVER_FLAG_RESTART_POLICY:
+    return solv->restartpolicy;
+  case SOLVER_FLAG_RESTART_INTERVAL:
+    return solv->restartinterval;
+  case SOLVER_FLAG_LEARNTRULE_LIMIT:
+    return solv->learntrulelimit;
+  case SOLVER_FLAG_TIMEOUT:
+    return solv->timeout;
+  case SOLVER_FLAG_KEEP_LEARNT_RULES:
+    return solv->keeplearntrules;
+  case SOLVER_FLAG_LAZY_PKGRULES:
+    return solv->lazypkgrules;
   case SOLVER_FLAG_FOCUS_BEST:
     return solv->focus_best;
   case SOLVER_FLAG_YUM_OBSOLETES:
@@ -1672,6 +2070,24 @@ solver_set_flag(Solver *solv, int flag, int value)
   case SOLVER_FLAG_FOCUS_NEW:
     solv->focus_new = value;
     break;
+  case SOLVER_FLAG_RESTART_POLICY:
+    solv->restartpolicy = value;
+    break;
+  case SOLVER_FLAG_RESTART_INTERVAL:
+    solv->restartinterval = value > 0 ? value : 0;
+    break;
+  case SOLVER_FLAG_LEARNTRULE_LIMIT:
+    solv->learntrulelimit = value > 0 ? value : 0;
+    break;
+  case SOLVER_FLAG_TIMEOUT:
+    solv->timeout = value > 0 ? value : 0;
+    break;
+  case SOLVER_FLAG_KEEP_LEARNT_RULES:
+    solv->keeplearntrules = value;
+    break;
+  case SOLVER_FLAG_LAZY_PKGRULES:
+    solv->lazypkgrules = value;
+    break;
   case SOLVER_FLAG_FOCUS_BEST:
     solv->focus_best = value;
     break;
@@ -1702,6 +2118,90 @@ solver_set_flag(Solver *solv, int flag, int value)
   return old;
 }
 
+int
+solver_get_stat(Solver *solv, int stat)
+{
+  switch (stat)
+  {
+  case SOLVER_STAT_SOLVE_TIME:
+    return solv->stats_solvetime;
+  case SOLVER_STAT_PKGRULES_TIME:
+    return solv->stats_pkgrulestime;
+  case SOLVER_STAT_CHOICERULES_TIME:
+    return solv->stats_choicerulestime;
+  case SOLVER_STAT_SAT_TIME:
+    return solv->stats_sattime;
+  case SOLVER_STAT_SOLUTIONS_TIME:
+    return solv->stats_solutionstime;
+  case SOLVER_STAT_RULES:
+    return solv->nrules ? solv->nrules - 1 : 0;
+  case SOLVER_STAT_PKG_RULES:
+    return solv->pkgrules_end ? solv->pkgrules_end - 1 : 0;
+  case SOLVER_STAT_FEATURE_RULES:
+    return solv->featurerules_end - solv->featurerules;
+  case SOLVER_STAT_UPDATE_RULES:
+    return solv->updaterules_end - solv->updaterules;
+  case SOLVER_STAT_JOB_RULES:
+    return solv->jobrules_end - solv->jobrules;
+  case SOLVER_STAT_INFARCH_RULES:
+    return solv->infarchrules_end - solv->infarchrules;
+  case SOLVER_STAT_DUP_RULES:
+    return solv->duprules_end - solv->duprules;
+  case SOLVER_STAT_BEST_RULES:
+    return solv->bestrules_end - solv->bestrules;
+  case SOLVER_STAT_YUMOBS_RULES:
+    return solv->yumobsrules_end - solv->yumobsrules;
+  case SOLVER_STAT_BLACK_RULES:
+    return solv->blackrules_end - solv->blackrules;
+  case SOLVER_STAT_STRICT_REPO_PRIORITY_RULES:
+    return solv->strictrepopriorules_end - solv->strictrepopriorules;
+  case SOLVER_STAT_CHOICE_RULES:
+    return solv->choicerules_end - solv->choicerules;
+  case SOLVER_STAT_RECOMMENDS_RULES:
+    return solv->recommendsrules_end - solv->recommendsrules;
+  case SOLVER_STAT_LEARNT_RULES:
+    return solv->learntrules ? solv->nrules - solv->learntrules : 0;
+  case SOLVER_STAT_DECISIONS:
+    return solv->stats_decisions;
+  case SOLVER_STAT_PROPAGATIONS:
+    return solv->stats_propagations;
+  case SOLVER_STAT_CONFLICTS:
+    return solv->stats_conflicts;
+  case SOLVER_STAT_UNSOLVABLE:
+    return solv->stats_unsolvable;
+  case SOLVER_STAT_RESTARTS:
+    return solv->stats_restarts;
+  case SOLVER_STAT_RETIRED_RULES:
+    return solv->stats_retired;
+  case SOLVER_STAT_PROBLEMS:
+    return solv->problems.count / 2;
+  case SOLVER_STAT_MAXRSS:
+    return solv->stats_maxrss;
+  case SOLVER_STAT_KEPT_LEARNT_RULES:
+    return solv->stats_keptlearnt;
+  case SOLVER_STAT_LAZY_ROUNDS:
+    return solv->stats_lazyrounds;
+  case SOLVER_STAT_REUSED_PKG_RULES:
+    return solv->stats_reusedpkgrules;
+  default:
+    break;
+  }
+  return -1;
+}
+
+void
+solver_setabortcallback(Solver *solv, int (*cb)(Solver *solv, void *cbdata), void *cbdata)
+{
+  solv->abortcallback = cb;
+  solv->abortcallbackdata = cbdata;
+}
+
+int
+solver_aborted(Solver *solv)
+{
+  return solv->aborted;
+}
+
 static int
 resolve_jobrules(Solver *solv, int level, int disablerules, Queue *dq)
 {
@@ -2104,6 +2604,8 @@ resolve_dependencies(Solver *solv, int level, int disablerules, Queue *dq)
       r = solv->rules + i;
       if (r->d < 0)		/* ignore disabled rules */
 	continue;
+      if (i >= solv->learntrules && !solv->learnt_lbd.elements[i - solv->learntrules])
+	continue;		/* ignore retired rules, they are not propagated */
       if (r->p < 0)		/* most common cases first */
 	{
 	  if (r->d == 0 || solv->decisionmap[-r->p] <= 0)
@@ -2884,6 +3386,8 @@ solver_run_sat(Solver *solv, int disablerules, int doweak)
   minimizationsteps = 0;
   for (;;)
     {
+      if (solv->aborted)
+	break;
       /*
        * initial propagation of the assertions
        */
@@ -3119,6 +3623,8 @@ solver_run_sat(Solver *solv, int disablerules, int doweak)
   assert(level == -1 || level + 1 == solv->decisionq_reason.count);
 
   POOL_DEBUG(SOLV_DEBUG_STATS, "solver statistics: %d learned rules, %d unsolvable, %d minimization steps\n", solv->stats_learned, solv->stats_unsolvable, minimizationsteps);
+  if (solv->stats_restarts || solv->stats_retired)
+    POOL_DEBUG(SOLV_DEBUG_STATS, "solver statistics: %d restarts, %d retired learnt rules\n", solv->stats_restarts, solv->stats_retired);
 
   POOL_DEBUG(SOLV_DEBUG_STATS, "done solving.\n\n");
   queue_free(&dq);
@@ -3561,7 +4067,7 @@ add_complex_jobrules(Solver *solv, Id dep, int flags, int jobidx, int weak)
       for (j = 0; bq.elements[i + j + 1]; j++)
         ;
       if (j > 1)
-        solver_addjobrule(solv, bq.elements[i], 0, pool_ids2whatprovides(pool, bq.elements + i + 1, j), jobidx, weak);
+        solver_addjobrule(solv, bq.elements[i], 0, solver_ids2whatprovides(solv, bq.elements + i + 1, j), jobidx, weak);
       else
         solver_addjobrule(solv, bq.elements[i], bq.elements[i + 1], 0, jobidx, weak);
       i += j + 1;
@@ -3643,14 +4149,49 @@ setup_favormap(Solver *solv)
     }
 }
 
+/* lazy pkg rules: queue the solvables the solver decided to install
+ * but that have no pkg rules yet. If the job is not solvable, create
+ * the complete closure instead, so that the problems and solutions are
+ * the same as with normal pkg rule creation. */
+static void
+lazypkgrules_nextround(Solver *solv, Map *addedmap)
+{
+  Pool *pool = solv->pool;
+  Rule *r;
+  Id p, pp;
+  int i;
+
+  queue_empty(&solv->lazypkgq);
+  if (solv->problems.count)
+    {
+      if (solv->lazypkgrules_complete)
+	return;
+      solv->lazypkgrules_complete = 1;
+      for (i = 1, r = solv->rules + i; i < solv->pkgrules_end; i++, r++)
+	FOR_RULELITERALS(p, pp, r)
+	  if (p > 0 && !MAPTST(addedmap, p))
+	    {
+	      MAPSET(addedmap, p);
+	      queue_push(&solv->lazypkgq, p);
+	    }
+      return;
+    }
+  for (i = 0; i < solv->decisionq.count; i++)
+    {
+      p = solv->decisionq.elements[i];
+      if (p > 0 && !MAPTST(addedmap, p))
+	queue_push(&solv->lazypkgq, p);
+    }
+}
+
 /*
  *
  * solve job queue
  *
  */
 
-int
-solver_solve(Solver *solv, Queue *job)
+static int
+solve_round(Solver *solv, Queue *job)
 {
   Pool *pool = solv->pool;
   Repo *installed = solv->installed;
@@ -3659,6 +4200,7 @@ solver_solve(Solver *solv, Queue *job)
   Map addedmap;		       /* '1' == have pkg-rules for solvable */
   Map installcandidatemap;
   Id how, what, select, name, weak, p, pp, d;
+  Id *pkgmap = 0;		/* old pkg rule id -> new id, for the kept learnt rules */
   Queue q;
   Solvable *s, *name_s;
   Rule *r;
@@ -3669,6 +4211,7 @@ solver_solve(Solver *solv, Queue *job)
   int haslockjob = 0;
   int hasblacklistjob = 0;
   int hasexcludefromweakjob = 0;
+  int lazyupdaters;
 
   solve_start = solv_timems(0);
 
@@ -3726,7 +4269,7 @@ solver_solve(Solver *solv, Queue *job)
   map_zerosize(&solv->weakrulemap);
   solv->favormap = solv_free(solv->favormap);
   queue_empty(&solv->weakruleq);
-  solv->watches = solv_free(solv->watches);
+  freewatches(solv);
   queue_empty(&solv->ruletojob);
   if (solv->decisionq.count)
     memset(solv->decisionmap, 0, pool->nsolvables * sizeof(Id));
@@ -3735,12 +4278,23 @@ solver_solve(Solver *solv, Queue *job)
   queue_empty(&solv->decisionq_reason);
   queue_empty(&solv->learnt_why);
   queue_empty(&solv->learnt_pool);
+  queue_empty(&solv->learnt_lbd);
   queue_empty(&solv->branches);
   solv->propagate_index = 0;
   queue_empty(&solv->problems);
   queue_empty(&solv->solutions);
   queue_empty(&solv->orphaned);
   solv->stats_learned = solv->stats_unsolvable = 0;
+  solv->stats_restarts = solv->stats_retired = 0;
+  solv->stats_keptlearnt = 0;
+  solv->stats_decisions = solv->stats_propagations = solv->stats_conflicts = 0;
+  solv->stats_pkgrulestime = solv->stats_choicerulestime = 0;
+  solv->stats_sattime = solv->stats_solutionstime = 0;
+  solv->restart_conflicts = solv->restart_luby = 0;
+  solv->lbd_fast = 0;
+  solv->lbd_sum = 0;
+  solv->learnt_active = 0;
+  solv->learnt_reducelimit = solv->learntrulelimit;
   if (solv->recommends_index)
     {
       map_empty(&solv->recommendsmap);
@@ -3781,6 +4335,9 @@ solver_solve(Solver *solv, Queue *job)
   solv->lastpkgrule = 0;
   solv->pkgrules_end = 0;
 
+  /* lazy mode: only create rules for the updaters of packages we update */
+  lazyupdaters = solv->lazypkgrules && !solv->lazypkgrules_complete;
+
   if (installed)
     {
       /* check for update/verify jobs as they need to be known early */
@@ -3896,6 +4453,9 @@ solver_solve(Solver *solv, Queue *job)
 		  MAPSET(&solv->allowuninstallmap, p - installed->start);
 		}
 	      break;
+	    case SOLVER_DISTUPGRADE:
+	      lazyupdaters = 0;	/* everything may get replaced */
+	      break;
 	    default:
 	      break;
 	    }
@@ -3904,13 +4464,44 @@ solver_solve(Solver *solv, Queue *job)
       if (solv->update_targets)
 	transform_update_targets(solv);
 
+      if (solv->updatemap_all)
+	lazyupdaters = 0;
+    }
+
+  /* the kept pkg rules must fit the multiversion and fix maps of this job */
+  if (initialnrules > 1)
+    {
+      unsigned char jobcookie[32];
+      solver_calc_pkgrules_jobcookie(solv, jobcookie);
+      if (memcmp(jobcookie, solv->pkgrules_jobcookie, 32) != 0)
+	{
+	  POOL_DEBUG(SOLV_DEBUG_STATS, "pkg rules were created for a different job, recreating them\n");
+	  solver_shrinkrules(solv, 1);
+	  initialnrules = 1;
+	  map_empty(&addedmap);
+	  MAPSET(&addedmap, SYSTEMSOLVABLE);
+	  queue_empty(&solv->addedmap_deduceq);
+	  queue_empty(&solv->learnt_keep);
+	  queuep_free(&solv->recommendsruleq);
+	  solv->instbuddy = solv_free(solv->instbuddy);
+	}
+    }
+  if (solv->stats_lazyrounds <= 1)
+    solv->stats_reusedpkgrules = initialnrules - 1;
+
+  if (installed)
+    {
       oldnrules = solv->nrules;
       FOR_REPO_SOLVABLES(installed, p, s)
 	solver_addpkgrulesforsolvable(solv, s, &addedmap);
       POOL_DEBUG(SOLV_DEBUG_STATS, "added %d pkg rules for installed solvables\n", solv->nrules - oldnrules);
       oldnrules = solv->nrules;
       FOR_REPO_SOLVABLES(installed, p, s)
-	solver_addpkgrulesforupdaters(solv, s, &addedmap, 1);
+	{
+	  if (lazyupdaters && !(solv->updatemap.size && MAPTST(&solv->updatemap, p - installed->start)))
+	    continue;
+	  solver_addpkgrulesforupdaters(solv, s, &addedmap, 1);
+	}
       POOL_DEBUG(SOLV_DEBUG_STATS, "added %d pkg rules for updaters of installed solvables\n", solv->nrules - oldnrules);
     }
 
@@ -3946,6 +4537,18 @@ solver_solve(Solver *solv, Queue *job)
     }
   POOL_DEBUG(SOLV_DEBUG_STATS, "added %d pkg rules for packages involved in a job\n", solv->nrules - oldnrules);
 
+  /*
+   * lazy mode: add rules for the packages the last round wanted to install
+   */
+  if (solv->lazypkgq.count)
+    {
+      oldnrules = solv->nrules;
+      for (i = 0; i < solv->lazypkgq.count; i++)
+	solver_addpkgrulesforsolvable(solv, pool->solvables + solv->lazypkgq.elements[i], &addedmap);
+      queue_empty(&solv->lazypkgq);
+      POOL_DEBUG(SOLV_DEBUG_STATS, "added %d pkg rules for lazily expanded packages\n", solv->nrules - oldnrules);
+    }
+
 
   /*
    * add rules for suggests, enhances
@@ -3981,16 +4584,37 @@ solver_solve(Solver *solv, Queue *job)
       POOL_DEBUG(SOLV_DEBUG_STATS, "%d of %d installable solvables considered for solving\n", possible, installable);
     }
 
+  if (solv->keeplearntrules && solv->learnt_keep.count)
+    {
+      pkgmap = solv_calloc(initialnrules, sizeof(Id));
+      for (i = 1; i < initialnrules; i++)
+	pkgmap[i] = i;
+      if (solv->nrules > initialnrules)
+	{
+	  /* unifying reorders the rules, use n1 to remember the old ids */
+	  for (i = 1, r = solv->rules + i; i < solv->nrules; i++, r++)
+	    r->n1 = i < initialnrules ? i : 0;
+	}
+    }
   if (solv->nrules > initialnrules)
     solver_unifyrules(solv);			/* remove duplicate pkg rules */
+  if (pkgmap && solv->nrules > initialnrules)
+    {
+      memset(pkgmap, 0, initialnrules * sizeof(Id));
+      for (i = 1, r = solv->rules + i; i < solv->nrules; i++, r++)
+	if (r->n1)
+	  pkgmap[r->n1] = i;
+    }
   solv->pkgrules_end = solv->nrules;		/* mark end of pkg rules */
   solv->lastpkgrule = 0;
+  solver_calc_pkgrules_jobcookie(solv, solv->pkgrules_jobcookie);
 
   if (solv->nrules > initialnrules)
     addedmap2deduceq(solv, &addedmap);		/* so that we can recreate the addedmap */
 
   POOL_DEBUG(SOLV_DEBUG_STATS, "pkg rule memory used: %d K\n", solv->nrules * (int)sizeof(Rule) / 1024);
-  POOL_DEBUG(SOLV_DEBUG_STATS, "pkg rule creation took %d ms\n", solv_timems(now));
+  solv->stats_pkgrulestime = solv_timems(now);
+  POOL_DEBUG(SOLV_DEBUG_STATS, "pkg rule creation took %d ms\n", solv->stats_pkgrulestime);
 
   /* create dup maps if needed. We need the maps early to create our
    * update rules */
@@ -4123,7 +4747,7 @@ solver_solve(Solver *solv, Queue *job)
 		  queue_push(&q, -SYSTEMSOLVABLE);
 		}
 	      p = queue_shift(&q);	/* get first candidate */
-	      d = !q.count ? 0 : pool_queuetowhatprovides(pool, &q);	/* internalize */
+	      d = !q.count ? 0 : solver_queuetowhatprovides(solv, &q);	/* internalize */
 	    }
 	  /* force install of namespace supplements hack */
 	  if (select == SOLVER_SOLVABLE_PROVIDES && !d && (p == SYSTEMSOLVABLE || p == -SYSTEMSOLVABLE) && ISRELDEP(what))
@@ -4371,7 +4995,6 @@ solver_solve(Solver *solv, Queue *job)
    */
 
   /* free unneeded memory */
-  map_free(&addedmap);
   map_free(&installcandidatemap);
   queue_free(&q);
 
@@ -4422,6 +5045,13 @@ solver_solve(Solver *solv, Queue *job)
   /* all new rules are learnt after this point */
   solv->learntrules = solv->nrules;
 
+  if (pkgmap)
+    {
+      add_keptlearntrules(solv, pkgmap, initialnrules);
+      solv->learnt_reducelimit = solv->learnt_active + solv->learntrulelimit;
+      pkgmap = solv_free(pkgmap);
+    }
+
   /* create watches chains */
   makewatches(solv);
 
@@ -4446,7 +5076,35 @@ solver_solve(Solver *solv, Queue *job)
 
   now = solv_timems(0);
   solver_run_sat(solv, 1, solv->dontinstallrecommended ? 0 : 1);
-  POOL_DEBUG(SOLV_DEBUG_STATS, "solver took %d ms\n", solv_timems(now));
+  solv->stats_sattime = solv_timems(now);
+  POOL_DEBUG(SOLV_DEBUG_STATS, "solver took %d ms\n", solv->stats_sattime);
+
+  /* remember the job independent learnt rules for the next run. We
+   * need to do this now as the whatprovides data may change */
+  save_learntrules(solv);
+
+  if (solv->aborted)
+    {
+      map_free(&addedmap);
+      /* do not leave a partial result around */
+      solver_reset(solv);
+      queue_empty(&solv->problems);
+      queue_empty(&solv->solutions);
+      solv->stats_solvetime = solv_timems(solve_start);
+      solv->stats_maxrss = solv_maxrss();
+      POOL_DEBUG(SOLV_DEBUG_STATS, "solver_solve aborted after %d ms\n", solv->stats_solvetime);
+      return -1;
+    }
+
+  /* lazy mode: check if we need another round */
+  if (solv->lazypkgrules)
+    lazypkgrules_nextround(solv, &addedmap);
+  map_free(&addedmap);
+  if (solv->lazypkgq.count)
+    {
+      POOL_DEBUG(SOLV_DEBUG_STATS, "lazy pkg rules: %d packages need rules%s\n", solv->lazypkgq.count, solv->lazypkgrules_complete ? ", creating the complete closure" : "");
+      return 0;
+    }
 
   /*
    * prepare solution queue if there were problems
@@ -4454,12 +5112,44 @@ solver_solve(Solver *solv, Queue *job)
   solver_prepare_solutions(solv);
 
   POOL_DEBUG(SOLV_DEBUG_STATS, "final solver statistics: %d problems, %d learned rules, %d unsolvable\n", solv->problems.count / 2, solv->stats_learned, solv->stats_unsolvable);
-  POOL_DEBUG(SOLV_DEBUG_STATS, "solver_solve took %d ms\n", solv_timems(solve_start));
+  solv->stats_solvetime = solv_timems(solve_start);
+  solv->stats_maxrss = solv_maxrss();
+  POOL_DEBUG(SOLV_DEBUG_STATS, "solver_solve took %d ms\n", solv->stats_solvetime);
 
   /* return number of problems */
   return solv->problems.count ? solv->problems.count / 2 : 0;
 }
 
+int
+solver_solve(Solver *solv, Queue *job)
+{
+  Pool *pool = solv->pool;
+  int r, start = solv_timems(0);
+  int pkgrulestime = 0, sattime = 0;
+
+  solv->aborted = 0;
+  solv->abort_start = start;
+  solv->abort_checkcnt = 0;
+  solv->lazypkgrules_complete = 0;
+  queue_empty(&solv->lazypkgq);
+  for (solv->stats_lazyrounds = 1;; solv->stats_lazyrounds++)
+    {
+      r = solve_round(solv, job);
+      pkgrulestime += solv->stats_pkgrulestime;
+      sattime += solv->stats_sattime;
+      if (!solv->lazypkgq.count)
+	break;
+    }
+  if (solv->stats_lazyrounds > 1)
+    {
+      solv->stats_pkgrulestime = pkgrulestime;
+      solv->stats_sattime = sattime;
+      solv->stats_solvetime = solv_timems(start);
+      POOL_DEBUG(SOLV_DEBUG_STATS, "solver_solve took %d ms in %d rounds\n", solv->stats_solvetime, solv->stats_lazyrounds);
+    }
+  return r;
+}
+
 Transaction *
 solver_create_transaction(Solver *solv)
 {
@@ -26,6 +26,15 @@
 extern "C" {
 #endif
 
+#ifdef LIBSOLV_INTERNAL
+/* the rules watching a literal */
+typedef struct s_Watchlist {
+  Id *watchers;				/* pairs of rule id and blocker literal */
+  int count;				/* number of ids used in watchers */
+  int alloc;				/* number of ids allocated */
+} Watchlist;
+#endif
+
 struct s_Solver {
   Pool *pool;				/* back pointer to pool */
   Queue job;				/* copy of the job we're solving */
@@ -108,11 +117,14 @@ struct s_Solver {
   Queue weakruleq;			/* index into 'rules' for weak ones */
   Map weakrulemap;			/* map rule# to '1' for weak rules, 1..learntrules */
 
-  Id *watches;				/* Array of rule offsets
+  Watchlist *watches;			/* Array of watcher lists
 					 * watches has nsolvables*2 entries and is addressed from the middle
-					 * middle-solvable : decision to conflict, offset point to linked-list of rules
-					 * middle+solvable : decision to install: offset point to linked-list of rules
+					 * middle-solvable : decision to conflict, rules watching the literal
+					 * middle+solvable : decision to install: rules watching the literal
 					 */
+  int nwatches;				/* number of entries in watches */
+  Id *watchdata;			/* initial storage of all watcher lists */
+  int nwatchdata;
 
   Queue ruletojob;                      /* index into job queue: jobs for which a rule exits */
 
@@ -129,6 +141,8 @@ struct s_Solver {
   /* learnt rule history */
   Queue learnt_why;
   Queue learnt_pool;
+  Queue learnt_lbd;			/* literal block distance of learnt rules, 0: retired */
+  Queue learnt_keep;			/* job independent learnt rules of the last run */
 
   Queue branches;
   int propagate_index;                  /* index into decisionq for non-propagated decisions */
@@ -140,6 +154,33 @@ struct s_Solver {
 
   int stats_learned;			/* statistic */
   int stats_unsolvable;			/* statistic */
+  int stats_restarts;			/* statistic */
+  int stats_retired;			/* statistic */
+  int stats_decisions;			/* statistic */
+  int stats_propagations;		/* statistic */
+  int stats_conflicts;			/* statistic */
+  int stats_solvetime;			/* statistic, times in ms */
+  int stats_pkgrulestime;
+  int stats_choicerulestime;
+  int stats_sattime;
+  int stats_solutionstime;
+  int stats_maxrss;			/* statistic, peak resident set size in kB */
+  int stats_keptlearnt;			/* statistic */
+  int stats_lazyrounds;			/* statistic */
+  int stats_reusedpkgrules;		/* statistic */
+
+  int restart_conflicts;		/* conflicts since the last restart */
+  int restart_luby;			/* position in the luby sequence */
+  int lbd_fast;				/* moving average of recent lbds, scaled by 256 */
+  unsigned int lbd_sum;			/* sum of the lbds of all learnt rules */
+  int learnt_active;			/* number of learnt rules in the watch chains */
+  int learnt_reducelimit;		/* retire learnt rules if we have more active ones */
+
+  int (*abortcallback)(struct s_Solver *solv, void *data);
+  void *abortcallbackdata;
+  int aborted;				/* true: solving was aborted */
+  unsigned int abort_start;		/* start of the timeout period */
+  int abort_checkcnt;			/* only check every 16th time */
 
   Map recommendsmap;			/* recommended packages from decisionmap */
   Map suggestsmap;			/* suggested packages from decisionmap */
@@ -180,6 +221,12 @@ struct s_Solver {
   int install_also_updates;		/* true: do not prune install job rules to installed packages */
   int only_namespace_recommended;	/* true: only install packages recommended by namespace */
   int strict_repo_priority;			/* true: only use packages from highest precedence/priority */
+  int restartpolicy;			/* SOLVER_RESTART_xxx */
+  int restartinterval;			/* base number of conflicts between restarts, 0: default */
+  int learntrulelimit;			/* retire learnt rules if we have more than this, 0: never */
+  int timeout;				/* abort solving after this many ms, 0: never */
+  int keeplearntrules;			/* true: keep job independent learnt rules for the next run */
+  int lazypkgrules;			/* true: only create pkg rules for packages that may get installed */
 
   int process_orphans;			/* true: do special orphan processing */
   Map dupmap;				/* dup to those packages */
@@ -205,6 +252,11 @@ struct s_Solver {
   Queue *installsuppdepq;		/* deps from the install namespace provides hack */
 
   Queue addedmap_deduceq;		/* deduce addedmap from pkg rules */
+  Queue lazypkgq;			/* lazy mode: create pkg rules for those in the next round */
+  int lazypkgrules_complete;		/* lazy mode: fall back to the complete closure */
+  Queue frozenblocks;			/* whatprovidesdata blocks we got from a frozen pool */
+  Offset frozenblockoff;		/* next free element in the current block */
+  int frozenblockleft;
   Id *instbuddy;			/* buddies of installed packages */
   int keep_orphans;			/* how to treat orphans */
   int break_orphans;			/* how to treat orphans */
@@ -222,6 +274,7 @@ struct s_Solver {
   int do_extra_reordering;		/* reorder for future installed packages */
 
   Queue *recommendsruleq;		/* pkg rules comming from recommends */
+  unsigned char pkgrules_jobcookie[32];	/* job state the pkg rules were created for */
 #endif	/* LIBSOLV_INTERNAL */
 };
 
@@ -339,6 +392,47 @@ typedef struct s_Solver Solver;
 #define SOLVER_FLAG_ONLY_NAMESPACE_RECOMMENDED	27
 #define SOLVER_FLAG_STRICT_REPO_PRIORITY	28
 #define SOLVER_FLAG_FOCUS_NEW			29
+#define SOLVER_FLAG_RESTART_POLICY		30
+#define SOLVER_FLAG_RESTART_INTERVAL		31
+#define SOLVER_FLAG_LEARNTRULE_LIMIT		32
+#define SOLVER_FLAG_TIMEOUT			33
+#define SOLVER_FLAG_KEEP_LEARNT_RULES		34
+#define SOLVER_FLAG_LAZY_PKGRULES		35
+
+#define SOLVER_RESTART_NONE			0
+#define SOLVER_RESTART_LUBY			1
+#define SOLVER_RESTART_GLUCOSE			2
+
+#define SOLVER_STAT_SOLVE_TIME			1
+#define SOLVER_STAT_PKGRULES_TIME		2
+#define SOLVER_STAT_CHOICERULES_TIME		3
+#define SOLVER_STAT_SAT_TIME			4
+#define SOLVER_STAT_SOLUTIONS_TIME		5
+#define SOLVER_STAT_RULES			6
+#define SOLVER_STAT_PKG_RULES			7
+#define SOLVER_STAT_FEATURE_RULES		8
+#define SOLVER_STAT_UPDATE_RULES		9
+#define SOLVER_STAT_JOB_RULES			10
+#define SOLVER_STAT_INFARCH_RULES		11
+#define SOLVER_STAT_DUP_RULES			12
+#define SOLVER_STAT_BEST_RULES			13
+#define SOLVER_STAT_YUMOBS_RULES		14
+#define SOLVER_STAT_BLACK_RULES			15
+#define SOLVER_STAT_STRICT_REPO_PRIORITY_RULES	16
+#define SOLVER_STAT_CHOICE_RULES		17
+#define SOLVER_STAT_RECOMMENDS_RULES		18
+#define SOLVER_STAT_LEARNT_RULES		19
+#define SOLVER_STAT_DECISIONS			20
+#define SOLVER_STAT_PROPAGATIONS		21
+#define SOLVER_STAT_CONFLICTS			22
+#define SOLVER_STAT_UNSOLVABLE			23
+#define SOLVER_STAT_RESTARTS			24
+#define SOLVER_STAT_RETIRED_RULES		25
+#define SOLVER_STAT_PROBLEMS			26
+#define SOLVER_STAT_MAXRSS			27
+#define SOLVER_STAT_KEPT_LEARNT_RULES		28
+#define SOLVER_STAT_LAZY_ROUNDS			29
+#define SOLVER_STAT_REUSED_PKG_RULES		30
 
 #define GET_USERINSTALLED_NAMES			(1 << 0)	/* package names instead of ids */
 #define GET_USERINSTALLED_INVERTED		(1 << 1)	/* autoinstalled */
@@ -364,6 +458,9 @@ extern int  solver_solve(Solver *solv, Queue *job);
 extern Transaction *solver_create_transaction(Solver *solv);
 extern int solver_set_flag(Solver *solv, int flag, int value);
 extern int solver_get_flag(Solver *solv, int flag);
+extern int solver_get_stat(Solver *solv, int stat);
+extern void solver_setabortcallback(Solver *solv, int (*cb)(Solver *solv, void *cbdata), void *cbdata);
+extern int  solver_aborted(Solver *solv);
 
 extern int  solver_get_decisionlevel(Solver *solv, Id p);
 extern void solver_get_decisionqueue(Solver *solv, Queue *decisionq);
@@ -396,6 +493,10 @@ extern void solver_create_state_maps(Solver *solv, Map *installedmap, Map *confl
 extern void solver_calc_duchanges(Solver *solv, DUChanges *mps, int nmps);
 extern int solver_calc_installsizechange(Solver *solv);
 
+extern void solver_calc_pkgrules_cookie(Solver *solv, unsigned char *cookie);
+extern int solver_write_pkgrules(Solver *solv, FILE *fp);
+extern int solver_read_pkgrules(Solver *solv, FILE *fp);
+
 extern void pool_job2solvables(Pool *pool, Queue *pkgs, Id how, Id what);
 extern int  pool_isemptyupdatejob(Pool *pool, Id how, Id what);
 
@@ -21,11 +21,20 @@ extern int solver_dep_possible_slow(Solver *solv, Id dep, Map *m);
 extern int solver_dep_fulfilled_cplx(Solver *solv, Reldep *rd);
 extern int solver_is_supplementing_alreadyinstalled(Solver *solv, Solvable *s);
 extern void solver_intersect_obsoleted(Solver *solv, Id p, Queue *q, int qstart, Map *m);
+extern Id solver_ids2whatprovides(Solver *solv, Id *ids, int count);
+
+static inline Id
+solver_queuetowhatprovides(Solver *solv, Queue *q)
+{
+  return solver_ids2whatprovides(solv, q->elements, q->count);
+}
 extern int solver_is_namespace_dep_slow(Solver *solv, Reldep *rd);
 
 extern void solver_createcleandepsmap(Solver *solv, Map *cleandepsmap, int unneeded);
 extern int solver_check_cleandeps_mistakes(Solver *solv);
 
+extern void solver_calc_pkgrules_jobcookie(Solver *solv, unsigned char *cookie);
+
 
 #define ISSIMPLEDEP(pool, dep) (!ISRELDEP(dep) || GETRELDEP(pool, dep)->flags < 8)
 
@@ -20,6 +20,7 @@
 #include "solver_private.h"
 #include "bitmap.h"
 #include "pool.h"
+#include "pool_private.h"
 #include "poolarch.h"
 #include "util.h"
 #include "evr.h"
@@ -468,3 +469,34 @@ solver_intersect_obsoleted(Solver *solv, Id p, Queue *q, int qstart, Map *m)
   queue_truncate(q, j);
 }
 
+
+/*
+ * like pool_ids2whatprovides, but the data of a frozen pool is put
+ * into blocks owned by the solver, so that it can be reused when the
+ * solver is freed.
+ */
+Id
+solver_ids2whatprovides(Solver *solv, Id *ids, int count)
+{
+  Pool *pool = solv->pool;
+  Offset off;
+
+  if (!pool->frozen)
+    return pool_ids2whatprovides(pool, ids, count);
+  if (count <= 0)
+    return 1;
+  if (count == 1 && *ids == SYSTEMSOLVABLE)
+    return 2;
+  if (solv->frozenblockleft < count + 1)
+    {
+      int size = count + 1;
+      solv->frozenblockoff = pool_frozen_get_block(pool, &size);
+      solv->frozenblockleft = size;
+      queue_push2(&solv->frozenblocks, solv->frozenblockoff, size);
+    }
+  off = solv->frozenblockoff;
+  pool_frozen_set_whatprovidesdata(pool, off, ids, count);
+  solv->frozenblockoff += count + 1;
+  solv->frozenblockleft -= count + 1;
+  return (Id)off;
+}
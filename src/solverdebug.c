@@ -98,7 +98,6 @@ solver_printrule(Solver *solv, int type, Rule *r)
 	break;
       solver_printruleelement(solv, type, r, v);
     }
-  POOL_DEBUG(type, "    next rules: %d %d\n", r->n1, r->n2);
 }
 
 void
@@ -166,11 +165,16 @@ void
 solver_printwatches(Solver *solv, int type)
 {
   Pool *pool = solv->pool;
-  int counter;
+  Watchlist *wl;
+  int counter, i, middle = solv->nwatches / 2;
 
   POOL_DEBUG(type, "Watches: \n");
-  for (counter = -(pool->nsolvables - 1); counter < pool->nsolvables; counter++)
-    POOL_DEBUG(type, "    solvable [%d] -- rule [%d]\n", counter, solv->watches[counter + pool->nsolvables]);
+  for (counter = -(middle - 1); counter < middle; counter++)
+    {
+      wl = solv->watches + counter + middle;
+      for (i = wl->count - 2; i >= 0; i -= 2)
+        POOL_DEBUG(type, "    solvable [%d] -- rule [%d] blocker [%d]\n", counter, wl->watchers[i], wl->watchers[i + 1]);
+    }
 }
 
 void
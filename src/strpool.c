@@ -14,6 +14,12 @@
 
 #define STRING_MAXSIZE 0x40000000
 
+/* the string hash table is followed by a byte array containing the
+ * top byte of the hash of every entry. This allows to skip most of
+ * the string compares when walking the hash chain. */
+#define STRINGHASH_TAGS(hashtbl, hashmask) ((unsigned char *)((hashtbl) + (hashmask) + 1))
+#define STRINGHASH_TAG(h) ((unsigned char)((h) >> 24))
+
 void
 stringpool_init(Stringpool *ss, const char *strs[])
 {
@@ -74,11 +80,21 @@ stringpool_clone(Stringpool *ss, Stringpool *from)
   ss->sstrings = from->sstrings;
 }
 
+static Hashtable
+alloc_stringhashtable(Hashval hashmask)
+{
+  if (hashmask == 0 || ((size_t)hashmask + 1) == 0)
+    solv_oom((size_t)hashmask, sizeof(Id) + 1);
+  return (Hashtable)solv_calloc((size_t)hashmask + 1, sizeof(Id) + 1);
+}
+
 static void
 stringpool_resize_hash(Stringpool *ss, int numnew)
 {
-  Hashval h, hh, hashmask;
+  Hashval r, h, hh, hashmask;
   Hashtable hashtbl;
+  unsigned char *tags;
+  const char *str;
   int i;
 
   if (numnew <= 0)
@@ -90,25 +106,39 @@ stringpool_resize_hash(Stringpool *ss, int numnew)
   /* realloc hash table */
   ss->stringhashmask = hashmask;
   solv_free(ss->stringhashtbl);
-  ss->stringhashtbl = hashtbl = allochashtable(hashmask, 1);
-  
+  ss->stringhashtbl = hashtbl = alloc_stringhashtable(hashmask);
+  tags = STRINGHASH_TAGS(hashtbl, hashmask);
+
   /* rehash all strings into new hashtable */
   for (i = 1; i < ss->nstrings; i++)
     {
-      h = strhash(ss->stringspace + ss->strings[i]) & hashmask;
+      str = ss->stringspace + ss->strings[i];
+      r = strnhash_words(str, strlen(str));
+      h = r & hashmask;
       hh = HASHCHAIN_START;
       while (hashtbl[h] != 0)
 	h = HASHCHAIN_NEXT(h, hh, hashmask);
       hashtbl[h] = i;
+      tags[h] = STRINGHASH_TAG(r);
     }
 }
 
+/* make sure that lookups do not need to create the hash */
+void
+stringpool_createhash(Stringpool *ss)
+{
+  if ((Hashval)ss->nstrings * 2 >= ss->stringhashmask)
+    stringpool_resize_hash(ss, STRING_BLOCK);
+}
+
 Id
 stringpool_strn2id(Stringpool *ss, const char *str, unsigned int len, int create)
 {
-  Hashval h, hh, hashmask;
+  Hashval r, h, hh, hashmask;
   Id id;
   Hashtable hashtbl;
+  unsigned char *tags, tag;
+  const char *sp;
 
   if (!str)
     return STRID_NULL;
@@ -136,15 +166,22 @@ stringpool_strn2id(Stringpool *ss, const char *str, unsigned int len, int create
       hashmask = ss->stringhashmask;
     }
   hashtbl = ss->stringhashtbl;
+  tags = STRINGHASH_TAGS(hashtbl, hashmask);
 
   /* compute hash and check for match */
-  h = strnhash(str, len) & hashmask;
+  r = strnhash_words(str, len);
+  tag = STRINGHASH_TAG(r);
+  h = r & hashmask;
   hh = HASHCHAIN_START;
   while ((id = hashtbl[h]) != 0)
     {
-      if(!memcmp(ss->stringspace + ss->strings[id], str, len)
-         && ss->stringspace[ss->strings[id] + len] == 0)
-	break;
+      /* check the terminator first, it is cheap and rejects different lengths */
+      if (tags[h] == tag && ss->strings[id] + len < ss->sstrings)
+	{
+	  sp = ss->stringspace + ss->strings[id];
+	  if (sp[len] == 0 && !memcmp(sp, str, len))
+	    break;
+	}
       h = HASHCHAIN_NEXT(h, hh, hashmask);
     }
   if (id || !create)    /* exit here if string found */
@@ -153,6 +190,7 @@ stringpool_strn2id(Stringpool *ss, const char *str, unsigned int len, int create
   /* generate next id and save in table */
   id = ss->nstrings++;
   hashtbl[h] = id;
+  tags[h] = tag;
 
   ss->strings = solv_extend(ss->strings, id, 1, sizeof(Offset), STRING_BLOCK);
   ss->strings[id] = ss->sstrings;	/* we will append to the end */
@@ -205,12 +243,14 @@ stringpool_integrate(Stringpool *ss, int numid, Offset sizeid, Id *idmap)
   Id id;
   int i, l;
   char *strsp, *sp;
-  Hashval hashmask, h, hh;
+  Hashval hashmask, r, h, hh;
   Hashtable hashtbl;
+  unsigned char *tags, tag;
 
   stringpool_resize_hash(ss, numid);
   hashtbl = ss->stringhashtbl;
   hashmask = ss->stringhashmask;
+  tags = STRINGHASH_TAGS(hashtbl, hashmask);
 
   /*
    * run over new strings and merge with pool.
@@ -236,25 +276,29 @@ stringpool_integrate(Stringpool *ss, int numid, Offset sizeid, Id *idmap)
 	  continue;
 	}
 
+      /* length == offset to next string */
+      l = strlen(sp) + 1;
+
       /* find hash slot */
-      h = strhash(sp) & hashmask;
+      r = strnhash_words(sp, l - 1);
+      tag = STRINGHASH_TAG(r);
+      h = r & hashmask;
       hh = HASHCHAIN_START;
       for (;;)
 	{
 	  id = hashtbl[h];
 	  if (!id)
 	    break;
-	  if (!strcmp(ss->stringspace + ss->strings[id], sp))
+	  if (tags[h] == tag && !memcmp(ss->stringspace + ss->strings[id], sp, l))
 	    break;			/* already in pool */
 	  h = HASHCHAIN_NEXT(h, hh, hashmask);
 	}
 
-      /* length == offset to next string */
-      l = strlen(sp) + 1;
       if (!id)				/* end of hash chain -> new string */
 	{
 	  id = ss->nstrings++;
 	  hashtbl[h] = id;
+	  tags[h] = tag;
 	  str[id] = ss->sstrings;	/* save offset */
 	  if (sp != ss->stringspace + ss->sstrings)
 	    memmove(ss->stringspace + ss->sstrings, sp, l);
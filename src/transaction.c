@@ -902,3 +902,26 @@ transaction_free(Transaction *trans)
   free(trans);
 }
 
+int
+transaction_get_stat(Transaction *trans, int stat)
+{
+  switch (stat)
+    {
+    case TRANSACTION_STAT_ORDER_TIME:
+      return trans->stats_ordertime;
+    case TRANSACTION_STAT_EDGE_TIME:
+      return trans->stats_edgetime;
+    case TRANSACTION_STAT_CYCLE_TIME:
+      return trans->stats_cycletime;
+    case TRANSACTION_STAT_ELEMENTS:
+      return trans->steps.count;
+    case TRANSACTION_STAT_EDGES:
+      return trans->stats_edges;
+    case TRANSACTION_STAT_CYCLES:
+      return trans->stats_cycles;
+    default:
+      break;
+    }
+  return -1;
+}
+
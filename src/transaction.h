@@ -36,6 +36,12 @@ typedef struct s_Transaction {
   Map multiversionmap;
 
   struct s_TransactionOrderdata *orderdata;
+
+  int stats_ordertime;		/* statistics of the last transaction_order call */
+  int stats_edgetime;
+  int stats_cycletime;
+  int stats_edges;
+  int stats_cycles;
 #endif
 
 } Transaction;
@@ -86,16 +92,26 @@ typedef struct s_Transaction {
 #define SOLVER_TRANSACTION_KEEP_ORDERDATA	(1 << 0)
 #define SOLVER_TRANSACTION_KEEP_ORDERCYCLES	(1 << 1)
 #define SOLVER_TRANSACTION_KEEP_ORDEREDGES	(1 << 2)
+#define SOLVER_TRANSACTION_ORDER_SCC		(1 << 3)
 
 /* cycle severities */
 #define SOLVER_ORDERCYCLE_HARMLESS		0
 #define SOLVER_ORDERCYCLE_NORMAL		1
 #define SOLVER_ORDERCYCLE_CRITICAL		2
 
+/* statistics */
+#define TRANSACTION_STAT_ORDER_TIME		1
+#define TRANSACTION_STAT_EDGE_TIME		2
+#define TRANSACTION_STAT_CYCLE_TIME		3
+#define TRANSACTION_STAT_ELEMENTS		4
+#define TRANSACTION_STAT_EDGES			5
+#define TRANSACTION_STAT_CYCLES			6
+
 extern Transaction *transaction_create(Pool *pool);
 extern Transaction *transaction_create_decisionq(Pool *pool, Queue *decisionq, Map *multiversionmap);
 extern Transaction *transaction_create_clone(Transaction *srctrans);
 extern void transaction_free(Transaction *trans);
+extern int  transaction_get_stat(Transaction *trans, int stat);
 
 /* if p is installed, returns with pkg(s) obsolete p */
 /* if p is not installed, returns with pkg(s) we obsolete */
@@ -17,6 +17,7 @@
   #include <io.h>
 #else
   #include <sys/time.h>
+  #include <sys/resource.h>
 #endif
 
 #include "util.h"
@@ -154,6 +155,24 @@ solv_timems(unsigned int subtract)
 #endif
 }
 
+/* peak resident set size of the process in kB, 0 if unknown */
+int
+solv_maxrss(void)
+{
+#ifdef _WIN32
+  return 0;
+#else
+  struct rusage ru;
+  if (getrusage(RUSAGE_SELF, &ru))
+    return 0;
+#ifdef __APPLE__
+  return (int)(ru.ru_maxrss / 1024);	/* bytes on macOS */
+#else
+  return (int)ru.ru_maxrss;
+#endif
+#endif
+}
+
 int
 solv_setcloexec(int fd, int state)
 {
@@ -0,0 +1,550 @@
+/*
+ * Copyright (c) 2026, SUSE LLC
+ *
+ * This program is licensed under the BSD license, read LICENSE.BSD
+ * for further information
+ */
+
+/*
+ * whatprovidescache.c
+ *
+ * write the whatprovides index and the added file provides state of
+ * a pool to a file and read them back into a pool that was set up
+ * in the same way. This saves the pool_addfileprovides() and
+ * pool_createwhatprovides() calls if the repositories did not change.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "pool.h"
+#include "pool_private.h"
+#include "repo.h"
+#include "chksum.h"
+#include "util.h"
+
+#define WHATPROVIDESCACHE_MAGIC		0x534f4c57	/* 'SOLW' */
+#define WHATPROVIDESCACHE_VERSION	2
+
+#define WHATPROVIDESCACHE_COOKIE_IDENT	"whatprovidescache 1"
+
+static inline void
+chksum_add_id(Chksum *chk, Id id)
+{
+  solv_chksum_add(chk, &id, sizeof(id));
+}
+
+/* the solvable data is collected in a queue to reduce the number of
+ * chksum calls */
+static inline void
+cookieq_push(Chksum *chk, Queue *q, Id id)
+{
+  queue_push(q, id);
+  if (q->count >= 8192)
+    {
+      solv_chksum_add(chk, q->elements, q->count * sizeof(Id));
+      queue_empty(q);
+    }
+}
+
+/* the file provides behind the marker are added by
+ * pool_addfileprovides(), so they are not part of the input */
+static void
+cookieq_push_provides(Chksum *chk, Queue *q, Repo *repo, Offset off)
+{
+  Id *ids;
+  if (off)
+    for (ids = repo->idarraydata + off; *ids && *ids != SOLVABLE_FILEMARKER; ids++)
+      cookieq_push(chk, q, *ids);
+  cookieq_push(chk, q, 0);
+}
+
+/*
+ * calculate a cookie over all the data that is used when the
+ * whatprovides index gets created. The cookie describes the pool
+ * before pool_addfileprovides() is called: the added file provides
+ * and the added file provides state are not included, as they are
+ * part of the cached data. So the cookie does not change when
+ * pool_addfileprovides() is called.
+ */
+void
+pool_calc_whatprovides_cookie(Pool *pool, unsigned char *cookie)
+{
+  Chksum *chk = solv_chksum_create(REPOKEY_TYPE_SHA256);
+  Solvable *s;
+  Queue q;
+  Id p;
+
+  solv_chksum_add(chk, WHATPROVIDESCACHE_COOKIE_IDENT, strlen(WHATPROVIDESCACHE_COOKIE_IDENT));
+  /* ids */
+  chksum_add_id(chk, pool->ss.nstrings);
+  chksum_add_id(chk, pool->ss.sstrings);
+  solv_chksum_add(chk, pool->ss.strings, pool->ss.nstrings * sizeof(Offset));
+  solv_chksum_add(chk, pool->ss.stringspace, pool->ss.sstrings);
+  chksum_add_id(chk, pool->nrels);
+  solv_chksum_add(chk, pool->rels, pool->nrels * sizeof(Reldep));
+  /* pool settings */
+  chksum_add_id(chk, pool->disttype);
+  chksum_add_id(chk, pool->promoteepoch);
+  chksum_add_id(chk, pool->havedistepoch);
+  chksum_add_id(chk, pool->addfileprovidesfiltered);
+  chksum_add_id(chk, pool->nowhatprovidesaux);
+  chksum_add_id(chk, pool->whatprovideswithdisabled);
+  chksum_add_id(chk, pool->lastarch);
+  if (pool->id2arch)
+    solv_chksum_add(chk, pool->id2arch, pool->lastarch * sizeof(Id));
+  chksum_add_id(chk, pool->installed ? pool->installed->repoid : 0);
+  if (pool->considered)
+    solv_chksum_add(chk, pool->considered->map, pool->considered->size);
+  /* solvables */
+  chksum_add_id(chk, pool->nsolvables);
+  queue_init(&q);
+  for (p = 2, s = pool->solvables + p; p < pool->nsolvables; p++, s++)
+    {
+      if (!s->repo)
+	{
+	  cookieq_push(chk, &q, 0);
+	  continue;
+	}
+      cookieq_push(chk, &q, s->repo->repoid);
+      cookieq_push(chk, &q, s->repo->disabled);
+      cookieq_push(chk, &q, s->name);
+      cookieq_push(chk, &q, s->arch);
+      cookieq_push(chk, &q, s->evr);
+      cookieq_push_provides(chk, &q, s->repo, s->provides);
+    }
+  if (q.count)
+    solv_chksum_add(chk, q.elements, q.count * sizeof(Id));
+  queue_free(&q);
+  solv_chksum_free(chk, cookie);
+}
+
+/* the payload after the cookie is protected by a checksum */
+struct cachefile {
+  FILE *fp;
+  Chksum *chk;
+  int error;
+};
+
+static void
+write_u32(struct cachefile *cf, unsigned int x)
+{
+  unsigned char c[4];
+  if (cf->error)
+    return;
+  c[0] = x >> 24;
+  c[1] = x >> 16;
+  c[2] = x >> 8;
+  c[3] = x;
+  solv_chksum_add(cf->chk, c, 4);
+  if (fwrite(c, 4, 1, cf->fp) != 1)
+    cf->error = errno ? errno : EIO;
+}
+
+static unsigned int
+read_u32(struct cachefile *cf)
+{
+  unsigned char c[4];
+  if (cf->error)
+    return 0;
+  if (fread(c, 4, 1, cf->fp) != 1)
+    {
+      cf->error = 1;
+      return 0;
+    }
+  solv_chksum_add(cf->chk, c, 4);
+  return (unsigned int)c[0] << 24 | c[1] << 16 | c[2] << 8 | c[3];
+}
+
+static void
+write_u32_array(struct cachefile *cf, const Id *ids, unsigned int n)
+{
+  unsigned char buf[4096], *bp;
+  unsigned int i, x;
+
+  while (n && !cf->error)
+    {
+      for (i = 0, bp = buf; i < n && i < sizeof(buf) / 4; i++, bp += 4)
+	{
+	  x = ids[i];
+	  bp[0] = x >> 24;
+	  bp[1] = x >> 16;
+	  bp[2] = x >> 8;
+	  bp[3] = x;
+	}
+      solv_chksum_add(cf->chk, buf, i * 4);
+      if (fwrite(buf, 4, i, cf->fp) != i)
+	cf->error = errno ? errno : EIO;
+      ids += i;
+      n -= i;
+    }
+}
+
+static void
+read_u32_array(struct cachefile *cf, Id *ids, unsigned int n)
+{
+  unsigned char buf[4096], *bp;
+  unsigned int i, l;
+
+  while (n && !cf->error)
+    {
+      l = n < sizeof(buf) / 4 ? n : sizeof(buf) / 4;
+      if (fread(buf, 4, l, cf->fp) != l)
+	{
+	  cf->error = 1;
+	  return;
+	}
+      solv_chksum_add(cf->chk, buf, l * 4);
+      for (i = 0, bp = buf; i < l; i++, bp += 4)
+	ids[i] = (unsigned int)bp[0] << 24 | bp[1] << 16 | bp[2] << 8 | bp[3];
+      ids += l;
+      n -= l;
+    }
+}
+
+/* add the provider list at off to the new data, return the new offset */
+static Offset
+cache_list(Pool *pool, Offset off, Offset *newoff, Queue *data)
+{
+  Id *dp;
+
+  if (off < 4)
+    return off;		/* lazy, empty, system solvable */
+  if (newoff[off])
+    return newoff[off];
+  newoff[off] = data->count;
+  for (dp = pool->whatprovidesdata + off; *dp; dp++)
+    queue_push(data, *dp);
+  queue_push(data, 0);
+  return newoff[off];
+}
+
+/*
+ * find the relations whose providers depend on the namespace
+ * callback or on the file lists, i.e. on data that is not part of
+ * the cookie. Their providers are not cached.
+ */
+static void
+uncached_rels(Pool *pool, Map *m)
+{
+  Id id, name, evr;
+  Reldep *rd;
+
+  map_init(m, pool->nrels);
+  for (id = 1, rd = pool->rels + id; id < pool->nrels; id++, rd++)
+    {
+      name = rd->name;
+      evr = rd->evr;
+      if (rd->flags == REL_NAMESPACE || rd->flags == REL_CONDA)
+	MAPSET(m, id);
+      else if (!ISRELDEP(name) && pool_islazyfileprovides(pool, name))
+	MAPSET(m, id);
+      else if (!ISRELDEP(evr) && evr && rd->flags >= 8 && pool_islazyfileprovides(pool, evr))
+	MAPSET(m, id);
+      else if (ISRELDEP(name) && (GETRELID(name) >= id || MAPTST(m, GETRELID(name))))
+	MAPSET(m, id);
+      else if (ISRELDEP(evr) && (GETRELID(evr) >= id || MAPTST(m, GETRELID(evr))))
+	MAPSET(m, id);
+    }
+}
+
+/* collect the provides behind the file marker, i.e. the ones added
+ * by pool_addfileprovides(), as (solvable, id) pairs */
+static void
+added_fileprovides(Pool *pool, Queue *q)
+{
+  Solvable *s;
+  Id p, *ids;
+
+  for (p = 2, s = pool->solvables + p; p < pool->nsolvables; p++, s++)
+    {
+      if (!s->repo || !s->provides)
+	continue;
+      for (ids = s->repo->idarraydata + s->provides; *ids; ids++)
+	if (*ids == SOLVABLE_FILEMARKER)
+	  break;
+      if (*ids)
+	for (ids++; *ids; ids++)
+	  queue_push2(q, p, *ids);
+    }
+}
+
+/*
+ * write the whatprovides index to fp. Only the provider lists that
+ * are referenced from the index are written, data internalized by
+ * solvers or selections is dropped.
+ */
+int
+pool_write_whatprovides(Pool *pool, FILE *fp)
+{
+  unsigned char cookie[32];
+  Offset *newoff;
+  Offset *wp, *wprel;
+  Queue data, lazyq, fileprovq;
+  Map uncached;
+  Id id;
+  struct cachefile cf;
+  int i;
+
+  if (!pool->whatprovides)
+    return pool_error(pool, -1, "pool_write_whatprovides: no whatprovides index");
+  newoff = solv_calloc(pool->whatprovidesdataoff, sizeof(Offset));
+  wp = solv_calloc(pool->ss.nstrings, sizeof(Offset));
+  wprel = solv_calloc(pool->nrels, sizeof(Offset));
+  queue_init(&data);
+  queue_init(&lazyq);
+  queue_insertn(&data, 0, 4, 0);
+  data.elements[2] = SYSTEMSOLVABLE;
+  for (id = 1; id < pool->ss.nstrings; id++)
+    if (!pool_islazyfileprovides(pool, id))
+      wp[id] = cache_list(pool, pool->whatprovides[id], newoff, &data);
+  uncached_rels(pool, &uncached);
+  for (id = 1; id < pool->nrels; id++)
+    if (!MAPTST(&uncached, id))
+      wprel[id] = cache_list(pool, pool->whatprovides_rel[id], newoff, &data);
+  map_free(&uncached);
+  for (i = 0; i < pool->lazywhatprovidesq.count; i += 2)
+    queue_push2(&lazyq, pool->lazywhatprovidesq.elements[i], cache_list(pool, pool->lazywhatprovidesq.elements[i + 1], newoff, &data));
+  solv_free(newoff);
+  queue_init(&fileprovq);
+  added_fileprovides(pool, &fileprovq);
+
+  pool_calc_whatprovides_cookie(pool, cookie);
+  cf.fp = fp;
+  cf.chk = solv_chksum_create(REPOKEY_TYPE_SHA256);
+  cf.error = 0;
+  write_u32(&cf, WHATPROVIDESCACHE_MAGIC);
+  write_u32(&cf, WHATPROVIDESCACHE_VERSION);
+  solv_chksum_add(cf.chk, cookie, 32);
+  if (!cf.error && fwrite(cookie, 32, 1, fp) != 1)
+    cf.error = errno ? errno : EIO;
+  write_u32(&cf, pool->addedfileprovides);
+  write_u32(&cf, pool->nonstd_nids);
+  write_u32_array(&cf, pool->nonstd_ids, pool->nonstd_nids);
+  write_u32(&cf, fileprovq.count);
+  write_u32_array(&cf, fileprovq.elements, fileprovq.count);
+  write_u32(&cf, data.count);
+  write_u32_array(&cf, data.elements, data.count);
+  write_u32_array(&cf, (Id *)wp + 1, pool->ss.nstrings - 1);
+  write_u32_array(&cf, (Id *)wprel + 1, pool->nrels - 1);
+  write_u32(&cf, lazyq.count);
+  write_u32_array(&cf, lazyq.elements, lazyq.count);
+  if (pool->whatprovidesaux)
+    {
+      write_u32(&cf, pool->whatprovidesauxoff);
+      write_u32_array(&cf, (Id *)pool->whatprovidesaux, pool->whatprovidesauxoff);
+      write_u32(&cf, pool->whatprovidesauxdataoff);
+      write_u32_array(&cf, pool->whatprovidesauxdata, pool->whatprovidesauxdataoff);
+    }
+  else
+    write_u32(&cf, 0);
+  /* the checksum over everything written so far */
+  if (!cf.error && fwrite(solv_chksum_get(cf.chk, 0), 32, 1, fp) != 1)
+    cf.error = errno ? errno : EIO;
+  solv_chksum_free(cf.chk, 0);
+  queue_free(&data);
+  queue_free(&lazyq);
+  queue_free(&fileprovq);
+  solv_free(wp);
+  solv_free(wprel);
+  if (cf.error)
+    return pool_error(pool, -1, "pool_write_whatprovides: write error: %s", strerror(cf.error));
+  return 0;
+}
+
+static inline int
+valid_offset(Offset off, unsigned int ndata)
+{
+  return off < 4 || off < ndata;
+}
+
+/*
+ * read the whatprovides index written with pool_write_whatprovides.
+ * Replaces the calls of pool_addfileprovides() and
+ * pool_createwhatprovides(). Fails if the pool does not match the
+ * one the index was created with.
+ */
+int
+pool_read_whatprovides(Pool *pool, FILE *fp)
+{
+  unsigned char cookie[32], mycookie[32];
+  unsigned int ndata, n, i;
+  int addedfileprovides;
+  Id *nonstd_ids = 0, *fileprovides = 0, *whatprovidesdata = 0, *whatprovidesauxdata = 0;
+  Offset *whatprovides = 0, *whatprovides_rel = 0, *whatprovidesaux = 0;
+  unsigned int nonstd_nids, nfileprovides = 0, auxoff = 0, auxdataoff = 0;
+  Queue lazyq;
+  struct cachefile cf;
+  unsigned int now = solv_timems(0);
+
+  if (pool->frozen)
+    return pool_error(pool, -1, "pool_read_whatprovides: pool is frozen");
+  cf.fp = fp;
+  cf.chk = solv_chksum_create(REPOKEY_TYPE_SHA256);
+  cf.error = 0;
+  if (read_u32(&cf) != WHATPROVIDESCACHE_MAGIC || read_u32(&cf) != WHATPROVIDESCACHE_VERSION)
+    {
+      solv_chksum_free(cf.chk, 0);
+      return pool_error(pool, -1, "pool_read_whatprovides: not a whatprovides cache");
+    }
+  if (fread(cookie, 32, 1, fp) != 1)
+    {
+      solv_chksum_free(cf.chk, 0);
+      return pool_error(pool, -1, "pool_read_whatprovides: unexpected EOF");
+    }
+  solv_chksum_add(cf.chk, cookie, 32);
+  pool_calc_whatprovides_cookie(pool, mycookie);
+  if (memcmp(cookie, mycookie, 32) != 0)
+    {
+      solv_chksum_free(cf.chk, 0);
+      return pool_error(pool, -1, "pool_read_whatprovides: whatprovides cache does not match the pool");
+    }
+
+  addedfileprovides = read_u32(&cf);
+  if (addedfileprovides < 0 || addedfileprovides > 2)
+    cf.error = 1;
+  nonstd_nids = read_u32(&cf);
+  if (nonstd_nids >= (unsigned int)pool->ss.nstrings)
+    cf.error = 1;
+  if (!cf.error && nonstd_nids)
+    {
+      nonstd_ids = solv_calloc(nonstd_nids, sizeof(Id));
+      read_u32_array(&cf, nonstd_ids, nonstd_nids);
+      for (i = 0; i < nonstd_nids && !cf.error; i++)
+	if (nonstd_ids[i] <= 0 || nonstd_ids[i] >= pool->ss.nstrings)
+	  cf.error = 1;
+    }
+
+  /* the provides added by pool_addfileprovides */
+  nfileprovides = read_u32(&cf);
+  if (nfileprovides & 1 || nfileprovides >= SOLV_MAX_INDEX)
+    cf.error = 1;
+  if (!cf.error && nfileprovides)
+    {
+      fileprovides = solv_calloc(nfileprovides, sizeof(Id));
+      read_u32_array(&cf, fileprovides, nfileprovides);
+      for (i = 0; i < nfileprovides && !cf.error; i += 2)
+	{
+	  Id p = fileprovides[i], id = fileprovides[i + 1];
+	  if (p < 2 || p >= pool->nsolvables || !pool->solvables[p].repo)
+	    cf.error = 1;
+	  else if (ISRELDEP(id) ? GETRELID(id) <= 0 || GETRELID(id) >= pool->nrels : id <= 0 || id >= pool->ss.nstrings)
+	    cf.error = 1;
+	}
+    }
+
+  /* the provider lists */
+  ndata = read_u32(&cf);
+  if (ndata < 4 || ndata >= SOLV_MAX_INDEX)
+    cf.error = 1;
+  if (!cf.error)
+    {
+      whatprovidesdata = solv_calloc(ndata + 4096, sizeof(Id));
+      read_u32_array(&cf, whatprovidesdata, ndata);
+      for (i = 0; i < ndata && !cf.error; i++)
+	if (whatprovidesdata[i] < 0 || whatprovidesdata[i] >= pool->nsolvables)
+	  cf.error = 1;
+      if (whatprovidesdata[0] || whatprovidesdata[1] || whatprovidesdata[2] != SYSTEMSOLVABLE || whatprovidesdata[ndata - 1])
+	cf.error = 1;
+    }
+
+  /* the index */
+  if (!cf.error)
+    {
+      whatprovides = solv_calloc_block(pool->ss.nstrings, sizeof(Offset), WHATPROVIDES_BLOCK);
+      read_u32_array(&cf, (Id *)whatprovides + 1, pool->ss.nstrings - 1);
+      for (i = 1; i < (unsigned int)pool->ss.nstrings && !cf.error; i++)
+	if (!valid_offset(whatprovides[i], ndata))
+	  cf.error = 1;
+      whatprovides_rel = solv_calloc_block(pool->nrels, sizeof(Offset), WHATPROVIDES_BLOCK);
+      read_u32_array(&cf, (Id *)whatprovides_rel + 1, pool->nrels - 1);
+      for (i = 1; i < (unsigned int)pool->nrels && !cf.error; i++)
+	if (!valid_offset(whatprovides_rel[i], ndata))
+	  cf.error = 1;
+    }
+  queue_init(&lazyq);
+  n = read_u32(&cf);
+  if (n & 1 || n >= (unsigned int)pool->ss.nstrings * 2)
+    cf.error = 1;
+  for (i = 0; i < n && !cf.error; i += 2)
+    {
+      Id id = read_u32(&cf);
+      Offset off = read_u32(&cf);
+      if (id <= 0 || id >= pool->ss.nstrings || !valid_offset(off, ndata))
+	cf.error = 1;
+      queue_push2(&lazyq, id, off);
+    }
+
+  /* the aux data */
+  auxoff = read_u32(&cf);
+  if (auxoff > (unsigned int)pool->ss.nstrings)
+    cf.error = 1;
+  if (!cf.error && auxoff)
+    {
+      whatprovidesaux = solv_calloc(auxoff, sizeof(Offset));
+      read_u32_array(&cf, (Id *)whatprovidesaux, auxoff);
+      auxdataoff = read_u32(&cf);
+      if (auxdataoff >= SOLV_MAX_INDEX)
+	cf.error = 1;
+      for (i = 0; i < auxoff && !cf.error; i++)
+	if (whatprovidesaux[i] > 1 && whatprovidesaux[i] >= auxdataoff)
+	  cf.error = 1;
+      if (!cf.error)
+	{
+	  whatprovidesauxdata = solv_calloc(auxdataoff ? auxdataoff : 1, sizeof(Id));
+	  read_u32_array(&cf, whatprovidesauxdata, auxdataoff);
+	}
+    }
+
+  /* verify the checksum */
+  if (!cf.error && (fread(cookie, 32, 1, fp) != 1 || memcmp(cookie, solv_chksum_get(cf.chk, 0), 32) != 0))
+    cf.error = 2;
+  solv_chksum_free(cf.chk, 0);
+  if (cf.error)
+    {
+      solv_free(nonstd_ids);
+      solv_free(fileprovides);
+      solv_free(whatprovidesdata);
+      solv_free(whatprovides);
+      solv_free(whatprovides_rel);
+      solv_free(whatprovidesaux);
+      solv_free(whatprovidesauxdata);
+      queue_free(&lazyq);
+      if (cf.error == 2)
+	return pool_error(pool, -1, "pool_read_whatprovides: checksum mismatch");
+      return pool_error(pool, -1, "pool_read_whatprovides: read error");
+    }
+
+  pool_freewhatprovides(pool);
+  for (i = 0; i < nfileprovides; i += 2)
+    {
+      Solvable *s = pool->solvables + fileprovides[i];
+      s->provides = repo_addid_dep(s->repo, s->provides, fileprovides[i + 1], SOLVABLE_FILEMARKER);
+    }
+  solv_free(fileprovides);
+  pool->addedfileprovides = addedfileprovides;
+  solv_free(pool->nonstd_ids);
+  pool->nonstd_ids = nonstd_ids;
+  pool->nonstd_nids = nonstd_nids;
+  pool->whatprovides = whatprovides;
+  pool->whatprovides_rel = whatprovides_rel;
+  pool->whatprovidesdata = whatprovidesdata;
+  pool->whatprovidesdataoff = ndata;
+  pool->whatprovidesdataleft = 4096;
+  pool->whatprovidesaux = whatprovidesaux;
+  pool->whatprovidesauxoff = auxoff;
+  pool->whatprovidesauxdata = whatprovidesauxdata;
+  pool->whatprovidesauxdataoff = auxdataoff;
+  queue_empty(&pool->lazywhatprovidesq);
+  queue_insertn(&pool->lazywhatprovidesq, 0, lazyq.count, lazyq.elements);
+  queue_free(&lazyq);
+  pool->whatprovidesnsolvables = pool->nsolvables;
+  pool->whatprovidesnstrings = pool->ss.nstrings;
+  pool->whatprovidesnrels = pool->nrels;
+  pool->whatprovidesbuildoff = ndata;
+  pool->stats_whatprovidestime = solv_timems(now);
+  POOL_DEBUG(SOLV_DEBUG_STATS, "read_whatprovides took %d ms\n", pool->stats_whatprovidestime);
+  return 0;
+}
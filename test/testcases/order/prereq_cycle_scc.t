@@ -0,0 +1,30 @@
+# the prereq_cycle testcase with the scc cycle breaker: the plain
+# requires edge of the prereq cycle must be broken, so that b is
+# installed before a
+repo system 0 empty
+repo test 0 testtags <inline>
+#>=Pkg: a 1 1 noarch
+#>=Prq: b
+#>=Pkg: b 1 1 noarch
+#>=Req: a
+#>=Pkg: c 1 1 noarch
+#>=Req: d
+#>=Pkg: d 1 1 noarch
+#>=Req: c
+system i686 rpm system
+job install name a
+job install name c
+result transaction,order,orderedges,orderscc <inline>
+#>install a-1-1.noarch@test
+#>install b-1-1.noarch@test
+#>install c-1-1.noarch@test
+#>install d-1-1.noarch@test
+#>order    1 install c-1-1.noarch@test
+#>order    2 install d-1-1.noarch@test
+#>order    3 install b-1-1.noarch@test
+#>order    4 install a-1-1.noarch@test
+#>orderedge a-1-1.noarch@test -800-> b-1-1.noarch@test
+#>orderedge b-1-1.noarch@test -400-> a-1-1.noarch@test
+#>orderedge c-1-1.noarch@test -400-> d-1-1.noarch@test
+#>orderedge d-1-1.noarch@test -400-> c-1-1.noarch@test
+
@@ -0,0 +1,82 @@
+# a requires loop of ten packages with a prereq edge, and a longer
+# loop that also goes over a recommends edge. With the scc cycle
+# breaker the elements of the requires loop must stay together, x1 and
+# x2 are installed after the complete requires loop
+repo system 0 empty
+repo test 0 testtags <inline>
+#>=Pkg: a1 1 1 noarch
+#>=Req: a2
+#>=Pkg: a2 1 1 noarch
+#>=Prq: a3
+#>=Pkg: a3 1 1 noarch
+#>=Req: a4
+#>=Rec: x1
+#>=Pkg: a4 1 1 noarch
+#>=Req: a5
+#>=Req: y
+#>=Pkg: a5 1 1 noarch
+#>=Req: a6
+#>=Pkg: a6 1 1 noarch
+#>=Req: a7
+#>=Pkg: a7 1 1 noarch
+#>=Req: a8
+#>=Pkg: a8 1 1 noarch
+#>=Req: a9
+#>=Pkg: a9 1 1 noarch
+#>=Req: a10
+#>=Pkg: a10 1 1 noarch
+#>=Req: a1
+#>=Pkg: x1 1 1 noarch
+#>=Req: x2
+#>=Pkg: x2 1 1 noarch
+#>=Req: a7
+#>=Pkg: y 1 1 noarch
+#>=Pkg: z 1 1 noarch
+#>=Req: a1
+system i686 rpm system
+job install name z
+job install name x1
+result transaction,order,orderedges,orderscc <inline>
+#>install a1-1-1.noarch@test
+#>install a10-1-1.noarch@test
+#>install a2-1-1.noarch@test
+#>install a3-1-1.noarch@test
+#>install a4-1-1.noarch@test
+#>install a5-1-1.noarch@test
+#>install a6-1-1.noarch@test
+#>install a7-1-1.noarch@test
+#>install a8-1-1.noarch@test
+#>install a9-1-1.noarch@test
+#>install x1-1-1.noarch@test
+#>install x2-1-1.noarch@test
+#>install y-1-1.noarch@test
+#>install z-1-1.noarch@test
+#>order    1 install y-1-1.noarch@test
+#>order    2 install a7-1-1.noarch@test
+#>order    3 install a6-1-1.noarch@test
+#>order    4 install a5-1-1.noarch@test
+#>order    5 install a4-1-1.noarch@test
+#>order    6 install a3-1-1.noarch@test
+#>order    7 install a2-1-1.noarch@test
+#>order    8 install a1-1-1.noarch@test
+#>order    9 install a10-1-1.noarch@test
+#>order   10 install a9-1-1.noarch@test
+#>order   11 install a8-1-1.noarch@test
+#>order   12 install x2-1-1.noarch@test
+#>order   13 install x1-1-1.noarch@test
+#>order   14 install z-1-1.noarch@test
+#>orderedge a1-1-1.noarch@test -400-> a2-1-1.noarch@test
+#>orderedge a10-1-1.noarch@test -400-> a1-1-1.noarch@test
+#>orderedge a2-1-1.noarch@test -800-> a3-1-1.noarch@test
+#>orderedge a3-1-1.noarch@test -200-> x1-1-1.noarch@test
+#>orderedge a3-1-1.noarch@test -400-> a4-1-1.noarch@test
+#>orderedge a4-1-1.noarch@test -400-> a5-1-1.noarch@test
+#>orderedge a4-1-1.noarch@test -400-> y-1-1.noarch@test
+#>orderedge a5-1-1.noarch@test -400-> a6-1-1.noarch@test
+#>orderedge a6-1-1.noarch@test -400-> a7-1-1.noarch@test
+#>orderedge a7-1-1.noarch@test -400-> a8-1-1.noarch@test
+#>orderedge a8-1-1.noarch@test -400-> a9-1-1.noarch@test
+#>orderedge a9-1-1.noarch@test -400-> a10-1-1.noarch@test
+#>orderedge x1-1-1.noarch@test -400-> x2-1-1.noarch@test
+#>orderedge x2-1-1.noarch@test -400-> a7-1-1.noarch@test
+#>orderedge z-1-1.noarch@test -400-> a1-1-1.noarch@test
@@ -0,0 +1,36 @@
+repo system 0 testtags <inline>
+#>=Pkg: A 1 1 noarch
+#>=Req: libL
+#>=Pkg: L 1 1 noarch
+#>=Prv: libL
+repo available 0 testtags <inline>
+#>=Pkg: A 2 1 noarch
+#>=Req: libL
+#>=Pkg: L 1 1 noarch
+#>=Prv: libL
+#>=Pkg: L 2 1 noarch
+#>=Prv: libL
+#>=Req: M
+#>=Pkg: M 1 1 noarch
+#>=Pkg: B 1 1 noarch
+#>=Req: C
+#>=Con: L < 2
+#>=Pkg: C 1 1 noarch
+#>=Pkg: X 1 1 noarch
+#>=Req: A > 1
+system noarch rpm system
+solverflags lazypkgrules
+job install name B
+result transaction,problems <inline>
+#>install B-1-1.noarch@available
+#>install C-1-1.noarch@available
+#>install M-1-1.noarch@available
+#>upgrade L-1-1.noarch@system L-2-1.noarch@available
+nextjob
+solverflags lazypkgrules
+job install name X
+job lock name A
+result transaction,problems <inline>
+#>problem 31e13d73 info package X-1-1.noarch requires A > 1, but none of the providers can be installed
+#>problem 31e13d73 solution 079c550b deljob lock name A
+#>problem 31e13d73 solution c461ac33 deljob install name X
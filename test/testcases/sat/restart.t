@@ -0,0 +1,203 @@
+# check that restarts and retired learnt rules do not change the result
+repo system 0 empty
+repo available 0 testtags <inline>
+#>=Pkg: P0 1 1 noarch
+#>=Req: slot0
+#>=Pkg: P1 1 1 noarch
+#>=Req: slot1
+#>=Pkg: P2 1 1 noarch
+#>=Req: slot2
+#>=Pkg: P3 1 1 noarch
+#>=Req: slot3
+#>=Pkg: P4 1 1 noarch
+#>=Req: slot4
+#>=Pkg: P5 1 1 noarch
+#>=Req: slot5
+#>=Pkg: P6 1 1 noarch
+#>=Req: slot6
+#>=Pkg: P7 1 1 noarch
+#>=Req: slot7
+#>=Pkg: S0_0 1 1 noarch
+#>=Prv: slot0
+#>+Con:
+#>S1_1
+#>S2_0
+#>S2_1
+#>-Con:
+#>=Pkg: S0_1 1 1 noarch
+#>=Prv: slot0
+#>+Con:
+#>S1_0
+#>S2_1
+#>S6_1
+#>-Con:
+#>=Pkg: S0_2 1 1 noarch
+#>=Prv: slot0
+#>+Con:
+#>S3_0
+#>S7_1
+#>S7_2
+#>-Con:
+#>=Pkg: S1_0 1 1 noarch
+#>=Prv: slot1
+#>+Con:
+#>S5_1
+#>S5_2
+#>S6_0
+#>-Con:
+#>=Pkg: S1_1 1 1 noarch
+#>=Prv: slot1
+#>+Con:
+#>S3_0
+#>S7_1
+#>-Con:
+#>=Pkg: S1_2 1 1 noarch
+#>=Prv: slot1
+#>+Con:
+#>S3_0
+#>S4_2
+#>-Con:
+#>=Pkg: S2_0 1 1 noarch
+#>=Prv: slot2
+#>+Con:
+#>S1_0
+#>S4_0
+#>S4_1
+#>-Con:
+#>=Pkg: S2_1 1 1 noarch
+#>=Prv: slot2
+#>+Con:
+#>S3_0
+#>S4_2
+#>-Con:
+#>=Pkg: S2_2 1 1 noarch
+#>=Prv: slot2
+#>+Con:
+#>S0_2
+#>S4_1
+#>-Con:
+#>=Pkg: S3_0 1 1 noarch
+#>=Prv: slot3
+#>+Con:
+#>S4_2
+#>S5_2
+#>S7_0
+#>-Con:
+#>=Pkg: S3_1 1 1 noarch
+#>=Prv: slot3
+#>+Con:
+#>S1_2
+#>S2_1
+#>S6_0
+#>-Con:
+#>=Pkg: S3_2 1 1 noarch
+#>=Prv: slot3
+#>+Con:
+#>S2_2
+#>S6_1
+#>-Con:
+#>=Pkg: S4_0 1 1 noarch
+#>=Prv: slot4
+#>+Con:
+#>S0_2
+#>S2_0
+#>S3_1
+#>-Con:
+#>=Pkg: S4_1 1 1 noarch
+#>=Prv: slot4
+#>+Con:
+#>S1_0
+#>S5_2
+#>-Con:
+#>=Pkg: S4_2 1 1 noarch
+#>=Prv: slot4
+#>+Con:
+#>S0_2
+#>S2_0
+#>S6_1
+#>-Con:
+#>=Pkg: S5_0 1 1 noarch
+#>=Prv: slot5
+#>+Con:
+#>S1_2
+#>S7_2
+#>-Con:
+#>=Pkg: S5_1 1 1 noarch
+#>=Prv: slot5
+#>+Con:
+#>S1_0
+#>S1_2
+#>-Con:
+#>=Pkg: S5_2 1 1 noarch
+#>=Prv: slot5
+#>+Con:
+#>S0_0
+#>S3_0
+#>S4_2
+#>-Con:
+#>=Pkg: S6_0 1 1 noarch
+#>=Prv: slot6
+#>+Con:
+#>S0_0
+#>S0_2
+#>S2_1
+#>-Con:
+#>=Pkg: S6_1 1 1 noarch
+#>=Prv: slot6
+#>+Con:
+#>S2_1
+#>S4_0
+#>-Con:
+#>=Pkg: S6_2 1 1 noarch
+#>=Prv: slot6
+#>+Con:
+#>S1_1
+#>S3_0
+#>-Con:
+#>=Pkg: S7_0 1 1 noarch
+#>=Prv: slot7
+#>+Con:
+#>S1_1
+#>S2_2
+#>S6_0
+#>-Con:
+#>=Pkg: S7_1 1 1 noarch
+#>=Prv: slot7
+#>+Con:
+#>S2_0
+#>S4_1
+#>-Con:
+#>=Pkg: S7_2 1 1 noarch
+#>=Prv: slot7
+#>+Con:
+#>S1_1
+#>S3_1
+#>S4_0
+#>-Con:
+system noarch rpm system
+solverflags restartpolicy=1 restartinterval=1 learntrulelimit=1
+job install name P0
+job install name P1
+job install name P2
+job install name P3
+job install name P4
+job install name P5
+job install name P6
+job install name P7
+result transaction,problems <inline>
+#>install P0-1-1.noarch@available
+#>install P1-1-1.noarch@available
+#>install P2-1-1.noarch@available
+#>install P3-1-1.noarch@available
+#>install P4-1-1.noarch@available
+#>install P5-1-1.noarch@available
+#>install P6-1-1.noarch@available
+#>install P7-1-1.noarch@available
+#>install S0_0-1-1.noarch@available
+#>install S1_0-1-1.noarch@available
+#>install S2_2-1-1.noarch@available
+#>install S3_1-1-1.noarch@available
+#>install S4_2-1-1.noarch@available
+#>install S5_0-1-1.noarch@available
+#>install S6_2-1-1.noarch@available
+#>install S7_1-1-1.noarch@available
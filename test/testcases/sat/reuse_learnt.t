@@ -0,0 +1,117 @@
+repo system 0 empty
+repo available 0 testtags <inline>
+#>=Pkg: P0 1 1 noarch
+#>=Req: slot0
+#>=Pkg: P1 1 1 noarch
+#>=Req: slot1
+#>=Pkg: P2 1 1 noarch
+#>=Req: slot2
+#>=Pkg: P3 1 1 noarch
+#>=Req: slot3
+#>=Pkg: P4 1 1 noarch
+#>=Req: slot4
+#>=Pkg: S0_0 1 1 noarch
+#>=Prv: slot0
+#>+Con:
+#>S3_1
+#>S4_0
+#>-Con:
+#>=Pkg: S0_1 1 1 noarch
+#>=Prv: slot0
+#>+Con:
+#>S1_0
+#>S1_1
+#>S3_1
+#>-Con:
+#>=Pkg: S1_0 1 1 noarch
+#>=Prv: slot1
+#>+Con:
+#>S2_0
+#>S4_1
+#>-Con:
+#>=Pkg: S1_1 1 1 noarch
+#>=Prv: slot1
+#>+Con:
+#>S0_1
+#>S3_1
+#>-Con:
+#>=Pkg: S2_0 1 1 noarch
+#>=Prv: slot2
+#>+Con:
+#>S3_0
+#>-Con:
+#>=Pkg: S2_1 1 1 noarch
+#>=Prv: slot2
+#>+Con:
+#>S1_1
+#>S4_1
+#>-Con:
+#>=Pkg: S3_0 1 1 noarch
+#>=Prv: slot3
+#>+Con:
+#>S0_0
+#>S1_0
+#>S1_1
+#>-Con:
+#>=Pkg: S3_1 1 1 noarch
+#>=Prv: slot3
+#>+Con:
+#>S1_1
+#>S4_1
+#>-Con:
+#>=Pkg: S4_0 1 1 noarch
+#>=Prv: slot4
+#>+Con:
+#>S0_1
+#>S3_1
+#>-Con:
+#>=Pkg: S4_1 1 1 noarch
+#>=Prv: slot4
+#>+Con:
+#>S0_1
+#>S1_0
+#>S1_1
+#>-Con:
+system noarch rpm system
+solverflags keeplearntrules
+job install name P4
+job install name P0
+job install name P2
+result transaction,problems,stats <inline>
+#>install P0-1-1.noarch@available
+#>install P2-1-1.noarch@available
+#>install P4-1-1.noarch@available
+#>install S0_0-1-1.noarch@available
+#>install S2_0-1-1.noarch@available
+#>install S4_1-1-1.noarch@available
+#>stat aborted 0
+#>stat keptlearntrules 0
+#>stat lazyrounds 1
+#>stat reusedpkgrules 0
+nextjob reusesolver
+job install name P3
+job install name P2
+job lock name S1_0
+job lock name S0_1
+result transaction,problems,stats <inline>
+#>install P2-1-1.noarch@available
+#>install P3-1-1.noarch@available
+#>install S2_1-1-1.noarch@available
+#>install S3_0-1-1.noarch@available
+#>stat aborted 0
+#>stat keptlearntrules 1
+#>stat lazyrounds 1
+#>stat reusedpkgrules 16
+nextjob reusesolver
+job install name P1
+job install name P2
+job lock name S3_1
+result transaction,problems,stats <inline>
+#>install P1-1-1.noarch@available
+#>install P2-1-1.noarch@available
+#>install S1_1-1-1.noarch@available
+#>install S2_0-1-1.noarch@available
+#>stat aborted 0
+#>stat keptlearntrules 1
+#>stat lazyrounds 1
+#>stat reusedpkgrules 22
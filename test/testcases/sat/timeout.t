@@ -0,0 +1,1570 @@
+repo system 0 empty
+repo available 0 testtags <inline>
+#>=Pkg: p0h0 1 1 noarch
+#>=Prv: pigeon0
+#>+Con:
+#>p1h0
+#>p2h0
+#>p3h0
+#>p4h0
+#>p5h0
+#>p6h0
+#>p7h0
+#>p8h0
+#>p9h0
+#>p10h0
+#>-Con:
+#>=Pkg: p0h1 1 1 noarch
+#>=Prv: pigeon0
+#>+Con:
+#>p1h1
+#>p2h1
+#>p3h1
+#>p4h1
+#>p5h1
+#>p6h1
+#>p7h1
+#>p8h1
+#>p9h1
+#>p10h1
+#>-Con:
+#>=Pkg: p0h2 1 1 noarch
+#>=Prv: pigeon0
+#>+Con:
+#>p1h2
+#>p2h2
+#>p3h2
+#>p4h2
+#>p5h2
+#>p6h2
+#>p7h2
+#>p8h2
+#>p9h2
+#>p10h2
+#>-Con:
+#>=Pkg: p0h3 1 1 noarch
+#>=Prv: pigeon0
+#>+Con:
+#>p1h3
+#>p2h3
+#>p3h3
+#>p4h3
+#>p5h3
+#>p6h3
+#>p7h3
+#>p8h3
+#>p9h3
+#>p10h3
+#>-Con:
+#>=Pkg: p0h4 1 1 noarch
+#>=Prv: pigeon0
+#>+Con:
+#>p1h4
+#>p2h4
+#>p3h4
+#>p4h4
+#>p5h4
+#>p6h4
+#>p7h4
+#>p8h4
+#>p9h4
+#>p10h4
+#>-Con:
+#>=Pkg: p0h5 1 1 noarch
+#>=Prv: pigeon0
+#>+Con:
+#>p1h5
+#>p2h5
+#>p3h5
+#>p4h5
+#>p5h5
+#>p6h5
+#>p7h5
+#>p8h5
+#>p9h5
+#>p10h5
+#>-Con:
+#>=Pkg: p0h6 1 1 noarch
+#>=Prv: pigeon0
+#>+Con:
+#>p1h6
+#>p2h6
+#>p3h6
+#>p4h6
+#>p5h6
+#>p6h6
+#>p7h6
+#>p8h6
+#>p9h6
+#>p10h6
+#>-Con:
+#>=Pkg: p0h7 1 1 noarch
+#>=Prv: pigeon0
+#>+Con:
+#>p1h7
+#>p2h7
+#>p3h7
+#>p4h7
+#>p5h7
+#>p6h7
+#>p7h7
+#>p8h7
+#>p9h7
+#>p10h7
+#>-Con:
+#>=Pkg: p0h8 1 1 noarch
+#>=Prv: pigeon0
+#>+Con:
+#>p1h8
+#>p2h8
+#>p3h8
+#>p4h8
+#>p5h8
+#>p6h8
+#>p7h8
+#>p8h8
+#>p9h8
+#>p10h8
+#>-Con:
+#>=Pkg: p0h9 1 1 noarch
+#>=Prv: pigeon0
+#>+Con:
+#>p1h9
+#>p2h9
+#>p3h9
+#>p4h9
+#>p5h9
+#>p6h9
+#>p7h9
+#>p8h9
+#>p9h9
+#>p10h9
+#>-Con:
+#>=Pkg: p1h0 1 1 noarch
+#>=Prv: pigeon1
+#>+Con:
+#>p0h0
+#>p2h0
+#>p3h0
+#>p4h0
+#>p5h0
+#>p6h0
+#>p7h0
+#>p8h0
+#>p9h0
+#>p10h0
+#>-Con:
+#>=Pkg: p1h1 1 1 noarch
+#>=Prv: pigeon1
+#>+Con:
+#>p0h1
+#>p2h1
+#>p3h1
+#>p4h1
+#>p5h1
+#>p6h1
+#>p7h1
+#>p8h1
+#>p9h1
+#>p10h1
+#>-Con:
+#>=Pkg: p1h2 1 1 noarch
+#>=Prv: pigeon1
+#>+Con:
+#>p0h2
+#>p2h2
+#>p3h2
+#>p4h2
+#>p5h2
+#>p6h2
+#>p7h2
+#>p8h2
+#>p9h2
+#>p10h2
+#>-Con:
+#>=Pkg: p1h3 1 1 noarch
+#>=Prv: pigeon1
+#>+Con:
+#>p0h3
+#>p2h3
+#>p3h3
+#>p4h3
+#>p5h3
+#>p6h3
+#>p7h3
+#>p8h3
+#>p9h3
+#>p10h3
+#>-Con:
+#>=Pkg: p1h4 1 1 noarch
+#>=Prv: pigeon1
+#>+Con:
+#>p0h4
+#>p2h4
+#>p3h4
+#>p4h4
+#>p5h4
+#>p6h4
+#>p7h4
+#>p8h4
+#>p9h4
+#>p10h4
+#>-Con:
+#>=Pkg: p1h5 1 1 noarch
+#>=Prv: pigeon1
+#>+Con:
+#>p0h5
+#>p2h5
+#>p3h5
+#>p4h5
+#>p5h5
+#>p6h5
+#>p7h5
+#>p8h5
+#>p9h5
+#>p10h5
+#>-Con:
+#>=Pkg: p1h6 1 1 noarch
+#>=Prv: pigeon1
+#>+Con:
+#>p0h6
+#>p2h6
+#>p3h6
+#>p4h6
+#>p5h6
+#>p6h6
+#>p7h6
+#>p8h6
+#>p9h6
+#>p10h6
+#>-Con:
+#>=Pkg: p1h7 1 1 noarch
+#>=Prv: pigeon1
+#>+Con:
+#>p0h7
+#>p2h7
+#>p3h7
+#>p4h7
+#>p5h7
+#>p6h7
+#>p7h7
+#>p8h7
+#>p9h7
+#>p10h7
+#>-Con:
+#>=Pkg: p1h8 1 1 noarch
+#>=Prv: pigeon1
+#>+Con:
+#>p0h8
+#>p2h8
+#>p3h8
+#>p4h8
+#>p5h8
+#>p6h8
+#>p7h8
+#>p8h8
+#>p9h8
+#>p10h8
+#>-Con:
+#>=Pkg: p1h9 1 1 noarch
+#>=Prv: pigeon1
+#>+Con:
+#>p0h9
+#>p2h9
+#>p3h9
+#>p4h9
+#>p5h9
+#>p6h9
+#>p7h9
+#>p8h9
+#>p9h9
+#>p10h9
+#>-Con:
+#>=Pkg: p2h0 1 1 noarch
+#>=Prv: pigeon2
+#>+Con:
+#>p0h0
+#>p1h0
+#>p3h0
+#>p4h0
+#>p5h0
+#>p6h0
+#>p7h0
+#>p8h0
+#>p9h0
+#>p10h0
+#>-Con:
+#>=Pkg: p2h1 1 1 noarch
+#>=Prv: pigeon2
+#>+Con:
+#>p0h1
+#>p1h1
+#>p3h1
+#>p4h1
+#>p5h1
+#>p6h1
+#>p7h1
+#>p8h1
+#>p9h1
+#>p10h1
+#>-Con:
+#>=Pkg: p2h2 1 1 noarch
+#>=Prv: pigeon2
+#>+Con:
+#>p0h2
+#>p1h2
+#>p3h2
+#>p4h2
+#>p5h2
+#>p6h2
+#>p7h2
+#>p8h2
+#>p9h2
+#>p10h2
+#>-Con:
+#>=Pkg: p2h3 1 1 noarch
+#>=Prv: pigeon2
+#>+Con:
+#>p0h3
+#>p1h3
+#>p3h3
+#>p4h3
+#>p5h3
+#>p6h3
+#>p7h3
+#>p8h3
+#>p9h3
+#>p10h3
+#>-Con:
+#>=Pkg: p2h4 1 1 noarch
+#>=Prv: pigeon2
+#>+Con:
+#>p0h4
+#>p1h4
+#>p3h4
+#>p4h4
+#>p5h4
+#>p6h4
+#>p7h4
+#>p8h4
+#>p9h4
+#>p10h4
+#>-Con:
+#>=Pkg: p2h5 1 1 noarch
+#>=Prv: pigeon2
+#>+Con:
+#>p0h5
+#>p1h5
+#>p3h5
+#>p4h5
+#>p5h5
+#>p6h5
+#>p7h5
+#>p8h5
+#>p9h5
+#>p10h5
+#>-Con:
+#>=Pkg: p2h6 1 1 noarch
+#>=Prv: pigeon2
+#>+Con:
+#>p0h6
+#>p1h6
+#>p3h6
+#>p4h6
+#>p5h6
+#>p6h6
+#>p7h6
+#>p8h6
+#>p9h6
+#>p10h6
+#>-Con:
+#>=Pkg: p2h7 1 1 noarch
+#>=Prv: pigeon2
+#>+Con:
+#>p0h7
+#>p1h7
+#>p3h7
+#>p4h7
+#>p5h7
+#>p6h7
+#>p7h7
+#>p8h7
+#>p9h7
+#>p10h7
+#>-Con:
+#>=Pkg: p2h8 1 1 noarch
+#>=Prv: pigeon2
+#>+Con:
+#>p0h8
+#>p1h8
+#>p3h8
+#>p4h8
+#>p5h8
+#>p6h8
+#>p7h8
+#>p8h8
+#>p9h8
+#>p10h8
+#>-Con:
+#>=Pkg: p2h9 1 1 noarch
+#>=Prv: pigeon2
+#>+Con:
+#>p0h9
+#>p1h9
+#>p3h9
+#>p4h9
+#>p5h9
+#>p6h9
+#>p7h9
+#>p8h9
+#>p9h9
+#>p10h9
+#>-Con:
+#>=Pkg: p3h0 1 1 noarch
+#>=Prv: pigeon3
+#>+Con:
+#>p0h0
+#>p1h0
+#>p2h0
+#>p4h0
+#>p5h0
+#>p6h0
+#>p7h0
+#>p8h0
+#>p9h0
+#>p10h0
+#>-Con:
+#>=Pkg: p3h1 1 1 noarch
+#>=Prv: pigeon3
+#>+Con:
+#>p0h1
+#>p1h1
+#>p2h1
+#>p4h1
+#>p5h1
+#>p6h1
+#>p7h1
+#>p8h1
+#>p9h1
+#>p10h1
+#>-Con:
+#>=Pkg: p3h2 1 1 noarch
+#>=Prv: pigeon3
+#>+Con:
+#>p0h2
+#>p1h2
+#>p2h2
+#>p4h2
+#>p5h2
+#>p6h2
+#>p7h2
+#>p8h2
+#>p9h2
+#>p10h2
+#>-Con:
+#>=Pkg: p3h3 1 1 noarch
+#>=Prv: pigeon3
+#>+Con:
+#>p0h3
+#>p1h3
+#>p2h3
+#>p4h3
+#>p5h3
+#>p6h3
+#>p7h3
+#>p8h3
+#>p9h3
+#>p10h3
+#>-Con:
+#>=Pkg: p3h4 1 1 noarch
+#>=Prv: pigeon3
+#>+Con:
+#>p0h4
+#>p1h4
+#>p2h4
+#>p4h4
+#>p5h4
+#>p6h4
+#>p7h4
+#>p8h4
+#>p9h4
+#>p10h4
+#>-Con:
+#>=Pkg: p3h5 1 1 noarch
+#>=Prv: pigeon3
+#>+Con:
+#>p0h5
+#>p1h5
+#>p2h5
+#>p4h5
+#>p5h5
+#>p6h5
+#>p7h5
+#>p8h5
+#>p9h5
+#>p10h5
+#>-Con:
+#>=Pkg: p3h6 1 1 noarch
+#>=Prv: pigeon3
+#>+Con:
+#>p0h6
+#>p1h6
+#>p2h6
+#>p4h6
+#>p5h6
+#>p6h6
+#>p7h6
+#>p8h6
+#>p9h6
+#>p10h6
+#>-Con:
+#>=Pkg: p3h7 1 1 noarch
+#>=Prv: pigeon3
+#>+Con:
+#>p0h7
+#>p1h7
+#>p2h7
+#>p4h7
+#>p5h7
+#>p6h7
+#>p7h7
+#>p8h7
+#>p9h7
+#>p10h7
+#>-Con:
+#>=Pkg: p3h8 1 1 noarch
+#>=Prv: pigeon3
+#>+Con:
+#>p0h8
+#>p1h8
+#>p2h8
+#>p4h8
+#>p5h8
+#>p6h8
+#>p7h8
+#>p8h8
+#>p9h8
+#>p10h8
+#>-Con:
+#>=Pkg: p3h9 1 1 noarch
+#>=Prv: pigeon3
+#>+Con:
+#>p0h9
+#>p1h9
+#>p2h9
+#>p4h9
+#>p5h9
+#>p6h9
+#>p7h9
+#>p8h9
+#>p9h9
+#>p10h9
+#>-Con:
+#>=Pkg: p4h0 1 1 noarch
+#>=Prv: pigeon4
+#>+Con:
+#>p0h0
+#>p1h0
+#>p2h0
+#>p3h0
+#>p5h0
+#>p6h0
+#>p7h0
+#>p8h0
+#>p9h0
+#>p10h0
+#>-Con:
+#>=Pkg: p4h1 1 1 noarch
+#>=Prv: pigeon4
+#>+Con:
+#>p0h1
+#>p1h1
+#>p2h1
+#>p3h1
+#>p5h1
+#>p6h1
+#>p7h1
+#>p8h1
+#>p9h1
+#>p10h1
+#>-Con:
+#>=Pkg: p4h2 1 1 noarch
+#>=Prv: pigeon4
+#>+Con:
+#>p0h2
+#>p1h2
+#>p2h2
+#>p3h2
+#>p5h2
+#>p6h2
+#>p7h2
+#>p8h2
+#>p9h2
+#>p10h2
+#>-Con:
+#>=Pkg: p4h3 1 1 noarch
+#>=Prv: pigeon4
+#>+Con:
+#>p0h3
+#>p1h3
+#>p2h3
+#>p3h3
+#>p5h3
+#>p6h3
+#>p7h3
+#>p8h3
+#>p9h3
+#>p10h3
+#>-Con:
+#>=Pkg: p4h4 1 1 noarch
+#>=Prv: pigeon4
+#>+Con:
+#>p0h4
+#>p1h4
+#>p2h4
+#>p3h4
+#>p5h4
+#>p6h4
+#>p7h4
+#>p8h4
+#>p9h4
+#>p10h4
+#>-Con:
+#>=Pkg: p4h5 1 1 noarch
+#>=Prv: pigeon4
+#>+Con:
+#>p0h5
+#>p1h5
+#>p2h5
+#>p3h5
+#>p5h5
+#>p6h5
+#>p7h5
+#>p8h5
+#>p9h5
+#>p10h5
+#>-Con:
+#>=Pkg: p4h6 1 1 noarch
+#>=Prv: pigeon4
+#>+Con:
+#>p0h6
+#>p1h6
+#>p2h6
+#>p3h6
+#>p5h6
+#>p6h6
+#>p7h6
+#>p8h6
+#>p9h6
+#>p10h6
+#>-Con:
+#>=Pkg: p4h7 1 1 noarch
+#>=Prv: pigeon4
+#>+Con:
+#>p0h7
+#>p1h7
+#>p2h7
+#>p3h7
+#>p5h7
+#>p6h7
+#>p7h7
+#>p8h7
+#>p9h7
+#>p10h7
+#>-Con:
+#>=Pkg: p4h8 1 1 noarch
+#>=Prv: pigeon4
+#>+Con:
+#>p0h8
+#>p1h8
+#>p2h8
+#>p3h8
+#>p5h8
+#>p6h8
+#>p7h8
+#>p8h8
+#>p9h8
+#>p10h8
+#>-Con:
+#>=Pkg: p4h9 1 1 noarch
+#>=Prv: pigeon4
+#>+Con:
+#>p0h9
+#>p1h9
+#>p2h9
+#>p3h9
+#>p5h9
+#>p6h9
+#>p7h9
+#>p8h9
+#>p9h9
+#>p10h9
+#>-Con:
+#>=Pkg: p5h0 1 1 noarch
+#>=Prv: pigeon5
+#>+Con:
+#>p0h0
+#>p1h0
+#>p2h0
+#>p3h0
+#>p4h0
+#>p6h0
+#>p7h0
+#>p8h0
+#>p9h0
+#>p10h0
+#>-Con:
+#>=Pkg: p5h1 1 1 noarch
+#>=Prv: pigeon5
+#>+Con:
+#>p0h1
+#>p1h1
+#>p2h1
+#>p3h1
+#>p4h1
+#>p6h1
+#>p7h1
+#>p8h1
+#>p9h1
+#>p10h1
+#>-Con:
+#>=Pkg: p5h2 1 1 noarch
+#>=Prv: pigeon5
+#>+Con:
+#>p0h2
+#>p1h2
+#>p2h2
+#>p3h2
+#>p4h2
+#>p6h2
+#>p7h2
+#>p8h2
+#>p9h2
+#>p10h2
+#>-Con:
+#>=Pkg: p5h3 1 1 noarch
+#>=Prv: pigeon5
+#>+Con:
+#>p0h3
+#>p1h3
+#>p2h3
+#>p3h3
+#>p4h3
+#>p6h3
+#>p7h3
+#>p8h3
+#>p9h3
+#>p10h3
+#>-Con:
+#>=Pkg: p5h4 1 1 noarch
+#>=Prv: pigeon5
+#>+Con:
+#>p0h4
+#>p1h4
+#>p2h4
+#>p3h4
+#>p4h4
+#>p6h4
+#>p7h4
+#>p8h4
+#>p9h4
+#>p10h4
+#>-Con:
+#>=Pkg: p5h5 1 1 noarch
+#>=Prv: pigeon5
+#>+Con:
+#>p0h5
+#>p1h5
+#>p2h5
+#>p3h5
+#>p4h5
+#>p6h5
+#>p7h5
+#>p8h5
+#>p9h5
+#>p10h5
+#>-Con:
+#>=Pkg: p5h6 1 1 noarch
+#>=Prv: pigeon5
+#>+Con:
+#>p0h6
+#>p1h6
+#>p2h6
+#>p3h6
+#>p4h6
+#>p6h6
+#>p7h6
+#>p8h6
+#>p9h6
+#>p10h6
+#>-Con:
+#>=Pkg: p5h7 1 1 noarch
+#>=Prv: pigeon5
+#>+Con:
+#>p0h7
+#>p1h7
+#>p2h7
+#>p3h7
+#>p4h7
+#>p6h7
+#>p7h7
+#>p8h7
+#>p9h7
+#>p10h7
+#>-Con:
+#>=Pkg: p5h8 1 1 noarch
+#>=Prv: pigeon5
+#>+Con:
+#>p0h8
+#>p1h8
+#>p2h8
+#>p3h8
+#>p4h8
+#>p6h8
+#>p7h8
+#>p8h8
+#>p9h8
+#>p10h8
+#>-Con:
+#>=Pkg: p5h9 1 1 noarch
+#>=Prv: pigeon5
+#>+Con:
+#>p0h9
+#>p1h9
+#>p2h9
+#>p3h9
+#>p4h9
+#>p6h9
+#>p7h9
+#>p8h9
+#>p9h9
+#>p10h9
+#>-Con:
+#>=Pkg: p6h0 1 1 noarch
+#>=Prv: pigeon6
+#>+Con:
+#>p0h0
+#>p1h0
+#>p2h0
+#>p3h0
+#>p4h0
+#>p5h0
+#>p7h0
+#>p8h0
+#>p9h0
+#>p10h0
+#>-Con:
+#>=Pkg: p6h1 1 1 noarch
+#>=Prv: pigeon6
+#>+Con:
+#>p0h1
+#>p1h1
+#>p2h1
+#>p3h1
+#>p4h1
+#>p5h1
+#>p7h1
+#>p8h1
+#>p9h1
+#>p10h1
+#>-Con:
+#>=Pkg: p6h2 1 1 noarch
+#>=Prv: pigeon6
+#>+Con:
+#>p0h2
+#>p1h2
+#>p2h2
+#>p3h2
+#>p4h2
+#>p5h2
+#>p7h2
+#>p8h2
+#>p9h2
+#>p10h2
+#>-Con:
+#>=Pkg: p6h3 1 1 noarch
+#>=Prv: pigeon6
+#>+Con:
+#>p0h3
+#>p1h3
+#>p2h3
+#>p3h3
+#>p4h3
+#>p5h3
+#>p7h3
+#>p8h3
+#>p9h3
+#>p10h3
+#>-Con:
+#>=Pkg: p6h4 1 1 noarch
+#>=Prv: pigeon6
+#>+Con:
+#>p0h4
+#>p1h4
+#>p2h4
+#>p3h4
+#>p4h4
+#>p5h4
+#>p7h4
+#>p8h4
+#>p9h4
+#>p10h4
+#>-Con:
+#>=Pkg: p6h5 1 1 noarch
+#>=Prv: pigeon6
+#>+Con:
+#>p0h5
+#>p1h5
+#>p2h5
+#>p3h5
+#>p4h5
+#>p5h5
+#>p7h5
+#>p8h5
+#>p9h5
+#>p10h5
+#>-Con:
+#>=Pkg: p6h6 1 1 noarch
+#>=Prv: pigeon6
+#>+Con:
+#>p0h6
+#>p1h6
+#>p2h6
+#>p3h6
+#>p4h6
+#>p5h6
+#>p7h6
+#>p8h6
+#>p9h6
+#>p10h6
+#>-Con:
+#>=Pkg: p6h7 1 1 noarch
+#>=Prv: pigeon6
+#>+Con:
+#>p0h7
+#>p1h7
+#>p2h7
+#>p3h7
+#>p4h7
+#>p5h7
+#>p7h7
+#>p8h7
+#>p9h7
+#>p10h7
+#>-Con:
+#>=Pkg: p6h8 1 1 noarch
+#>=Prv: pigeon6
+#>+Con:
+#>p0h8
+#>p1h8
+#>p2h8
+#>p3h8
+#>p4h8
+#>p5h8
+#>p7h8
+#>p8h8
+#>p9h8
+#>p10h8
+#>-Con:
+#>=Pkg: p6h9 1 1 noarch
+#>=Prv: pigeon6
+#>+Con:
+#>p0h9
+#>p1h9
+#>p2h9
+#>p3h9
+#>p4h9
+#>p5h9
+#>p7h9
+#>p8h9
+#>p9h9
+#>p10h9
+#>-Con:
+#>=Pkg: p7h0 1 1 noarch
+#>=Prv: pigeon7
+#>+Con:
+#>p0h0
+#>p1h0
+#>p2h0
+#>p3h0
+#>p4h0
+#>p5h0
+#>p6h0
+#>p8h0
+#>p9h0
+#>p10h0
+#>-Con:
+#>=Pkg: p7h1 1 1 noarch
+#>=Prv: pigeon7
+#>+Con:
+#>p0h1
+#>p1h1
+#>p2h1
+#>p3h1
+#>p4h1
+#>p5h1
+#>p6h1
+#>p8h1
+#>p9h1
+#>p10h1
+#>-Con:
+#>=Pkg: p7h2 1 1 noarch
+#>=Prv: pigeon7
+#>+Con:
+#>p0h2
+#>p1h2
+#>p2h2
+#>p3h2
+#>p4h2
+#>p5h2
+#>p6h2
+#>p8h2
+#>p9h2
+#>p10h2
+#>-Con:
+#>=Pkg: p7h3 1 1 noarch
+#>=Prv: pigeon7
+#>+Con:
+#>p0h3
+#>p1h3
+#>p2h3
+#>p3h3
+#>p4h3
+#>p5h3
+#>p6h3
+#>p8h3
+#>p9h3
+#>p10h3
+#>-Con:
+#>=Pkg: p7h4 1 1 noarch
+#>=Prv: pigeon7
+#>+Con:
+#>p0h4
+#>p1h4
+#>p2h4
+#>p3h4
+#>p4h4
+#>p5h4
+#>p6h4
+#>p8h4
+#>p9h4
+#>p10h4
+#>-Con:
+#>=Pkg: p7h5 1 1 noarch
+#>=Prv: pigeon7
+#>+Con:
+#>p0h5
+#>p1h5
+#>p2h5
+#>p3h5
+#>p4h5
+#>p5h5
+#>p6h5
+#>p8h5
+#>p9h5
+#>p10h5
+#>-Con:
+#>=Pkg: p7h6 1 1 noarch
+#>=Prv: pigeon7
+#>+Con:
+#>p0h6
+#>p1h6
+#>p2h6
+#>p3h6
+#>p4h6
+#>p5h6
+#>p6h6
+#>p8h6
+#>p9h6
+#>p10h6
+#>-Con:
+#>=Pkg: p7h7 1 1 noarch
+#>=Prv: pigeon7
+#>+Con:
+#>p0h7
+#>p1h7
+#>p2h7
+#>p3h7
+#>p4h7
+#>p5h7
+#>p6h7
+#>p8h7
+#>p9h7
+#>p10h7
+#>-Con:
+#>=Pkg: p7h8 1 1 noarch
+#>=Prv: pigeon7
+#>+Con:
+#>p0h8
+#>p1h8
+#>p2h8
+#>p3h8
+#>p4h8
+#>p5h8
+#>p6h8
+#>p8h8
+#>p9h8
+#>p10h8
+#>-Con:
+#>=Pkg: p7h9 1 1 noarch
+#>=Prv: pigeon7
+#>+Con:
+#>p0h9
+#>p1h9
+#>p2h9
+#>p3h9
+#>p4h9
+#>p5h9
+#>p6h9
+#>p8h9
+#>p9h9
+#>p10h9
+#>-Con:
+#>=Pkg: p8h0 1 1 noarch
+#>=Prv: pigeon8
+#>+Con:
+#>p0h0
+#>p1h0
+#>p2h0
+#>p3h0
+#>p4h0
+#>p5h0
+#>p6h0
+#>p7h0
+#>p9h0
+#>p10h0
+#>-Con:
+#>=Pkg: p8h1 1 1 noarch
+#>=Prv: pigeon8
+#>+Con:
+#>p0h1
+#>p1h1
+#>p2h1
+#>p3h1
+#>p4h1
+#>p5h1
+#>p6h1
+#>p7h1
+#>p9h1
+#>p10h1
+#>-Con:
+#>=Pkg: p8h2 1 1 noarch
+#>=Prv: pigeon8
+#>+Con:
+#>p0h2
+#>p1h2
+#>p2h2
+#>p3h2
+#>p4h2
+#>p5h2
+#>p6h2
+#>p7h2
+#>p9h2
+#>p10h2
+#>-Con:
+#>=Pkg: p8h3 1 1 noarch
+#>=Prv: pigeon8
+#>+Con:
+#>p0h3
+#>p1h3
+#>p2h3
+#>p3h3
+#>p4h3
+#>p5h3
+#>p6h3
+#>p7h3
+#>p9h3
+#>p10h3
+#>-Con:
+#>=Pkg: p8h4 1 1 noarch
+#>=Prv: pigeon8
+#>+Con:
+#>p0h4
+#>p1h4
+#>p2h4
+#>p3h4
+#>p4h4
+#>p5h4
+#>p6h4
+#>p7h4
+#>p9h4
+#>p10h4
+#>-Con:
+#>=Pkg: p8h5 1 1 noarch
+#>=Prv: pigeon8
+#>+Con:
+#>p0h5
+#>p1h5
+#>p2h5
+#>p3h5
+#>p4h5
+#>p5h5
+#>p6h5
+#>p7h5
+#>p9h5
+#>p10h5
+#>-Con:
+#>=Pkg: p8h6 1 1 noarch
+#>=Prv: pigeon8
+#>+Con:
+#>p0h6
+#>p1h6
+#>p2h6
+#>p3h6
+#>p4h6
+#>p5h6
+#>p6h6
+#>p7h6
+#>p9h6
+#>p10h6
+#>-Con:
+#>=Pkg: p8h7 1 1 noarch
+#>=Prv: pigeon8
+#>+Con:
+#>p0h7
+#>p1h7
+#>p2h7
+#>p3h7
+#>p4h7
+#>p5h7
+#>p6h7
+#>p7h7
+#>p9h7
+#>p10h7
+#>-Con:
+#>=Pkg: p8h8 1 1 noarch
+#>=Prv: pigeon8
+#>+Con:
+#>p0h8
+#>p1h8
+#>p2h8
+#>p3h8
+#>p4h8
+#>p5h8
+#>p6h8
+#>p7h8
+#>p9h8
+#>p10h8
+#>-Con:
+#>=Pkg: p8h9 1 1 noarch
+#>=Prv: pigeon8
+#>+Con:
+#>p0h9
+#>p1h9
+#>p2h9
+#>p3h9
+#>p4h9
+#>p5h9
+#>p6h9
+#>p7h9
+#>p9h9
+#>p10h9
+#>-Con:
+#>=Pkg: p9h0 1 1 noarch
+#>=Prv: pigeon9
+#>+Con:
+#>p0h0
+#>p1h0
+#>p2h0
+#>p3h0
+#>p4h0
+#>p5h0
+#>p6h0
+#>p7h0
+#>p8h0
+#>p10h0
+#>-Con:
+#>=Pkg: p9h1 1 1 noarch
+#>=Prv: pigeon9
+#>+Con:
+#>p0h1
+#>p1h1
+#>p2h1
+#>p3h1
+#>p4h1
+#>p5h1
+#>p6h1
+#>p7h1
+#>p8h1
+#>p10h1
+#>-Con:
+#>=Pkg: p9h2 1 1 noarch
+#>=Prv: pigeon9
+#>+Con:
+#>p0h2
+#>p1h2
+#>p2h2
+#>p3h2
+#>p4h2
+#>p5h2
+#>p6h2
+#>p7h2
+#>p8h2
+#>p10h2
+#>-Con:
+#>=Pkg: p9h3 1 1 noarch
+#>=Prv: pigeon9
+#>+Con:
+#>p0h3
+#>p1h3
+#>p2h3
+#>p3h3
+#>p4h3
+#>p5h3
+#>p6h3
+#>p7h3
+#>p8h3
+#>p10h3
+#>-Con:
+#>=Pkg: p9h4 1 1 noarch
+#>=Prv: pigeon9
+#>+Con:
+#>p0h4
+#>p1h4
+#>p2h4
+#>p3h4
+#>p4h4
+#>p5h4
+#>p6h4
+#>p7h4
+#>p8h4
+#>p10h4
+#>-Con:
+#>=Pkg: p9h5 1 1 noarch
+#>=Prv: pigeon9
+#>+Con:
+#>p0h5
+#>p1h5
+#>p2h5
+#>p3h5
+#>p4h5
+#>p5h5
+#>p6h5
+#>p7h5
+#>p8h5
+#>p10h5
+#>-Con:
+#>=Pkg: p9h6 1 1 noarch
+#>=Prv: pigeon9
+#>+Con:
+#>p0h6
+#>p1h6
+#>p2h6
+#>p3h6
+#>p4h6
+#>p5h6
+#>p6h6
+#>p7h6
+#>p8h6
+#>p10h6
+#>-Con:
+#>=Pkg: p9h7 1 1 noarch
+#>=Prv: pigeon9
+#>+Con:
+#>p0h7
+#>p1h7
+#>p2h7
+#>p3h7
+#>p4h7
+#>p5h7
+#>p6h7
+#>p7h7
+#>p8h7
+#>p10h7
+#>-Con:
+#>=Pkg: p9h8 1 1 noarch
+#>=Prv: pigeon9
+#>+Con:
+#>p0h8
+#>p1h8
+#>p2h8
+#>p3h8
+#>p4h8
+#>p5h8
+#>p6h8
+#>p7h8
+#>p8h8
+#>p10h8
+#>-Con:
+#>=Pkg: p9h9 1 1 noarch
+#>=Prv: pigeon9
+#>+Con:
+#>p0h9
+#>p1h9
+#>p2h9
+#>p3h9
+#>p4h9
+#>p5h9
+#>p6h9
+#>p7h9
+#>p8h9
+#>p10h9
+#>-Con:
+#>=Pkg: p10h0 1 1 noarch
+#>=Prv: pigeon10
+#>+Con:
+#>p0h0
+#>p1h0
+#>p2h0
+#>p3h0
+#>p4h0
+#>p5h0
+#>p6h0
+#>p7h0
+#>p8h0
+#>p9h0
+#>-Con:
+#>=Pkg: p10h1 1 1 noarch
+#>=Prv: pigeon10
+#>+Con:
+#>p0h1
+#>p1h1
+#>p2h1
+#>p3h1
+#>p4h1
+#>p5h1
+#>p6h1
+#>p7h1
+#>p8h1
+#>p9h1
+#>-Con:
+#>=Pkg: p10h2 1 1 noarch
+#>=Prv: pigeon10
+#>+Con:
+#>p0h2
+#>p1h2
+#>p2h2
+#>p3h2
+#>p4h2
+#>p5h2
+#>p6h2
+#>p7h2
+#>p8h2
+#>p9h2
+#>-Con:
+#>=Pkg: p10h3 1 1 noarch
+#>=Prv: pigeon10
+#>+Con:
+#>p0h3
+#>p1h3
+#>p2h3
+#>p3h3
+#>p4h3
+#>p5h3
+#>p6h3
+#>p7h3
+#>p8h3
+#>p9h3
+#>-Con:
+#>=Pkg: p10h4 1 1 noarch
+#>=Prv: pigeon10
+#>+Con:
+#>p0h4
+#>p1h4
+#>p2h4
+#>p3h4
+#>p4h4
+#>p5h4
+#>p6h4
+#>p7h4
+#>p8h4
+#>p9h4
+#>-Con:
+#>=Pkg: p10h5 1 1 noarch
+#>=Prv: pigeon10
+#>+Con:
+#>p0h5
+#>p1h5
+#>p2h5
+#>p3h5
+#>p4h5
+#>p5h5
+#>p6h5
+#>p7h5
+#>p8h5
+#>p9h5
+#>-Con:
+#>=Pkg: p10h6 1 1 noarch
+#>=Prv: pigeon10
+#>+Con:
+#>p0h6
+#>p1h6
+#>p2h6
+#>p3h6
+#>p4h6
+#>p5h6
+#>p6h6
+#>p7h6
+#>p8h6
+#>p9h6
+#>-Con:
+#>=Pkg: p10h7 1 1 noarch
+#>=Prv: pigeon10
+#>+Con:
+#>p0h7
+#>p1h7
+#>p2h7
+#>p3h7
+#>p4h7
+#>p5h7
+#>p6h7
+#>p7h7
+#>p8h7
+#>p9h7
+#>-Con:
+#>=Pkg: p10h8 1 1 noarch
+#>=Prv: pigeon10
+#>+Con:
+#>p0h8
+#>p1h8
+#>p2h8
+#>p3h8
+#>p4h8
+#>p5h8
+#>p6h8
+#>p7h8
+#>p8h8
+#>p9h8
+#>-Con:
+#>=Pkg: p10h9 1 1 noarch
+#>=Prv: pigeon10
+#>+Con:
+#>p0h9
+#>p1h9
+#>p2h9
+#>p3h9
+#>p4h9
+#>p5h9
+#>p6h9
+#>p7h9
+#>p8h9
+#>p9h9
+#>-Con:
+system noarch rpm system
+solverflags timeout=1
+job install provides pigeon0
+job install provides pigeon1
+job install provides pigeon2
+job install provides pigeon3
+job install provides pigeon4
+job install provides pigeon5
+job install provides pigeon6
+job install provides pigeon7
+job install provides pigeon8
+job install provides pigeon9
+job install provides pigeon10
+result transaction,problems,stats <inline>
+#>stat aborted 1
+#>stat keptlearntrules 0
+#>stat lazyrounds 1
+#>stat reusedpkgrules 0
+nextjob reusesolver
+job install provides pigeon0
+job install provides pigeon1
+result transaction,problems,stats <inline>
+#>install p0h0-1-1.noarch@available
+#>install p1h1-1-1.noarch@available
+#>stat aborted 0
+#>stat keptlearntrules 0
+#>stat lazyrounds 1
+#>stat reusedpkgrules 550
@@ -0,0 +1,100 @@
+/*
+ * common.c
+ *
+ * helpers shared by the unit tests
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "repo_write.h"
+#include "testcase.h"
+
+#include "common.h"
+
+/* create a repository from testtags data */
+Repo *
+unit_addrepo(Pool *pool, const char *name, const char *testtags)
+{
+  Repo *repo = repo_create(pool, name);
+  FILE *fp = fmemopen((void *)testtags, strlen(testtags), "r");
+  if (!fp || testcase_add_testtags(repo, fp, 0))
+    {
+      fprintf(stderr, "could not add repo %s\n", name);
+      exit(1);
+    }
+  fclose(fp);
+  return repo;
+}
+
+/* the description of package i. It is long enough to fill many pages
+ * and different enough to not compress well */
+void
+unit_description(int i, char *buf)
+{
+  int j, l;
+
+  l = sprintf(buf, "the description of package %d:", i);
+  for (j = 0; j < 40; j++)
+    l += sprintf(buf + l, " %x", (unsigned int)(i * 2654435761u + j * 40503u));
+}
+
+/* create a repository with npkgs packages named pkg0, pkg1, ... Every
+ * package requires the previous one and has a file list, an install size
+ * and a description */
+Repo *
+unit_create_repo(Pool *pool, int npkgs)
+{
+  Repo *repo = repo_create(pool, "test");
+  Repodata *data = repo_add_repodata(repo, 0);
+  char buf[UNIT_DESCRIPTION_SIZE];
+  Solvable *s;
+  Id p, did;
+  int i, j;
+
+  for (i = 0; i < npkgs; i++)
+    {
+      p = repo_add_solvable(repo);
+      s = pool->solvables + p;
+      sprintf(buf, "pkg%d", i);
+      s->name = pool_str2id(pool, buf, 1);
+      s->evr = pool_str2id(pool, "1.0-1", 1);
+      s->arch = ARCH_NOARCH;
+      s->provides = repo_addid_dep(repo, s->provides, pool_rel2id(pool, s->name, s->evr, REL_EQ, 1), 0);
+      if (i)
+	{
+	  sprintf(buf, "pkg%d", i - 1);
+	  s->requires = repo_addid_dep(repo, s->requires, pool_str2id(pool, buf, 1), 0);
+	}
+      sprintf(buf, "/usr/share/pkg%d", i);
+      did = repodata_str2dir(data, buf, 1);
+      for (j = 0; j < 5; j++)
+	{
+	  sprintf(buf, "file%d", j);
+	  repodata_add_dirstr(data, p, SOLVABLE_FILELIST, did, buf);
+	}
+      repodata_set_num(data, p, SOLVABLE_INSTALLSIZE, i * 1024);
+      unit_description(i, buf);
+      repodata_set_str(data, p, SOLVABLE_DESCRIPTION, buf);
+    }
+  repo_internalize(repo);
+  return repo;
+}
+
+/* write a solv file with the unit_create_repo repository */
+void
+unit_write_solv(FILE *fp, int npkgs)
+{
+  Pool *pool = pool_create();
+  Repo *repo = unit_create_repo(pool, npkgs);
+
+  if (repo_write(repo, fp))
+    {
+      fprintf(stderr, "repo_write: %s\n", pool_errstr(pool));
+      exit(1);
+    }
+  pool_free(pool);
+}
@@ -0,0 +1,23 @@
+/*
+ * common.h
+ *
+ * helpers shared by the unit tests
+ */
+
+#ifndef UNIT_COMMON_H
+#define UNIT_COMMON_H
+
+#include <stdio.h>
+
+#include "pool.h"
+#include "repo.h"
+
+/* size of the buffer needed by unit_description */
+#define UNIT_DESCRIPTION_SIZE	1024
+
+Repo *unit_addrepo(Pool *pool, const char *name, const char *testtags);
+void unit_description(int i, char *buf);
+Repo *unit_create_repo(Pool *pool, int npkgs);
+void unit_write_solv(FILE *fp, int npkgs);
+
+#endif
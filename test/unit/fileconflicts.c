@@ -0,0 +1,340 @@
+/*
+ * fileconflicts.c
+ *
+ * check that pool_findfileconflicts finds the same conflicts with and
+ * without FINDFILECONFLICTS_THREADED. The rpm headers are created in
+ * memory. On a single cpu the threaded mode falls back to the serial
+ * code, so both runs take the same path there.
+ * Also check that a corrupt file conflict info is not used.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "repo_rpmdb.h"
+#include "pool_fileconflicts.h"
+#include "solv_xfopen.h"
+
+#define NPKGS	120
+
+#define TAG_NAME	1000
+#define TAG_VERSION	1001
+#define TAG_RELEASE	1002
+#define TAG_FILESIZES	1028
+#define TAG_FILEMODES	1030
+#define TAG_FILEMD5S	1035
+#define TAG_FILEFLAGS	1037
+#define TAG_DIRINDEXES	1116
+#define TAG_BASENAMES	1117
+#define TAG_DIRNAMES	1118
+
+#define TYPE_INT16	3
+#define TYPE_INT32	4
+#define TYPE_STRING	6
+#define TYPE_STRING_ARRAY	8
+
+struct blob {
+  unsigned char *buf;
+  int len;
+};
+
+static void
+blob_add(struct blob *b, const void *d, int l)
+{
+  b->buf = solv_extend(b->buf, b->len, l, 1, 4095);
+  memcpy(b->buf + b->len, d, l);
+  b->len += l;
+}
+
+static void
+blob_add32(struct blob *b, unsigned int x)
+{
+  unsigned char d[4];
+  d[0] = x >> 24;
+  d[1] = x >> 16;
+  d[2] = x >> 8;
+  d[3] = x;
+  blob_add(b, d, 4);
+}
+
+static void
+blob_add16(struct blob *b, unsigned int x)
+{
+  unsigned char d[2];
+  d[0] = x >> 8;
+  d[1] = x;
+  blob_add(b, d, 2);
+}
+
+struct header {
+  struct blob index;
+  struct blob data;
+  int cnt;
+};
+
+/* start a new tag, the caller then adds the tag data */
+static void
+header_tag(struct header *h, int tag, int type, int cnt)
+{
+  int align = type == TYPE_INT32 ? 4 : type == TYPE_INT16 ? 2 : 1;
+  while (h->data.len % align)
+    blob_add(&h->data, "", 1);
+  blob_add32(&h->index, tag);
+  blob_add32(&h->index, type);
+  blob_add32(&h->index, h->data.len);
+  blob_add32(&h->index, cnt);
+  h->cnt++;
+}
+
+static void
+header_str(struct header *h, int tag, const char *str)
+{
+  header_tag(h, tag, TYPE_STRING, 1);
+  blob_add(&h->data, str, strlen(str) + 1);
+}
+
+struct file {
+  int dir;
+  char base[32];
+  int mode;
+  unsigned int md5;	/* 0: no md5 */
+};
+
+static const char *dirnames[] = { "/usr/bin/", "/etc/", "/usr/share/", 0 };
+
+/* the files of package n. Some packages share a file with the
+ * same md5sum, some with a different one, and some have a file
+ * where another package has a directory */
+static int
+pkgfiles(int n, struct file *files)
+{
+  int i, nfiles = 0;
+
+  memset(files, 0, 16 * sizeof(*files));
+  files[nfiles].dir = 2;
+  sprintf(files[nfiles].base, "pkg%03d", n);
+  files[nfiles++].mode = 040755;
+  for (i = 0; i < 10; i++)
+    {
+      files[nfiles].dir = 3;
+      sprintf(files[nfiles].base, "f%d", i);
+      files[nfiles].mode = 0100644;
+      files[nfiles++].md5 = n * 100 + i + 1;
+    }
+  files[nfiles].dir = 0;
+  sprintf(files[nfiles].base, "tool%d", n % 25);
+  files[nfiles].mode = 0100755;
+  files[nfiles++].md5 = n % 3 ? 1 : n + 1000;
+  if (n % 7 == 0)
+    {
+      files[nfiles].dir = 1;
+      sprintf(files[nfiles].base, "conf%d", n % 5);
+      files[nfiles].mode = 0100644;
+      files[nfiles++].md5 = n + 2000;
+    }
+  if (n % 11 == 0)
+    {
+      files[nfiles].dir = 2;
+      sprintf(files[nfiles].base, "pkg%03d", (n + 1) % NPKGS);
+      files[nfiles].mode = 0100644;
+      files[nfiles++].md5 = n + 3000;
+    }
+  return nfiles;
+}
+
+static void
+create_rpm(int n, struct blob *rpm)
+{
+  struct header h;
+  struct file files[16];
+  unsigned char lead[96];
+  char name[32], md5[33];
+  int i, nfiles;
+
+  memset(&h, 0, sizeof(h));
+  nfiles = pkgfiles(n, files);
+  sprintf(name, "pkg%03d", n);
+  header_str(&h, TAG_NAME, name);
+  header_str(&h, TAG_VERSION, "1.0");
+  header_str(&h, TAG_RELEASE, "1");
+  header_tag(&h, TAG_FILESIZES, TYPE_INT32, nfiles);
+  for (i = 0; i < nfiles; i++)
+    blob_add32(&h.data, 1);
+  header_tag(&h, TAG_FILEMODES, TYPE_INT16, nfiles);
+  for (i = 0; i < nfiles; i++)
+    blob_add16(&h.data, files[i].mode);
+  header_tag(&h, TAG_FILEMD5S, TYPE_STRING_ARRAY, nfiles);
+  for (i = 0; i < nfiles; i++)
+    {
+      if (files[i].md5)
+	sprintf(md5, "%032x", files[i].md5);
+      else
+	md5[0] = 0;
+      blob_add(&h.data, md5, strlen(md5) + 1);
+    }
+  header_tag(&h, TAG_FILEFLAGS, TYPE_INT32, nfiles);
+  for (i = 0; i < nfiles; i++)
+    blob_add32(&h.data, 0);
+  header_tag(&h, TAG_DIRINDEXES, TYPE_INT32, nfiles);
+  for (i = 0; i < nfiles; i++)
+    blob_add32(&h.data, files[i].dir);
+  header_tag(&h, TAG_BASENAMES, TYPE_STRING_ARRAY, nfiles);
+  for (i = 0; i < nfiles; i++)
+    blob_add(&h.data, files[i].base, strlen(files[i].base) + 1);
+  header_tag(&h, TAG_DIRNAMES, TYPE_STRING_ARRAY, 4);
+  for (i = 0; i < 3; i++)
+    blob_add(&h.data, dirnames[i], strlen(dirnames[i]) + 1);
+  sprintf(name, "/usr/share/pkg%03d/", n);
+  blob_add(&h.data, name, strlen(name) + 1);
+
+  /* lead, empty signature header, header */
+  memset(rpm, 0, sizeof(*rpm));
+  memset(lead, 0, sizeof(lead));
+  lead[0] = 0xed;
+  lead[1] = 0xab;
+  lead[2] = 0xee;
+  lead[3] = 0xdb;
+  lead[4] = 3;
+  lead[79] = 5;
+  blob_add(rpm, lead, sizeof(lead));
+  blob_add32(rpm, 0x8eade801);
+  blob_add32(rpm, 0);
+  blob_add32(rpm, 0);
+  blob_add32(rpm, 0);
+  blob_add32(rpm, 0x8eade801);
+  blob_add32(rpm, 0);
+  blob_add32(rpm, h.cnt);
+  blob_add32(rpm, h.data.len);
+  blob_add(rpm, h.index.buf, h.index.len);
+  blob_add(rpm, h.data.buf, h.data.len);
+  solv_free(h.index.buf);
+  solv_free(h.data.buf);
+}
+
+struct fcdata {
+  Repo *repo;
+  struct blob rpms[NPKGS];
+  /* one rpm state per package: a package is only fetched by one thread
+   * at a time, and the handle stays valid until the state is reused */
+  void *rpmstates[NPKGS];
+};
+
+static void *
+handle_cb(Pool *pool, Id p, void *cbdata)
+{
+  struct fcdata *fcdata = cbdata;
+  int n = p - fcdata->repo->start;
+  FILE *fp;
+  void *handle;
+
+  fp = solv_fmemopen((const char *)fcdata->rpms[n].buf, fcdata->rpms[n].len, "r");
+  if (!fp)
+    return 0;
+  handle = rpm_byfp(fcdata->rpmstates[n], fp, "test");
+  fclose(fp);
+  return handle;
+}
+
+static void
+count_cb(void *cbdata, const char *fn, struct filelistinfo *info)
+{
+  (*(int *)cbdata)++;
+}
+
+/* a truncated file conflict info must be rejected as a whole, so that
+ * the caller falls back to the rpm header */
+static int
+check_corrupt_info(Pool *pool, struct fcdata *fcdata)
+{
+  Repo *repo = repo_create(pool, "info");
+  const unsigned char *info;
+  void *handle;
+  Id p;
+  int infol, cnt, failed = 0;
+
+  handle = handle_cb(pool, fcdata->repo->start, fcdata);
+  p = handle ? repo_add_rpm_handle(repo, handle, RPM_ADD_WITH_FILECONFLICTINFO) : 0;
+  repo_internalize(repo);
+  info = p ? repo_lookup_binary(repo, p, SOLVABLE_FILECONFLICTINFO, &infol) : 0;
+  if (!info)
+    {
+      fprintf(stderr, "no file conflict info\n");
+      return 1;
+    }
+  cnt = 0;
+  if (!rpm_iterate_fileconflictinfo(info, infol, 0, count_cb, &cnt) || !cnt)
+    {
+      fprintf(stderr, "file conflict info not usable\n");
+      failed = 1;
+    }
+  cnt = 0;
+  if (rpm_iterate_fileconflictinfo(info, infol - 1, 0, count_cb, &cnt) || cnt)
+    {
+      fprintf(stderr, "truncated file conflict info used, %d files\n", cnt);
+      failed = 1;
+    }
+  repo_free(repo, 1);
+  return failed;
+}
+
+int
+main()
+{
+  Pool *pool = pool_create();
+  struct fcdata fcdata;
+  Queue pkgs, serial, threaded;
+  char name[16];
+  int i, n, failed = 0;
+  static int flagsets[] = { 0, FINDFILECONFLICTS_CHECK_DIRALIASING | FINDFILECONFLICTS_USE_ROOTDIR };
+
+  queue_init(&pkgs);
+  queue_init(&serial);
+  queue_init(&threaded);
+  fcdata.repo = repo_create(pool, "test");
+  for (n = 0; n < NPKGS; n++)
+    {
+      Id p = repo_add_solvable(fcdata.repo);
+      Solvable *s = pool->solvables + p;
+      sprintf(name, "pkg%03d", n);
+      s->name = pool_str2id(pool, name, 1);
+      s->evr = pool_str2id(pool, "1.0-1", 1);
+      s->arch = ARCH_NOARCH;
+      queue_push(&pkgs, p);
+      create_rpm(n, fcdata.rpms + n);
+      fcdata.rpmstates[n] = rpm_state_create(pool, 0);
+    }
+  pool_createwhatprovides(pool);
+
+  for (i = 0; i < sizeof(flagsets) / sizeof(*flagsets); i++)
+    {
+      pool_findfileconflicts(pool, &pkgs, NPKGS / 2, &serial, flagsets[i], handle_cb, &fcdata);
+      pool_findfileconflicts(pool, &pkgs, NPKGS / 2, &threaded, flagsets[i] | FINDFILECONFLICTS_THREADED, handle_cb, &fcdata);
+      if (!serial.count)
+	{
+	  fprintf(stderr, "flags %d: no conflicts found\n", flagsets[i]);
+	  failed = 1;
+	}
+      if (serial.count != threaded.count || memcmp(serial.elements, threaded.elements, serial.count * sizeof(Id)) != 0)
+	{
+	  fprintf(stderr, "flags %d: serial and threaded conflicts differ (%d/%d)\n", flagsets[i], serial.count, threaded.count);
+	  failed = 1;
+	}
+    }
+
+  if (check_corrupt_info(pool, &fcdata))
+    failed = 1;
+
+  for (n = 0; n < NPKGS; n++)
+    {
+      rpm_state_free(fcdata.rpmstates[n]);
+      solv_free(fcdata.rpms[n].buf);
+    }
+  queue_free(&pkgs);
+  queue_free(&serial);
+  queue_free(&threaded);
+  pool_free(pool);
+  return failed;
+}
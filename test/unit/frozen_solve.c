@@ -0,0 +1,157 @@
+/*
+ * frozen_solve.c
+ *
+ * check that solvers running in multiple threads on a frozen pool
+ * get the same results as serial solves, and that the whatprovidesdata
+ * area does not move while they are running
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "solver.h"
+
+#define NPKGS		1000
+#define NJOBS		48
+#define NTHREADS	4
+#define NSOLVERS	(NJOBS / NTHREADS)	/* alive at the same time per thread */
+
+static Pool *pool;
+static Queue results[NJOBS];
+static pthread_barrier_t barrier;
+
+static void
+create_pool(void)
+{
+  Repo *repo;
+  char buf[64];
+  int i, v;
+
+  pool = pool_create();
+  pool_setarch(pool, "noarch");
+  repo = repo_create(pool, "test");
+  for (i = 0; i < NPKGS; i++)
+    for (v = 1; v <= 2; v++)
+      {
+	Id p = repo_add_solvable(repo);
+	Solvable *s = pool->solvables + p;
+	sprintf(buf, "pkg%d", i);
+	s->name = pool_str2id(pool, buf, 1);
+	s->evr = pool_str2id(pool, v == 1 ? "1.0-1" : "2.0-1", 1);
+	s->arch = ARCH_NOARCH;
+	s->provides = repo_addid_dep(repo, s->provides, pool_rel2id(pool, s->name, s->evr, REL_EQ, 1), 0);
+	/* every capability is provided by many packages */
+	sprintf(buf, "cap%d", i % 50);
+	s->provides = repo_addid_dep(repo, s->provides, pool_str2id(pool, buf, 1), 0);
+	sprintf(buf, "cap%d", (i * 7 + v) % 50);
+	s->requires = repo_addid_dep(repo, s->requires, pool_str2id(pool, buf, 1), 0);
+	if ((i + 1) % 10 != 0)
+	  {
+	    sprintf(buf, "pkg%d", i + 1);
+	    s->requires = repo_addid_dep(repo, s->requires, pool_str2id(pool, buf, 1), 0);
+	  }
+	if (v == 2 && i % 3 == 0)
+	  {
+	    sprintf(buf, "pkg%d", (i + 2) % NPKGS);
+	    s->conflicts = repo_addid_dep(repo, s->conflicts, pool_rel2id(pool, pool_str2id(pool, buf, 1), pool_str2id(pool, "1.0-1", 1), REL_EQ, 1), 0);
+	  }
+      }
+  repo_internalize(repo);
+  pool_createwhatprovides(pool);
+}
+
+static Solver *
+solve(int n)
+{
+  Solver *solv = solver_create(pool);
+  Queue job;
+  char buf[64];
+
+  queue_init(&job);
+  sprintf(buf, "pkg%d", n * (NPKGS / NJOBS));
+  queue_push2(&job, SOLVER_INSTALL | SOLVER_SOLVABLE_NAME, pool_str2id(pool, buf, 0));
+  solver_solve(solv, &job);
+  queue_free(&job);
+  return solv;
+}
+
+static void
+getresult(Solver *solv, Queue *q)
+{
+  int problems = solver_problem_count(solv);
+  solver_get_decisionqueue(solv, q);
+  queue_push(q, problems);
+}
+
+static void *
+solve_thread(void *arg)
+{
+  int t = (int)(long)arg;
+  Solver *solvs[NSOLVERS];
+  int i;
+
+  for (i = 0; i < NSOLVERS; i++)
+    solvs[i] = solve(t + i * NTHREADS);
+  /* keep all solvers alive until every thread got its blocks */
+  pthread_barrier_wait(&barrier);
+  for (i = 0; i < NSOLVERS; i++)
+    {
+      getresult(solvs[i], results + t + i * NTHREADS);
+      solver_free(solvs[i]);
+    }
+  return 0;
+}
+
+int
+main()
+{
+  pthread_t threads[NTHREADS];
+  Queue q;
+  Id *olddata;
+  int i, failed = 0;
+
+  create_pool();
+  pool_freeze(pool);
+  queue_init(&q);
+  for (i = 0; i < NJOBS; i++)
+    queue_init(results + i);
+  olddata = pool->whatprovidesdata;
+
+  pthread_barrier_init(&barrier, 0, NTHREADS);
+  for (i = 0; i < NTHREADS; i++)
+    if (pthread_create(threads + i, 0, solve_thread, (void *)(long)i) != 0)
+      {
+	perror("pthread_create");
+	exit(1);
+      }
+  for (i = 0; i < NTHREADS; i++)
+    pthread_join(threads[i], 0);
+  pthread_barrier_destroy(&barrier);
+  if (sizeof(size_t) > 4 && pool->whatprovidesdata != olddata)
+    {
+      fprintf(stderr, "the whatprovidesdata area moved\n");
+      failed = 1;
+    }
+
+  /* compare with serial solves */
+  for (i = 0; i < NJOBS; i++)
+    {
+      Solver *solv = solve(i);
+      getresult(solv, &q);
+      solver_free(solv);
+      if (q.count != results[i].count || memcmp(q.elements, results[i].elements, q.count * sizeof(Id)) != 0)
+	{
+	  fprintf(stderr, "job %d: threaded result differs from the serial one\n", i);
+	  failed = 1;
+	}
+      queue_free(results + i);
+    }
+  queue_free(&q);
+  pool_unfreeze(pool);
+  pool_free(pool);
+  return failed;
+}
@@ -0,0 +1,134 @@
+/*
+ * pagecache.c
+ *
+ * check the statistics of the repodata page cache with a tiny budget
+ * and with the default one, and that the paged data reads back right
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "repo_solv.h"
+#include "repo_write.h"
+
+#include "common.h"
+
+#define NPKGS	2000
+
+/* look up all descriptions, return the number of wrong ones */
+static int
+lookup_all(Repo *repo)
+{
+  Pool *pool = repo->pool;
+  char buf[UNIT_DESCRIPTION_SIZE];
+  const char *str;
+  int i, bad = 0;
+
+  for (i = 0; i < NPKGS; i++)
+    {
+      str = solvable_lookup_str(pool->solvables + repo->start + i, SOLVABLE_DESCRIPTION);
+      unit_description(i, buf);
+      if (!str || strcmp(str, buf) != 0)
+	bad++;
+    }
+  return bad;
+}
+
+static Pool *
+load(FILE *fp, unsigned int budget, Repo **repop)
+{
+  Pool *pool = pool_create();
+  Repo *repo = repo_create(pool, "test");
+
+  if (budget)
+    pool_set_pagecache_size(pool, budget);
+  rewind(fp);
+  if (repo_add_solv(repo, fp, 0))
+    {
+      fprintf(stderr, "repo_add_solv: %s\n", pool_errstr(pool));
+      exit(1);
+    }
+  *repop = repo;
+  return pool;
+}
+
+int
+main()
+{
+  FILE *fp = tmpfile();
+  Pool *pool;
+  Repo *repo;
+  int hits, npages, failed = 0;
+
+  if (!fp)
+    {
+      perror("tmpfile");
+      exit(1);
+    }
+  unit_write_solv(fp, NPKGS);
+
+  /* a budget below the minimum: the store keeps 4 pages and a
+   * sequential scan reads every page once */
+  pool = load(fp, 1, &repo);
+  if (lookup_all(repo))
+    {
+      fprintf(stderr, "tiny budget: wrong descriptions\n");
+      failed = 1;
+    }
+  npages = pool_get_stat(pool, POOL_STAT_PAGECACHE_MISSES);
+  hits = pool_get_stat(pool, POOL_STAT_PAGECACHE_HITS);
+  if (npages < 8)
+    {
+      fprintf(stderr, "tiny budget: only %d pages\n", npages);
+      failed = 1;
+    }
+  if (hits < NPKGS - npages)
+    {
+      fprintf(stderr, "tiny budget: %d hits for %d lookups\n", hits, NPKGS);
+      failed = 1;
+    }
+  if (pool_get_stat(pool, POOL_STAT_PAGECACHE_EVICTIONS) < npages - 4)
+    {
+      fprintf(stderr, "tiny budget: %d evictions, expected at least %d\n", pool_get_stat(pool, POOL_STAT_PAGECACHE_EVICTIONS), npages - 4);
+      failed = 1;
+    }
+  if (pool_get_stat(pool, POOL_STAT_PAGECACHE_MEMORY) != 4 * 32)
+    {
+      fprintf(stderr, "tiny budget: %d kB used\n", pool_get_stat(pool, POOL_STAT_PAGECACHE_MEMORY));
+      failed = 1;
+    }
+  /* the second scan reads everything again */
+  if (lookup_all(repo) || pool_get_stat(pool, POOL_STAT_PAGECACHE_MISSES) != 2 * npages)
+    {
+      fprintf(stderr, "tiny budget: second scan had %d misses\n", pool_get_stat(pool, POOL_STAT_PAGECACHE_MISSES) - npages);
+      failed = 1;
+    }
+  pool_free(pool);
+
+  /* with the default budget all pages stay in the cache */
+  pool = load(fp, 0, &repo);
+  lookup_all(repo);
+  hits = pool_get_stat(pool, POOL_STAT_PAGECACHE_HITS);
+  if (lookup_all(repo))
+    {
+      fprintf(stderr, "default budget: wrong descriptions\n");
+      failed = 1;
+    }
+  if (pool_get_stat(pool, POOL_STAT_PAGECACHE_MISSES) != npages || pool_get_stat(pool, POOL_STAT_PAGECACHE_EVICTIONS) != 0)
+    {
+      fprintf(stderr, "default budget: %d misses, %d evictions\n", pool_get_stat(pool, POOL_STAT_PAGECACHE_MISSES), pool_get_stat(pool, POOL_STAT_PAGECACHE_EVICTIONS));
+      failed = 1;
+    }
+  if (pool_get_stat(pool, POOL_STAT_PAGECACHE_HITS) - hits < NPKGS)
+    {
+      fprintf(stderr, "default budget: %d hits in the second scan\n", pool_get_stat(pool, POOL_STAT_PAGECACHE_HITS) - hits);
+      failed = 1;
+    }
+  pool_free(pool);
+
+  fclose(fp);
+  return failed;
+}
@@ -0,0 +1,41 @@
+/*
+ * pool_staging.c
+ *
+ * check that a staging pool gets all flags of its parent pool
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "pool.h"
+#include "pool_staging.h"
+
+int
+main()
+{
+  Pool *pool = pool_create();
+  Pool *spool;
+  int flag, nflags = 0, bad = 0;
+
+  /* invert every known flag, pool_get_flag returns -1 for unknown flags */
+  for (flag = 1; pool_get_flag(pool, flag) != -1; flag++)
+    {
+      pool_set_flag(pool, flag, !pool_get_flag(pool, flag));
+      nflags++;
+    }
+  if (!nflags)
+    {
+      fprintf(stderr, "no pool flags found\n");
+      exit(1);
+    }
+  spool = pool_create_staging(pool);
+  for (flag = 1; flag <= nflags; flag++)
+    if (pool_get_flag(spool, flag) != pool_get_flag(pool, flag))
+      {
+	fprintf(stderr, "pool flag %d was not copied to the staging pool\n", flag);
+	bad = 1;
+      }
+  pool_free(spool);
+  pool_free(pool);
+  return bad;
+}
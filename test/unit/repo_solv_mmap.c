@@ -0,0 +1,74 @@
+/*
+ * repo_solv_mmap.c
+ *
+ * check that reading a solv file via SOLV_ADD_MMAP gives the same
+ * repository as reading it via stdio
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "repo_solv.h"
+#include "repo_write.h"
+
+#include "common.h"
+
+/* read the solv file and write it again, the result is the
+ * serialized repository */
+static char *
+roundtrip(FILE *fp, int flags, size_t *lenp)
+{
+  Pool *pool = pool_create();
+  Repo *repo = repo_create(pool, "test");
+  char *out = 0;
+  FILE *ofp;
+
+  rewind(fp);
+  if (repo_add_solv(repo, fp, flags))
+    {
+      fprintf(stderr, "repo_add_solv: %s\n", pool_errstr(pool));
+      exit(1);
+    }
+  ofp = open_memstream(&out, lenp);
+  repo_write(repo, ofp);
+  fclose(ofp);
+  pool_free(pool);
+  return out;
+}
+
+int
+main()
+{
+  FILE *fp = tmpfile();
+  char *a, *b;
+  size_t alen, blen;
+
+  if (!fp)
+    {
+      perror("tmpfile");
+      exit(1);
+    }
+  unit_write_solv(fp, 3000);
+  /* files ending on a page boundary are not mapped */
+  fflush(fp);
+  if (ftell(fp) % sysconf(_SC_PAGESIZE) == 0)
+    {
+      fprintf(stderr, "solv file ends on a page boundary\n");
+      exit(1);
+    }
+  a = roundtrip(fp, 0, &alen);
+  b = roundtrip(fp, SOLV_ADD_MMAP, &blen);
+  if (alen != blen || memcmp(a, b, alen) != 0)
+    {
+      fprintf(stderr, "mmap and stdio reads differ\n");
+      exit(1);
+    }
+  free(a);
+  free(b);
+  fclose(fp);
+  return 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * rulecache.c
+ *
+ * check that pkg rules read from the rule cache give the same result
+ * as freshly created rules, and that they are not used for a job that
+ * needs different rules
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "solver.h"
+
+#include "common.h"
+
+static const char *installed =
+  "=Pkg: kernel 1 1 noarch\n"
+  "=Pkg: app 1 1 noarch\n"
+  "=Req: lib\n"
+  "=Pkg: lib 1 1 noarch\n";
+
+static const char *available =
+  "=Pkg: kernel 2 1 noarch\n"
+  "=Pkg: app 2 1 noarch\n"
+  "=Req: lib >= 2\n"
+  "=Pkg: lib 2 1 noarch\n";
+
+static Id
+findsolvable(Pool *pool, Repo *repo, const char *name)
+{
+  Id p;
+  Solvable *s;
+  FOR_REPO_SOLVABLES(repo, p, s)
+    if (!strcmp(pool_id2str(pool, s->name), name))
+      return p;
+  fprintf(stderr, "%s not found\n", name);
+  exit(1);
+}
+
+static char *
+writerules(Solver *solv, size_t *lenp)
+{
+  char *buf = 0;
+  FILE *fp = open_memstream(&buf, lenp);
+  if (!fp || solver_write_pkgrules(solv, fp))
+    {
+      fprintf(stderr, "could not write the rule cache\n");
+      exit(1);
+    }
+  fclose(fp);
+  return buf;
+}
+
+static int
+readrules(Solver *solv, char *buf, size_t len)
+{
+  FILE *fp = fmemopen(buf, len, "r");
+  int r = solver_read_pkgrules(solv, fp);
+  fclose(fp);
+  return r;
+}
+
+static int
+samedecisions(Solver *solv1, Solver *solv2)
+{
+  Queue q1, q2;
+  int r;
+  queue_init(&q1);
+  queue_init(&q2);
+  solver_get_decisionqueue(solv1, &q1);
+  solver_get_decisionqueue(solv2, &q2);
+  r = q1.count == q2.count && !memcmp(q1.elements, q2.elements, q1.count * sizeof(Id));
+  queue_free(&q1);
+  queue_free(&q2);
+  return r;
+}
+
+int
+main()
+{
+  Pool *pool = pool_create();
+  Repo *system, *repo;
+  Solver *solv, *rsolv;
+  Queue job, mjob;
+  Id kernel1, kernel2;
+  char *buf, *rbuf;
+  size_t len, rlen;
+  int bad = 0;
+
+  pool_setdisttype(pool, DISTTYPE_RPM);
+  pool_setarch(pool, "noarch");
+  system = unit_addrepo(pool, "system", installed);
+  repo = unit_addrepo(pool, "available", available);
+  pool_set_installed(pool, system);
+  pool_addfileprovides(pool);
+  pool_createwhatprovides(pool);
+  kernel1 = findsolvable(pool, system, "kernel");
+  kernel2 = findsolvable(pool, repo, "kernel");
+
+  queue_init(&job);
+  queue_push2(&job, SOLVER_INSTALL | SOLVER_SOLVABLE, kernel2);
+  queue_push2(&job, SOLVER_UPDATE | SOLVER_SOLVABLE_ALL, 0);
+  queue_init_clone(&mjob, &job);
+  queue_push2(&mjob, SOLVER_MULTIVERSION | SOLVER_SOLVABLE_NAME, pool_str2id(pool, "kernel", 1));
+
+  solv = solver_create(pool);
+  solver_solve(solv, &job);
+  buf = writerules(solv, &len);
+
+  /* round trip: same rules and same result as a fresh solver */
+  rsolv = solver_create(pool);
+  if (readrules(rsolv, buf, len))
+    {
+      fprintf(stderr, "could not read the rule cache: %s\n", pool_errstr(pool));
+      exit(1);
+    }
+  solver_solve(rsolv, &job);
+  if (solver_get_stat(rsolv, SOLVER_STAT_REUSED_PKG_RULES) != solver_get_stat(solv, SOLVER_STAT_PKG_RULES))
+    {
+      fprintf(stderr, "the cached pkg rules were not used\n");
+      bad = 1;
+    }
+  if (!samedecisions(solv, rsolv))
+    {
+      fprintf(stderr, "different result with the cached pkg rules\n");
+      bad = 1;
+    }
+  rbuf = writerules(rsolv, &rlen);
+  if (rlen != len || memcmp(buf, rbuf, len) != 0)
+    {
+      fprintf(stderr, "the rule cache changed in the round trip\n");
+      bad = 1;
+    }
+  free(rbuf);
+  solver_free(rsolv);
+  solver_free(solv);
+
+  /* multiversion needs different rules, the cached ones must not be used */
+  solv = solver_create(pool);
+  solver_solve(solv, &mjob);
+  rsolv = solver_create(pool);
+  if (readrules(rsolv, buf, len))
+    {
+      fprintf(stderr, "could not read the rule cache: %s\n", pool_errstr(pool));
+      exit(1);
+    }
+  solver_solve(rsolv, &mjob);
+  if (solver_get_stat(rsolv, SOLVER_STAT_REUSED_PKG_RULES) != 0)
+    {
+      fprintf(stderr, "the cached pkg rules were used for a multiversion job\n");
+      bad = 1;
+    }
+  if (!samedecisions(solv, rsolv) || solver_get_decisionlevel(rsolv, kernel1) <= 0)
+    {
+      fprintf(stderr, "wrong result for the multiversion job\n");
+      bad = 1;
+    }
+  solver_free(rsolv);
+  solver_free(solv);
+
+  /* a changed pool setting must make the cache be rejected */
+  pool_set_flag(pool, POOL_FLAG_FORBIDSELFCONFLICTS, !pool_get_flag(pool, POOL_FLAG_FORBIDSELFCONFLICTS));
+  rsolv = solver_create(pool);
+  if (!readrules(rsolv, buf, len))
+    {
+      fprintf(stderr, "the rule cache was accepted for a different pool\n");
+      bad = 1;
+    }
+  solver_free(rsolv);
+
+  free(buf);
+  queue_free(&mjob);
+  queue_free(&job);
+  pool_free(pool);
+  return bad;
+}
@@ -0,0 +1,107 @@
+/*
+ * whatprovides_update.c
+ *
+ * check that the incremental whatprovides update creates the same
+ * index as pool_createwhatprovides does from scratch
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pool.h"
+#include "repo.h"
+
+#include "common.h"
+
+static const char *repo1 =
+  "=Pkg: a 1 1 noarch\n"
+  "=Prv: foo = 1\n"
+  "=Req: bar\n"
+  "=Fls: /opt/a\n"
+  "=Pkg: b 1 1 noarch\n"
+  "=Prv: bar\n"
+  "=Fls: /opt/b\n";
+
+static const char *repo2 =
+  "=Pkg: a 2 1 noarch\n"
+  "=Prv: foo = 2\n"
+  "=Fls: /opt/a\n"
+  "=Pkg: c 1 1 noarch\n"
+  "=Prv: bar\n"
+  "=Prv: baz\n"
+  "=Fls: /opt/b\n"
+  "=Fls: /opt/c\n";
+
+static int
+nproviders(Pool *pool, Id dep)
+{
+  Id p, pp;
+  int n = 0;
+  FOR_PROVIDES(p, pp, dep)
+    n++;
+  return n;
+}
+
+static int
+check(Pool *pool, const char *what)
+{
+  int bad = pool_checkwhatprovides(pool);
+  if (bad)
+    fprintf(stderr, "%s: %d whatprovides mismatches\n", what, bad);
+  return bad ? 1 : 0;
+}
+
+int
+main()
+{
+  Pool *pool = pool_create();
+  Repo *repo;
+  Id foo, bar, file;
+  int bad = 0;
+
+  pool_setdisttype(pool, DISTTYPE_RPM);
+  pool_setarch(pool, "noarch");
+  pool_set_flag(pool, POOL_FLAG_INCREMENTALWHATPROVIDES, 1);
+  unit_addrepo(pool, "repo1", repo1);
+  foo = pool_rel2id(pool, pool_str2id(pool, "foo", 1), pool_str2id(pool, "1", 1), REL_GT | REL_EQ, 1);
+  bar = pool_str2id(pool, "bar", 1);
+  file = pool_str2id(pool, "/opt/b", 1);
+  /* no pool_addfileprovides(), so the file names are looked up lazily */
+  pool_createwhatprovides(pool);
+
+  /* fill the relation and lazy file provides caches */
+  if (nproviders(pool, foo) != 1 || nproviders(pool, bar) != 1 || nproviders(pool, file) != 1)
+    {
+      fprintf(stderr, "bad providers in the initial index\n");
+      bad = 1;
+    }
+
+  /* add solvables */
+  repo = unit_addrepo(pool, "repo2", repo2);
+  pool_createwhatprovides(pool);
+  if (nproviders(pool, foo) != 2 || nproviders(pool, bar) != 2 || nproviders(pool, file) != 2)
+    {
+      fprintf(stderr, "bad providers after adding a repo\n");
+      bad = 1;
+    }
+  bad |= check(pool, "add");
+
+  /* remove solvables */
+  repo_free(repo, 1);
+  pool_createwhatprovides(pool);
+  if (nproviders(pool, foo) != 1 || nproviders(pool, bar) != 1 || nproviders(pool, file) != 1)
+    {
+      fprintf(stderr, "bad providers after freeing a repo\n");
+      bad = 1;
+    }
+  bad |= check(pool, "free");
+
+  /* and add them again, reusing the freed solvable ids */
+  unit_addrepo(pool, "repo2", repo2);
+  pool_createwhatprovides(pool);
+  bad |= check(pool, "readd");
+
+  pool_free(pool);
+  return bad;
+}
@@ -0,0 +1,205 @@
+/*
+ * whatprovidescache.c
+ *
+ * check that the whatprovides index read from the cache is the same
+ * as a freshly created one, and that a cache that does not match the
+ * pool or that is corrupt is rejected
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pool.h"
+#include "repo.h"
+
+#include "common.h"
+
+static const char *repo1 =
+  "=Pkg: a 1 1 noarch\n"
+  "=Prv: foo = 1\n"
+  "=Req: bar\n"
+  "=Req: /usr/bin/b\n"
+  "=Fls: /usr/bin/a\n"
+  "=Pkg: b 1 1 noarch\n"
+  "=Prv: bar\n"
+  "=Fls: /usr/bin/b\n"
+  "=Pkg: c 1 1 noarch\n"
+  "=Prv: foo = 2\n"
+  "=Req: /opt/c/data\n"
+  "=Fls: /opt/c/data\n";
+
+static const char *repo2 =
+  "=Pkg: a 2 1 noarch\n"
+  "=Prv: foo = 3\n"
+  "=Req: foo >= 2\n"
+  "=Fls: /usr/bin/a\n"
+  "=Pkg: d 1 1 noarch\n"
+  "=Prv: bar\n"
+  "=Prv: baz\n"
+  "=Con: foo < 2\n"
+  "=Fls: /usr/bin/b\n";
+
+/* create the pool without the whatprovides index */
+static Pool *
+setup(void)
+{
+  Pool *pool = pool_create();
+  pool_setdisttype(pool, DISTTYPE_RPM);
+  pool_setarch(pool, "noarch");
+  unit_addrepo(pool, "repo1", repo1);
+  unit_addrepo(pool, "repo2", repo2);
+  pool_str2id(pool, "/usr/bin/a", 1);
+  pool_rel2id(pool, pool_str2id(pool, "foo", 1), pool_str2id(pool, "2", 1), REL_GT | REL_EQ, 1);
+  return pool;
+}
+
+static void
+providers(Pool *pool, Id dep, Queue *q)
+{
+  Id p, pp;
+  queue_empty(q);
+  FOR_PROVIDES(p, pp, dep)
+    queue_push(q, p);
+}
+
+/* compare the providers of all strings and relations */
+static int
+compare(Pool *pool, Pool *fresh)
+{
+  Queue q1, q2;
+  Id id;
+  int bad = 0;
+
+  if (pool->ss.nstrings != fresh->ss.nstrings || pool->nrels != fresh->nrels)
+    {
+      fprintf(stderr, "the pools have different ids\n");
+      return 1;
+    }
+  queue_init(&q1);
+  queue_init(&q2);
+  for (id = 1; id < pool->ss.nstrings + pool->nrels; id++)
+    {
+      Id dep = id < pool->ss.nstrings ? id : MAKERELDEP(id - pool->ss.nstrings);
+      if (ISRELDEP(dep) && dep == MAKERELDEP(0))
+	continue;
+      providers(pool, dep, &q1);
+      providers(fresh, dep, &q2);
+      if (q1.count != q2.count || memcmp(q1.elements, q2.elements, q1.count * sizeof(Id)) != 0)
+	{
+	  fprintf(stderr, "%s: %d cached providers, %d fresh providers\n", pool_dep2str(pool, dep), q1.count, q2.count);
+	  bad = 1;
+	}
+    }
+  queue_free(&q1);
+  queue_free(&q2);
+  return bad;
+}
+
+static size_t
+getu32(const char *buf)
+{
+  const unsigned char *b = (const unsigned char *)buf;
+  return (size_t)b[0] << 24 | b[1] << 16 | b[2] << 8 | b[3];
+}
+
+static int
+readcache(Pool *pool, char *buf, size_t len)
+{
+  FILE *fp = fmemopen(buf, len, "r");
+  int r;
+  if (!fp)
+    {
+      perror("fmemopen");
+      exit(1);
+    }
+  r = pool_read_whatprovides(pool, fp);
+  fclose(fp);
+  return r;
+}
+
+int
+main()
+{
+  Pool *pool, *fresh;
+  char *buf = 0;
+  size_t len = 0, off;
+  char save;
+  FILE *fp;
+  unsigned char cookie1[32], cookie2[32];
+  int failed = 0;
+
+  /* the cookie does not change when the file provides are added */
+  fresh = setup();
+  pool_calc_whatprovides_cookie(fresh, cookie1);
+  pool_addfileprovides(fresh);
+  pool_createwhatprovides(fresh);
+  pool_calc_whatprovides_cookie(fresh, cookie2);
+  if (memcmp(cookie1, cookie2, 32) != 0)
+    {
+      fprintf(stderr, "pool_addfileprovides changed the cookie\n");
+      failed = 1;
+    }
+  fp = open_memstream(&buf, &len);
+  if (!fp || pool_write_whatprovides(fresh, fp) || fclose(fp))
+    {
+      fprintf(stderr, "could not write the cache\n");
+      exit(1);
+    }
+
+  /* the cache replaces addfileprovides and createwhatprovides */
+  pool = setup();
+  if (readcache(pool, buf, len))
+    {
+      fprintf(stderr, "cache rejected: %s\n", pool_errstr(pool));
+      failed = 1;
+    }
+  else
+    {
+      if (compare(pool, fresh))
+	failed = 1;
+      if (pool_checkwhatprovides(pool))
+	{
+	  fprintf(stderr, "pool_checkwhatprovides found mismatches\n");
+	  failed = 1;
+	}
+    }
+  pool_free(pool);
+
+  /* a pool with one more solvable does not match */
+  pool = setup();
+  unit_addrepo(pool, "repo3", "=Pkg: e 1 1 noarch\n");
+  if (readcache(pool, buf, len) == 0)
+    {
+      fprintf(stderr, "cache for a different pool accepted\n");
+      failed = 1;
+    }
+  pool_free(pool);
+
+  /* a corrupt provider list is detected by the checksum. The file
+   * starts with magic, version, cookie, addedfileprovides, the nonstd
+   * ids and the added file provides, then come the size and the
+   * provider lists */
+  pool = setup();
+  off = 48 + 4 * getu32(buf + 44);
+  off += 4 + 4 * getu32(buf + off);
+  off += 4 + 4 * 4 + 3;		/* low byte of the first provider */
+  save = buf[off];
+  buf[off] = save == 3 ? 4 : 3;
+  if (readcache(pool, buf, len) == 0)
+    {
+      fprintf(stderr, "corrupt cache accepted\n");
+      failed = 1;
+    }
+  else if (strcmp(pool_errstr(pool), "pool_read_whatprovides: checksum mismatch") != 0)
+    {
+      fprintf(stderr, "corrupt cache: unexpected error '%s'\n", pool_errstr(pool));
+      failed = 1;
+    }
+  buf[off] = save;
+  pool_free(pool);
+
+  free(buf);
+  pool_free(fresh);
+  return failed;
+}
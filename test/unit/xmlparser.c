@@ -0,0 +1,113 @@
+/*
+ * xmlparser.c
+ *
+ * check that malformed xml is rejected with the expat error messages
+ * and positions, no matter which xml parser backend is compiled in
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "repo_rpmmd.h"
+
+static struct {
+  const char *xml;
+  const char *err;
+} badxml[] = {
+  { "<metadata><a x=\"1\" x=\"2\"/></metadata>", "duplicate attribute at line 1:19" },
+  { "<metadata><a><![CDATA[abc", "unclosed CDATA section at line 1:25" },
+  { "<?xml version=\"1.0\" encoding=\"KOI8-R\"?><metadata/>", "unknown encoding at line 1:30" },
+  { "<?xml version=\"1.0\" encoding=\"UTF-16\"?><metadata/>", "encoding specified in XML declaration is incorrect at line 1:30" },
+  { "<metadata><!-- abc", "unclosed token at line 1:10" },
+  { "<metadata>\n<a></b></metadata>", "mismatched tag at line 2:5" },
+  { "<metadata><a>&foo bar;</a></metadata>", "not well-formed (invalid token) at line 1:17" },
+  { "<metadata><a x=\"&undefined;\"/></metadata>", "undefined entity at line 1:10" },
+  { "<metadata><a>&#xD800;</a></metadata>", "reference to invalid character number at line 1:13" },
+  { "<metadata>", "no element found at line 1:10" },
+};
+
+static const char latin1xml[] =
+  "<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?>\n"
+  "<metadata xmlns=\"http://linux.duke.edu/metadata/common\" packages=\"1\">"
+  "<package type=\"rpm\"><name>p\xe4</name><arch>noarch</arch>"
+  "<version epoch=\"0\" ver=\"1\" rel=\"1\"/><summary>s\xfc\xdf</summary></package>"
+  "</metadata>\n";
+
+static int
+add_xml(Pool *pool, const char *xml)
+{
+  Repo *repo = repo_create(pool, "test");
+  FILE *fp = tmpfile();
+  int r;
+
+  if (!fp)
+    {
+      perror("tmpfile");
+      exit(1);
+    }
+  fputs(xml, fp);
+  rewind(fp);
+  r = repo_add_rpmmd(repo, fp, 0, 0);
+  fclose(fp);
+  return r;
+}
+
+int
+main()
+{
+  Pool *pool;
+  Solvable *s;
+  const char *str;
+  char expected[256];
+  int i, failed = 0;
+
+  for (i = 0; i < sizeof(badxml) / sizeof(*badxml); i++)
+    {
+      pool = pool_create();
+      snprintf(expected, sizeof(expected), "repo_rpmmd: %s", badxml[i].err);
+      if (add_xml(pool, badxml[i].xml) == 0)
+	{
+	  fprintf(stderr, "%s: not rejected\n", badxml[i].xml);
+	  failed = 1;
+	}
+      else if (strcmp(pool_errstr(pool), expected) != 0)
+	{
+	  fprintf(stderr, "%s: got '%s', expected '%s'\n", badxml[i].xml, pool_errstr(pool), expected);
+	  failed = 1;
+	}
+      pool_free(pool);
+    }
+
+  /* latin1 input is accepted and converted to utf-8 */
+  pool = pool_create();
+  if (add_xml(pool, latin1xml) != 0)
+    {
+      fprintf(stderr, "latin1: %s\n", pool_errstr(pool));
+      failed = 1;
+    }
+  else if (pool->nsolvables != 3)
+    {
+      fprintf(stderr, "latin1: expected one package\n");
+      failed = 1;
+    }
+  else
+    {
+      s = pool->solvables + 2;
+      if (strcmp(pool_id2str(pool, s->name), "p\xc3\xa4") != 0)
+	{
+	  fprintf(stderr, "latin1: bad name '%s'\n", pool_id2str(pool, s->name));
+	  failed = 1;
+	}
+      str = solvable_lookup_str(s, SOLVABLE_SUMMARY);
+      if (!str || strcmp(str, "s\xc3\xbc\xc3\x9f") != 0)
+	{
+	  fprintf(stderr, "latin1: bad summary '%s'\n", str ? str : "(null)");
+	  failed = 1;
+	}
+    }
+  pool_free(pool);
+  return failed;
+}
@@ -0,0 +1,100 @@
+/*
+ * zstd_pages.c
+ *
+ * check that a solv file written with zstd compressed pages reads
+ * back to the same repository as one written with the default page
+ * compression
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "repo_solv.h"
+#include "repo_write.h"
+
+#include "common.h"
+
+#define NPKGS	2000
+
+static char *
+write_repo(Repo *repo, int flags, size_t *lenp)
+{
+  Repowriter *writer = repowriter_create(repo);
+  char *buf = 0;
+  FILE *fp = open_memstream(&buf, lenp);
+
+  repowriter_set_flags(writer, flags);
+  if (!fp || repowriter_write(writer, fp) || fclose(fp))
+    {
+      fprintf(stderr, "repowriter_write: %s\n", pool_errstr(repo->pool));
+      exit(1);
+    }
+  repowriter_free(writer);
+  return buf;
+}
+
+/* read the solv file with a minimal page cache, so that the pages
+ * get decompressed again and again, and write it with the default
+ * page compression */
+static char *
+roundtrip(const char *solv, size_t len, size_t *lenp)
+{
+  Pool *pool = pool_create();
+  Repo *repo = repo_create(pool, "test");
+  FILE *fp = tmpfile();
+  char *out;
+
+  pool_set_pagecache_size(pool, 1);
+  if (!fp || fwrite(solv, len, 1, fp) != 1)
+    {
+      perror("tmpfile");
+      exit(1);
+    }
+  rewind(fp);
+  if (repo_add_solv(repo, fp, 0))
+    {
+      fprintf(stderr, "repo_add_solv: %s\n", pool_errstr(pool));
+      exit(1);
+    }
+  fclose(fp);
+  out = write_repo(repo, 0, lenp);
+  pool_free(pool);
+  return out;
+}
+
+int
+main()
+{
+  Pool *pool = pool_create();
+  char *plain, *zstd, *out;
+  size_t plainlen, zstdlen, outlen;
+  int failed = 0;
+
+  unit_create_repo(pool, NPKGS);
+  plain = write_repo(pool->repos[1], 0, &plainlen);
+  zstd = write_repo(pool->repos[1], REPOWRITER_ZSTD_PAGES, &zstdlen);
+  pool_free(pool);
+
+  /* the version must make older readers reject the file */
+  if (zstdlen < 8 || zstd[7] != SOLV_VERSION_10 || plain[7] == SOLV_VERSION_10)
+    {
+      fprintf(stderr, "zstd pages are not marked in the header\n");
+      failed = 1;
+    }
+  if (zstdlen >= plainlen)
+    fprintf(stderr, "note: zstd %d bytes, default %d bytes\n", (int)zstdlen, (int)plainlen);
+
+  out = roundtrip(zstd, zstdlen, &outlen);
+  if (outlen != plainlen || memcmp(out, plain, plainlen) != 0)
+    {
+      fprintf(stderr, "the zstd solv file reads back to a different repository\n");
+      failed = 1;
+    }
+  free(out);
+  free(plain);
+  free(zstd);
+  return failed;
+}
@@ -35,6 +35,15 @@ keyfilter_solv(Repo *repo, Repokey *key, void *kfdata)
  */
 void
 tool_write(Repo *repo, FILE *fp)
+{
+  tool_write_flags(repo, fp, 0);
+}
+
+/*
+ * Write <repo> to fp, writerflags are REPOWRITER_ flags
+ */
+void
+tool_write_flags(Repo *repo, FILE *fp, int writerflags)
 {
   Repodata *info;
   Queue addedfileprovides;
@@ -57,6 +66,7 @@ tool_write(Repo *repo, FILE *fp)
   repodata_internalize(info);
   writer = repowriter_create(repo);
   repowriter_set_keyfilter(writer, keyfilter_solv, 0);
+  repowriter_set_flags(writer, writerflags);
   if (repowriter_write(writer, fp) != 0)
     {
       fprintf(stderr, "repo write failed: %s\n", pool_errstr(repo->pool));
@@ -11,5 +11,6 @@
 #include "repo.h"
 
 void tool_write(Repo *repo, FILE *fp);
+void tool_write_flags(Repo *repo, FILE *fp, int writerflags);
 
 #endif
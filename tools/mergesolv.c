@@ -19,6 +19,7 @@
 
 #include "pool.h"
 #include "repo_solv.h"
+#include "repo_write.h"
 #ifdef SUSE
 #include "repo_autopattern.h"
 #endif
@@ -30,6 +31,7 @@ usage()
   fprintf(stderr, "\nUsage:\n"
 	  "mergesolv [file] [file] [...]\n"
 	  "  merges multiple solv files into one and writes it to stdout\n"
+	  "  -Z : compress the data pages with zstd\n"
 	  );
   exit(0);
 }
@@ -61,6 +63,7 @@ main(int argc, char **argv)
   Pool *pool;
   Repo *repo;
   int with_attr = 0;
+  int writerflags = 0;
 #ifdef SUSE
   int add_auto = 0;
 #endif
@@ -69,7 +72,7 @@ main(int argc, char **argv)
   pool = pool_create();
   repo = repo_create(pool, "<mergesolv>");
   
-  while ((c = getopt(argc, argv, "ahX")) >= 0)
+  while ((c = getopt(argc, argv, "ahXZ")) >= 0)
     {
       switch (c)
       {
@@ -82,6 +85,14 @@ main(int argc, char **argv)
 	case 'X':
 #ifdef SUSE
 	  add_auto = 1;
+#endif
+	  break;
+	case 'Z':
+#ifdef ENABLE_ZSTD_PAGES
+	  writerflags |= REPOWRITER_ZSTD_PAGES;
+#else
+	  fprintf(stderr, "zstd compressed pages are not supported\n");
+	  exit(1);
 #endif
 	  break;
 	default:
@@ -111,7 +122,7 @@ main(int argc, char **argv)
   if (add_auto)
     repo_add_autopattern(repo, 0);
 #endif
-  tool_write(repo, stdout);
+  tool_write_flags(repo, stdout, writerflags);
   pool_free(pool);
   return 0;
 }
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026, SUSE LLC
+ *
+ * This program is licensed under the BSD license, read LICENSE.BSD
+ * for further information
+ */
+
+/*
+ * orderbench
+ *
+ * benchmark for the transaction ordering: solves a testcase and
+ * orders the resulting transaction with both cycle breakers
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "solver.h"
+#include "transaction.h"
+#include "testcase.h"
+#include "util.h"
+
+static void
+usage(int status)
+{
+  fprintf(stderr, "\nUsage:\n"
+    "orderbench [-v] [-r <rounds>] <testcase>\n"
+    "  solve the testcase and order the resulting transaction with\n"
+    "  the scc based and the old cycle breaker, printing the needed time\n"
+    "  -r <rounds> : repeat the benchmark <rounds> times (default 10)\n"
+    "  -v : print the ordering statistics\n"
+   );
+  exit(status);
+}
+
+/* count the requires that are not yet satisfied when a package
+ * gets installed */
+static int
+unsatisfied(Pool *pool, Queue *order)
+{
+  Id *pos = solv_calloc(pool->nsolvables, sizeof(Id));
+  Queue q;
+  Id p, pp, req;
+  int i, j, cnt = 0;
+
+  for (i = 0; i < order->count; i++)
+    pos[order->elements[i]] = i + 1;
+  queue_init(&q);
+  for (i = 0; i < order->count; i++)
+    {
+      Solvable *s = pool->solvables + order->elements[i];
+      if (s->repo == pool->installed)
+	continue;
+      queue_empty(&q);
+      solvable_lookup_deparray(s, SOLVABLE_REQUIRES, &q, 0);
+      for (j = 0; j < q.count; j++)
+	{
+	  req = q.elements[j];
+	  if (req == SOLVABLE_PREREQMARKER)
+	    continue;
+	  FOR_PROVIDES(p, pp, req)
+	    if (!pos[p] || pos[p] <= i + 1)
+	      break;
+	  if (p)
+	    continue;
+	  FOR_PROVIDES(p, pp, req)
+	    break;
+	  if (p)
+	    cnt++;	/* all providers are installed later */
+	}
+    }
+  queue_free(&q);
+  solv_free(pos);
+  return cnt;
+}
+
+static void
+bench(Transaction *trans, int flags, int rounds, const char *name, Queue *order)
+{
+  Transaction *t;
+  unsigned int ordertime = 0, edgetime = 0, cycletime = 0;
+  int round, cycles = 0, edges = 0;
+
+  for (round = 0; round < rounds; round++)
+    {
+      t = transaction_create_clone(trans);
+      transaction_order(t, flags);
+      ordertime += transaction_get_stat(t, TRANSACTION_STAT_ORDER_TIME);
+      edgetime += transaction_get_stat(t, TRANSACTION_STAT_EDGE_TIME);
+      cycletime += transaction_get_stat(t, TRANSACTION_STAT_CYCLE_TIME);
+      cycles = transaction_get_stat(t, TRANSACTION_STAT_CYCLES);
+      edges = transaction_get_stat(t, TRANSACTION_STAT_EDGES);
+      if (!round)
+	queue_init_clone(order, &t->steps);
+      transaction_free(t);
+    }
+  printf("%-6s: %d edges, %d cycles broken, %d unsatisfied requires, order: %u ms, edge creation: %u ms, cycle breaking: %u ms\n", name, edges, cycles, unsatisfied(trans->pool, order), ordertime / rounds, edgetime / rounds, cycletime / rounds);
+}
+
+int
+main(int argc, char **argv)
+{
+  Pool *pool;
+  Solver *solv;
+  Transaction *trans;
+  Queue job, order1, order2;
+  FILE *fp;
+  int c, i, rounds = 10, same, debuglevel = 0;
+
+  while ((c = getopt(argc, argv, "hr:v")) >= 0)
+    {
+      switch (c)
+	{
+	case 'h':
+	  usage(0);
+	  break;
+	case 'r':
+	  rounds = atoi(optarg);
+	  break;
+	case 'v':
+	  debuglevel++;
+	  break;
+	default:
+	  usage(1);
+	  break;
+	}
+    }
+  if (optind + 1 != argc || rounds <= 0)
+    usage(1);
+  if ((fp = fopen(argv[optind], "r")) == 0)
+    {
+      perror(argv[optind]);
+      exit(1);
+    }
+  pool = pool_create();
+  queue_init(&job);
+  solv = testcase_read(pool, fp, argv[optind], &job, 0, 0);
+  fclose(fp);
+  if (!solv)
+    {
+      fprintf(stderr, "%s: %s\n", argv[optind], pool_errstr(pool));
+      exit(1);
+    }
+  if (solver_solve(solv, &job))
+    fprintf(stderr, "warning: the testcase has problems\n");
+  trans = solver_create_transaction(solv);
+  if (debuglevel)
+    pool_setdebuglevel(pool, debuglevel);
+  printf("%d transaction steps, %d rounds\n", trans->steps.count, rounds);
+  bench(trans, SOLVER_TRANSACTION_ORDER_SCC, rounds, "scc", &order1);
+  bench(trans, 0, rounds, "old", &order2);
+  same = order1.count == order2.count;
+  for (i = 0; same && i < order1.count; i++)
+    if (order1.elements[i] != order2.elements[i])
+      same = 0;
+  printf("orders are %s\n", same ? "identical" : "different");
+  queue_free(&order1);
+  queue_free(&order2);
+  transaction_free(trans);
+  solver_free(solv);
+  queue_free(&job);
+  pool_free(pool);
+  return 0;
+}
@@ -40,6 +40,7 @@
 #ifdef ENABLE_APPDATA
 #include "repo_appdata.h"
 #endif
+#include "repo_write.h"
 #include "common_write.h"
 #include "solv_xfopen.h"
 
@@ -256,7 +257,7 @@ susetags_open(const char *dir, const char *filename, char **tmpp, int missingok)
       return 0;
     }
   *tmpp = solv_dupjoin(dir, "/", filename);
-  if ((fp = solv_xfopen(*tmpp, "r")) == 0)
+  if ((fp = solv_xfopen(*tmpp, "rR")) == 0)
     {
       if (!missingok)
 	{
@@ -546,7 +547,7 @@ repomd_open(const char *dir, const char *filename, char **tmpp, int missingok)
       return 0;
     }
   *tmpp = solv_dupjoin(dir, "/", filename);
-  if ((fp = solv_xfopen(*tmpp, "r")) == 0)
+  if ((fp = solv_xfopen(*tmpp, "rR")) == 0)
     {
       if (!missingok)
 	{
@@ -747,7 +748,7 @@ static void
 usage(int status)
 {
   fprintf(stderr, "\nUsage:\n"
-          "repo2solv [-R] [-X] [-A] [-o <out.solv>] <dir>\n"
+          "repo2solv [-R] [-X] [-A] [-Z] [-o <out.solv>] <dir>\n"
 	  "  Convert a repository in <dir> to a solv file\n"
 	  "  -h : print help & exit\n"
 	  "  -o <out.solv>: write to this file instead of stdout\n"
@@ -755,6 +756,7 @@ usage(int status)
 	  "  -R : also search subdirectories for rpms\n"
 	  "  -X : generate pattern/product pseudo packages\n"
 	  "  -A : add appdata packages\n"
+	  "  -Z : compress the data pages with zstd\n"
 	 );
    exit(status);
 }
@@ -764,6 +766,7 @@ main(int argc, char **argv)
 {
   int c, res;
   int repotype = 0;
+  int writerflags = 0;
   char *outfile = 0;
   char *dir;
   struct stat stb;
@@ -771,7 +774,7 @@ main(int argc, char **argv)
   Pool *pool = pool_create();
   Repo *repo = repo_create(pool, "<repo>");
 
-  while ((c = getopt(argc, argv, "hAXRFCo:")) >= 0)
+  while ((c = getopt(argc, argv, "hAXRFCZo:")) >= 0)
     {
       switch(c)
 	{
@@ -798,6 +801,14 @@ main(int argc, char **argv)
 	case 'C':
 	  add_changelog = 1;
 	  break;
+	case 'Z':
+#ifdef ENABLE_ZSTD_PAGES
+	  writerflags |= REPOWRITER_ZSTD_PAGES;
+#else
+	  fprintf(stderr, "zstd compressed pages are not supported\n");
+	  exit(1);
+#endif
+	  break;
 	case 'o':
 	  outfile = optarg;
 	  break;
@@ -852,7 +863,7 @@ main(int argc, char **argv)
     repo_add_autopattern(repo, 0);
   repo_mark_retracted_packages(repo, pool_str2id(pool, "retracted-patch-package()", 1));
 #endif
-  tool_write(repo, stdout);
+  tool_write_flags(repo, stdout, writerflags);
   pool_free(pool);
   solv_free(dir);
   exit(res);
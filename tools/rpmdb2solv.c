@@ -46,13 +46,14 @@ static void
 usage(int status)
 {
   fprintf(stderr, "\nUsage:\n"
-	  "rpmdb2solv [-P] [-C] [-n] [-b <basefile>] [-p <productsdir>] [-r <root>]\n"
+	  "rpmdb2solv [-P] [-C] [-F] [-n] [-b <basefile>] [-p <productsdir>] [-r <root>]\n"
 	  " -n : No packages, do not read rpmdb, useful to only parse products\n"
 	  " -p <productsdir> : Scan <productsdir> for .prod files, representing installed products\n"
 	  " -r <root> : Prefix rpmdb path and <productsdir> with <root>\n"
 	  " -o <solv> : Write .solv to file instead of stdout\n"
           " -P : print percentage done\n"
           " -C : include the changelog\n"
+          " -F : include file conflict information\n"
 	 );
   exit(status);
 }
@@ -68,6 +69,7 @@ main(int argc, char **argv)
   int c, percent = 0;
   int nopacks = 0;
   int add_changelog = 0;
+  int add_fileconflictinfo = 0;
   const char *root = 0;
   const char *dbpath = 0;
   const char *refname = 0;
@@ -89,7 +91,7 @@ main(int argc, char **argv)
    * parse arguments
    */
   
-  while ((c = getopt(argc, argv, "ACD:PhnkxXr:p:o:")) >= 0)
+  while ((c = getopt(argc, argv, "ACD:FPhnkxXr:p:o:")) >= 0)
     switch (c)
       {
       case 'h':
@@ -136,6 +138,9 @@ main(int argc, char **argv)
       case 'C':
 	add_changelog = 1;
 	break;
+      case 'F':
+	add_fileconflictinfo = 1;
+	break;
       default:
 	usage(1);
       }
@@ -195,6 +200,8 @@ main(int argc, char **argv)
 	flags |= RPMDB_REPORT_PROGRESS;
       if (add_changelog)
 	flags |= RPM_ADD_WITH_CHANGELOG;
+      if (add_fileconflictinfo)
+	flags |= RPM_ADD_WITH_FILECONFLICTINFO;
       if (repo_add_rpmdb_reffp(repo, reffp, flags))
 	{
 	  fprintf(stderr, "rpmdb2solv: %s\n", pool_errstr(pool));
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026, SUSE LLC
+ *
+ * This program is licensed under the BSD license, read LICENSE.BSD
+ * for further information
+ */
+
+/*
+ * solvebench
+ *
+ * benchmark for the sat solver: generates a repository with two
+ * versions of interdependent packages and an installed system with
+ * older versions of them, then does a distupgrade of all packages
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+
+#include "pool.h"
+#include "poolarch.h"
+#include "repo.h"
+#include "solver.h"
+#include "util.h"
+
+static void
+usage(int status)
+{
+  fprintf(stderr, "\nUsage:\n"
+    "solvebench [-v] [-n <names>] [-r <rounds>]\n"
+    "  generate two versions of <names> packages with requires and\n"
+    "  conflicts between them, install an older version of each and\n"
+    "  distupgrade all of them, printing the needed time and the solver\n"
+    "  statistics\n"
+    "  -n <names> : number of package names (default 10000)\n"
+    "  -r <rounds> : repeat the benchmark <rounds> times (default 3)\n"
+    "  -v : print the solver statistics of every round\n"
+   );
+  exit(status);
+}
+
+static unsigned int
+rnd(unsigned int *seed)
+{
+  *seed = *seed * 1103515245 + 12345;
+  return (*seed >> 16) & 0x7fff;
+}
+
+/* every package requires a few other names, the first one with
+ * at least its own version, and a quarter of them conflicts with the
+ * newest version of some other name. The seed depends on the version,
+ * so that every version has its own dependencies. */
+static void
+addpackages(Pool *pool, Repo *repo, int names, const char *evr)
+{
+  Id evrid = pool_str2id(pool, evr, 1);
+  Id newevr = pool_str2id(pool, "3-1", 1);
+  unsigned int seed = 42 + evr[0];
+  char buf[32];
+  Id p, dep;
+  int i, j, n;
+
+  for (i = 0; i < names; i++)
+    {
+      Solvable *s;
+      p = repo_add_solvable(repo);
+      s = pool->solvables + p;
+      sprintf(buf, "pkg%d", i);
+      s->name = pool_str2id(pool, buf, 1);
+      s->evr = evrid;
+      s->arch = ARCH_NOARCH;
+      s->provides = repo_addid_dep(repo, s->provides, pool_rel2id(pool, s->name, s->evr, REL_EQ, 1), 0);
+      n = 1 + rnd(&seed) % 6;
+      for (j = 0; j < n; j++)
+	{
+	  sprintf(buf, "pkg%d", (int)(rnd(&seed) * 32768 + rnd(&seed)) % names);
+	  dep = pool_str2id(pool, buf, 1);
+	  if (j == 0)
+	    dep = pool_rel2id(pool, dep, evrid, REL_GT | REL_EQ, 1);
+	  s->requires = repo_addid_dep(repo, s->requires, dep, 0);
+	}
+      if (rnd(&seed) % 4 == 0)
+	{
+	  sprintf(buf, "pkg%d", (int)(rnd(&seed) * 32768 + rnd(&seed)) % names);
+	  dep = pool_rel2id(pool, pool_str2id(pool, buf, 1), newevr, REL_EQ, 1);
+	  s->conflicts = repo_addid_dep(repo, s->conflicts, dep, 0);
+	}
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  Pool *pool;
+  Repo *installed, *repo;
+  Solver *solv;
+  Queue job;
+  int c, round, names = 10000, rounds = 3, verbose = 0, problems = 0;
+  unsigned int solvetime = 0, sattime = 0;
+
+  while ((c = getopt(argc, argv, "hn:r:v")) >= 0)
+    {
+      switch (c)
+	{
+	case 'h':
+	  usage(0);
+	  break;
+	case 'n':
+	  names = atoi(optarg);
+	  break;
+	case 'r':
+	  rounds = atoi(optarg);
+	  break;
+	case 'v':
+	  verbose = 1;
+	  break;
+	default:
+	  usage(1);
+	  break;
+	}
+    }
+  if (optind != argc || names <= 0 || rounds <= 0)
+    usage(1);
+  pool = pool_create();
+  pool_setarch(pool, "noarch");
+  installed = repo_create(pool, "@System");
+  addpackages(pool, installed, names, "1-1");
+  repo_internalize(installed);
+  pool_set_installed(pool, installed);
+  repo = repo_create(pool, "available");
+  addpackages(pool, repo, names, "2-1");
+  addpackages(pool, repo, names, "3-1");
+  repo_internalize(repo);
+  pool_addfileprovides(pool);
+  pool_createwhatprovides(pool);
+
+  queue_init(&job);
+  queue_push2(&job, SOLVER_DISTUPGRADE | SOLVER_SOLVABLE_ALL, 0);
+  printf("%d names, %d rounds\n", names, rounds);
+  for (round = 0; round < rounds; round++)
+    {
+      solv = solver_create(pool);
+      problems = solver_solve(solv, &job);
+      solvetime += solver_get_stat(solv, SOLVER_STAT_SOLVE_TIME);
+      sattime += solver_get_stat(solv, SOLVER_STAT_SAT_TIME);
+      if (verbose || round == rounds - 1)
+	printf("round %d: %d rules, %d decisions, %d propagations, %d conflicts, %d learnt rules, %d restarts, %d problems\n", round,
+	  solver_get_stat(solv, SOLVER_STAT_RULES),
+	  solver_get_stat(solv, SOLVER_STAT_DECISIONS),
+	  solver_get_stat(solv, SOLVER_STAT_PROPAGATIONS),
+	  solver_get_stat(solv, SOLVER_STAT_CONFLICTS),
+	  solver_get_stat(solv, SOLVER_STAT_LEARNT_RULES),
+	  solver_get_stat(solv, SOLVER_STAT_RESTARTS), problems);
+      solver_free(solv);
+    }
+  printf("solve: %u ms, sat: %u ms\n", solvetime / rounds, sattime / rounds);
+  queue_free(&job);
+  pool_free(pool);
+  return 0;
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2026, SUSE LLC
+ *
+ * This program is licensed under the BSD license, read LICENSE.BSD
+ * for further information
+ */
+
+/*
+ * strpoolbench
+ *
+ * micro benchmark for the string pool: reads strings (one per line)
+ * and interns/looks them up in a fresh string pool
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+
+#include "pool.h"
+#include "strpool.h"
+#include "util.h"
+
+static void
+usage(int status)
+{
+  fprintf(stderr, "\nUsage:\n"
+    "strpoolbench [-r <rounds>] [file]\n"
+    "  intern the lines of the file (or stdin) into a string pool\n"
+    "  and look them up again, printing the needed time\n"
+    "  -r <rounds> : repeat the benchmark <rounds> times (default 10)\n"
+   );
+  exit(status);
+}
+
+int
+main(int argc, char **argv)
+{
+  FILE *fp = stdin;
+  char *buf = 0, *p, *e;
+  size_t bufl = 0, l;
+  int c, rounds = 10, nlines = 0, round;
+  unsigned int *lens = 0;
+  char **lines = 0;
+  Stringpool ss;
+  unsigned int now, tcreate = 0, tlookup = 0;
+  Id id, maxid = 0;
+  int i;
+
+  while ((c = getopt(argc, argv, "hr:")) >= 0)
+    {
+      switch (c)
+	{
+	case 'h':
+	  usage(0);
+	  break;
+	case 'r':
+	  rounds = atoi(optarg);
+	  break;
+	default:
+	  usage(1);
+	  break;
+	}
+    }
+  if (optind < argc && (fp = fopen(argv[optind], "r")) == 0)
+    {
+      perror(argv[optind]);
+      exit(1);
+    }
+  /* slurp in the file */
+  for (;;)
+    {
+      buf = solv_extend(buf, bufl, 65536, 1, 65535);
+      l = fread(buf + bufl, 1, 65536, fp);
+      bufl += l;
+      if (l < 65536)
+	break;
+    }
+  if (fp != stdin)
+    fclose(fp);
+  for (p = buf; p < buf + bufl; p = e + 1)
+    {
+      for (e = p; e < buf + bufl && *e != '\n'; e++)
+	;
+      lines = solv_extend(lines, nlines, 1, sizeof(char *), 4095);
+      lens = solv_extend(lens, nlines, 1, sizeof(unsigned int), 4095);
+      lines[nlines] = p;
+      lens[nlines++] = e - p;
+    }
+
+  for (round = 0; round < rounds; round++)
+    {
+      stringpool_init_empty(&ss);
+      now = solv_timems(0);
+      for (i = 0; i < nlines; i++)
+	stringpool_strn2id(&ss, lines[i], lens[i], 1);
+      tcreate += solv_timems(now);
+      now = solv_timems(0);
+      for (i = 0; i < nlines; i++)
+	if ((id = stringpool_strn2id(&ss, lines[i], lens[i], 0)) > maxid)
+	  maxid = id;
+      tlookup += solv_timems(now);
+      stringpool_free(&ss);
+    }
+  printf("%d lines, %d strings, %d rounds\n", nlines, maxid + 1, rounds);
+  printf("create: %u ms, lookup: %u ms\n", tcreate, tlookup);
+  solv_free(lines);
+  solv_free(lens);
+  solv_free(buf);
+  return 0;
+}
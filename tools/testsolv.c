@@ -29,6 +29,8 @@ static struct resultflags2str {
   { TESTCASE_RESULT_ORDER,              "order" },
   { TESTCASE_RESULT_ORDEREDGES,         "orderedges" },
   { TESTCASE_RESULT_PROOF,              "proof" },
+  { TESTCASE_RESULT_STATS,              "stats" },
+  { TESTCASE_RESULT_ORDER_SCC,          "orderscc" },
   { 0, 0 }
 };
 
@@ -478,7 +480,9 @@ main(int argc, char **argv)
 		  if (taken)
 		    pcnt = solver_solve(solv, &job);
 		}
-	      if (pcnt)
+	      if (pcnt < 0)
+		printf("Solving aborted\n");
+	      else if (pcnt)
 		{
 		  int problem, solution, scnt;
 		  printf("Found %d problems:\n", pcnt);